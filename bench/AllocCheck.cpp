@@ -0,0 +1,242 @@
+#include "AllocCheck.hpp"
+
+#include <array>
+#include <cstdio>
+#include <vector>
+
+#include "editor/Editor.hpp"
+#include "editor/FPS_Counter.hpp"
+#include "jobs/MainThreadScheduler.hpp"
+#include "memory/AllocTracker.hpp"
+#include "memory/FrameArena.hpp"
+#include "profiling/Profiler.hpp"
+#include "resources/ResourceManager.hpp"
+#include "sdl/SDL_Handler.hpp"
+#include "timing/FrameScheduler.hpp"
+
+namespace Bench {
+
+namespace {
+  enum class Scenario { Idle, Scroll };
+
+  struct FrameResult {
+    double ms = 0.0;
+    Memory::AllocCounters allocs;
+  };
+
+  std::array<bool, SDL_SCANCODE_COUNT> s_keys {};
+  Timing::FixedStepper s_stepper;
+
+  FrameResult RunFrame(SDL_Handler& sdl, Editor& editor, FPS_Counter& fpsCounter, Scenario scenario, int frame) {
+    SDL_State& state = sdl.getState();
+
+    // Scroll: D og A skiftevis hvert sekund, så kameraet kører frem og tilbage
+    s_keys.fill(false);
+    if (scenario == Scenario::Scroll) s_keys[(frame / 60) % 2 == 0 ? SDL_SCANCODE_D : SDL_SCANCODE_A] = true;
+    state.keyState = s_keys.data();
+    state.deltaTime = 1.0f / 60.0f;
+
+    // Musen over banen, så hover-rect og preview tile også tegnes
+    state.mouseX = state.windowWidth * 0.5f;
+    state.mouseY = state.windowHeight - 200.0f;
+    state.mouseButtons = 0;
+
+    Profiling::Profiler::beginFrame();
+    Render::BeginFrame();
+    Memory::FrameArena::reset();
+    const Uint64 start = SDL_GetPerformanceCounter();
+
+    s_stepper.advance(state.deltaTime, [&](float dt) { editor.fixedUpdate(state, dt); });
+    state.stepAlpha = s_stepper.alpha();
+
+    sdl.clear();
+    editor.run(state);
+    Jobs::MainThreadScheduler::run();
+    fpsCounter.update(state);
+    sdl.present();
+
+    const Uint64 end = SDL_GetPerformanceCounter();
+    Profiling::Profiler::endFrame();
+    return { Profiling::Profiler::ticksToMs(end - start), Memory::AllocTracker::lastFrame() };
+  }
+
+  void LoadScene(Editor& editor, const SceneRef& scene) {
+    if (scene.level >= 0) editor.loadLevel(static_cast<unsigned int>(scene.level));
+    else editor.loadScene(scene.name, scene.root);
+  }
+
+  const char* ScenarioName(Scenario s) {
+    return s == Scenario::Idle ? "idle" : "scroll";
+  }
+
+  constexpr int DIALOG_FRAMES = 10;          // frames hver dialog står åben
+  constexpr int SETTLE_MAX_FRAMES = 5000;    // loft over ventetid på thumbnails og popup
+
+  void SendKey(SDL_Handler& sdl, Editor& editor, SDL_Keycode key, SDL_Keymod mod = SDL_KMOD_NONE) {
+    SDL_Event event {};
+    event.type = SDL_EVENT_KEY_DOWN;
+    event.key.key = key;
+    event.key.mod = mod;
+    editor.handleInput(event, sdl.getState());
+  }
+
+  void SendText(SDL_Handler& sdl, Editor& editor, const char* text) {
+    SDL_Event event {};
+    event.type = SDL_EVENT_TEXT_INPUT;
+    event.text.text = text;
+    editor.handleInput(event, sdl.getState());
+  }
+
+  std::size_t CountTextures(const Editor& editor) {
+    return ResourceManager::textureCount() + editor.getUI().thumbnailCount();
+  }
+
+  /*
+   * Én runde gennem dialogerne som brugeren ville tage den - alle lukkes med ESC, så intet
+   * gemmes eller oprettes. Der ventes på thumbnails og popup, så runden slutter i samme tilstand
+   */
+  void CycleDialogs(SDL_Handler& sdl, Editor& editor, FPS_Counter& fpsCounter,
+                    const SceneRef& scene) {
+    int frame = 0;
+    auto frames = [&](int count) {
+      for (int i = 0; i < count; ++i) RunFrame(sdl, editor, fpsCounter, Scenario::Idle, frame++);
+    };
+    auto settle = [&](auto&& busy) {
+      for (int i = 0; i < SETTLE_MAX_FRAMES && busy(); ++i) frames(1);
+    };
+
+    // Save dialog: Ctrl+S, et navn, ESC
+    SendKey(sdl, editor, SDLK_S, SDL_KMOD_CTRL);
+    SendText(sdl, editor, "d");
+    frames(DIALOG_FRAMES);
+    SendKey(sdl, editor, SDLK_ESCAPE);
+
+    // Load menuen (ESC uden åben dialog) - dens thumbnails skal være færdige før den lukkes
+    SendKey(sdl, editor, SDLK_ESCAPE);
+    frames(DIALOG_FRAMES);
+    settle([&] { return editor.getUI().thumbnailsLoading() || Jobs::MainThreadScheduler::hasWork(); });
+
+    // New scene dialogen fra load menuen, derefter ud af begge
+    SendKey(sdl, editor, SDLK_N);
+    SendText(sdl, editor, "d");
+    frames(DIALOG_FRAMES);
+    SendKey(sdl, editor, SDLK_ESCAPE);
+    SendKey(sdl, editor, SDLK_ESCAPE);
+
+    // Popuppen: en genindlæsning viser den - kør til den er væk igen
+    LoadScene(editor, scene);
+    settle([&] { return editor.getUI().popupRemainingMs() >= 0; });
+    frames(DIALOG_FRAMES);
+  }
+}
+
+bool RunAllocCheck(SDL_Handler& sdl, const SceneRef& scene, const AllocCheckOptions& options, Report& report) {
+  if (!Memory::AllocTracker::enabled()) {
+    std::fputs("alloc-check: bygget uden PIRATE_TRACK_ALLOCATIONS\n", stderr);
+    return false;
+  }
+
+  const std::string id = scene.id();
+  Memory::FrameArena::init();
+  Editor editor;
+  FPS_Counter fpsCounter;
+  LoadScene(editor, scene);
+
+  bool ok = true;
+  for (Scenario scenario : { Scenario::Idle, Scenario::Scroll }) {
+    // Opvarmning: texture cache, vertex buffere, glyph batches og første sky vokser til fuld størrelse
+    for (int i = 0; i < options.frames; ++i) RunFrame(sdl, editor, fpsCounter, scenario, i);
+
+    std::vector<double> frameMs;
+    frameMs.reserve(options.frames);
+    int allocatingFrames = 0;
+    for (int i = 0; i < options.frames; ++i) {
+      const FrameResult r = RunFrame(sdl, editor, fpsCounter, scenario, i);
+      frameMs.push_back(r.ms);
+      if (r.allocs.allocs == 0) continue;
+
+      if (allocatingFrames++ < 5 || options.verbose) {
+        std::fprintf(stderr, "alloc-check: %s/%s frame %d: %llu allokeringer (%llu bytes)\n",
+                     ScenarioName(scenario), id.c_str(), i,
+                     static_cast<unsigned long long>(r.allocs.allocs), static_cast<unsigned long long>(r.allocs.bytes));
+      }
+    }
+
+    if (allocatingFrames > 0) {
+      ok = false;
+      std::fprintf(stderr, "alloc-check: %s/%s: %d af %d frames allokerede\n",
+                   ScenarioName(scenario), id.c_str(), allocatingFrames, options.frames);
+
+      // Scopes der har allokeret i de seneste frames - peger på synderen
+      const auto& profile = Profiling::Profiler::report();
+      for (int i = 0; i < profile.scopeCount; ++i) {
+        const auto& s = profile.scopes[i];
+        if (s.allocs > 0.0) std::fprintf(stderr, "  %*s%s: %.1f allokeringer/frame\n", s.depth * 2, "", s.name, s.allocs);
+      }
+    }
+
+    report.add(std::string("editor_") + ScenarioName(scenario) + "/" + id, std::move(frameMs));
+  }
+  return ok;
+}
+
+bool RunDialogCheck(SDL_Handler& sdl, const SceneRef& scene, const DialogCheckOptions& options, Report& report) {
+  if (!Memory::AllocTracker::enabled()) {
+    std::fputs("dialog-check: bygget uden PIRATE_TRACK_ALLOCATIONS\n", stderr);
+    return false;
+  }
+
+  const std::string id = scene.id();
+  Memory::FrameArena::init();
+  Editor editor;
+  FPS_Counter fpsCounter;
+  LoadScene(editor, scene);
+
+  // Opvarmning: første runder fylder glyph caches, thumbnail maps og strenge op
+  for (int i = 0; i < 2; ++i) CycleDialogs(sdl, editor, fpsCounter, scene);
+
+  // TTF_Text, surfaces og anden SDL/SDL_ttf hukommelse går uden om operator new, så SDL tælles for sig
+  const std::int64_t liveBefore = Memory::AllocTracker::live();
+  const int sdlBefore = SDL_GetNumAllocations();
+  const std::size_t texturesBefore = CountTextures(editor);
+  if (sdlBefore < 0) std::fputs("dialog-check: SDL tæller ikke allokeringer, SDL_malloc tjekkes ikke\n", stderr);
+
+  std::vector<double> cycleMs;
+  cycleMs.reserve(options.cycles);
+  for (int i = 0; i < options.cycles; ++i) {
+    const Uint64 start = SDL_GetPerformanceCounter();
+    CycleDialogs(sdl, editor, fpsCounter, scene);
+    cycleMs.push_back(Profiling::Profiler::ticksToMs(SDL_GetPerformanceCounter() - start));
+
+    if (options.verbose) {
+      std::fprintf(stderr, "dialog-check: %s runde %d: %lld levende allokeringer, %d SDL allokeringer, %zu textures\n",
+                   id.c_str(), i, static_cast<long long>(Memory::AllocTracker::live()), SDL_GetNumAllocations(),
+                   CountTextures(editor));
+    }
+  }
+
+  const std::int64_t liveGrowth = Memory::AllocTracker::live() - liveBefore;
+  const int sdlGrowth = sdlBefore >= 0 ? SDL_GetNumAllocations() - sdlBefore : 0;
+  const std::size_t texturesAfter = CountTextures(editor);
+  report.add("dialogs/" + id, std::move(cycleMs));
+
+  bool ok = true;
+  if (liveGrowth > 0) {
+    ok = false;
+    std::fprintf(stderr, "dialog-check: %s: %lld levende allokeringer mere efter %d runder\n",
+                 id.c_str(), static_cast<long long>(liveGrowth), options.cycles);
+  }
+  if (sdlGrowth > 0) {
+    ok = false;
+    std::fprintf(stderr, "dialog-check: %s: %d SDL allokeringer mere efter %d runder\n",
+                 id.c_str(), sdlGrowth, options.cycles);
+  }
+  if (texturesAfter > texturesBefore) {
+    ok = false;
+    std::fprintf(stderr, "dialog-check: %s: textures voksede fra %zu til %zu efter %d runder\n",
+                 id.c_str(), texturesBefore, texturesAfter, options.cycles);
+  }
+  return ok;
+}
+
+}
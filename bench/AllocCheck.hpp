@@ -0,0 +1,34 @@
+#pragma once
+
+#include "BenchReport.hpp"
+#include "SceneRef.hpp"
+
+class SDL_Handler;
+
+/*
+ * Kører hele editoren (Editor + FPS_Counter) headless på en scene og kræver at
+ * steady-state frames ikke allokerer: en idle frame med musen over banen og en
+ * frame hvor kameraet scroller. Frame tiderne kommer med i rapporten.
+ *
+ * RunDialogCheck åbner og lukker save, load og new-scene dialogerne og popuppen igen og
+ * igen gennem editorens input, og kræver at levende allokeringer og textures ikke vokser.
+ */
+namespace Bench {
+
+struct AllocCheckOptions {
+  int frames = 120;  // målte frames per scenarie (efter lige så mange til opvarmning)
+  bool verbose = false;
+};
+
+/* Returnerer false hvis en målt frame allokerede */
+bool RunAllocCheck(SDL_Handler& sdl, const SceneRef& scene, const AllocCheckOptions& options, Report& report);
+
+struct DialogCheckOptions {
+  int cycles = 10;  // målte runder gennem alle dialoger (efter to til opvarmning)
+  bool verbose = false;
+};
+
+/* Returnerer false hvis levende allokeringer eller textures voksede over de målte runder */
+bool RunDialogCheck(SDL_Handler& sdl, const SceneRef& scene, const DialogCheckOptions& options, Report& report);
+
+}
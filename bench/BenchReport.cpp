@@ -0,0 +1,103 @@
+#include "BenchReport.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <numeric>
+#include <unordered_map>
+
+namespace Bench {
+
+namespace {
+  double percentile(const std::vector<double>& sorted, double p) {
+    if (sorted.empty()) return 0.0;
+    const size_t idx = std::min(sorted.size() - 1, static_cast<size_t>(p * (sorted.size() - 1) + 0.5));
+    return sorted[idx];
+  }
+
+  /* Finder "key": og returnerer teksten efter kolon (uden mellemrum) */
+  const char* findField(const std::string& line, const char* key) {
+    const std::string needle = std::string("\"") + key + "\":";
+    const size_t pos = line.find(needle);
+    if (pos == std::string::npos) return nullptr;
+    const char* p = line.c_str() + pos + needle.size();
+    while (*p == ' ') ++p;
+    return p;
+  }
+}
+
+void Report::add(const std::string& name, std::vector<double> samplesMs) {
+  Result r;
+  r.name = name;
+  r.samples = static_cast<int>(samplesMs.size());
+  if (!samplesMs.empty()) {
+    std::sort(samplesMs.begin(), samplesMs.end());
+    r.minMs    = samplesMs.front();
+    r.medianMs = percentile(samplesMs, 0.5);
+    r.p95Ms    = percentile(samplesMs, 0.95);
+    r.meanMs   = std::accumulate(samplesMs.begin(), samplesMs.end(), 0.0) / samplesMs.size();
+  }
+  entries.push_back(std::move(r));
+}
+
+bool Report::write(const std::string& path) const {
+  std::FILE* f = path == "-" ? stdout : std::fopen(path.c_str(), "wb");
+  if (!f) {
+    std::fprintf(stderr, "Kunne ikke skrive til %s\n", path.c_str());
+    return false;
+  }
+
+  std::fputs("{\n  \"benchmark\": \"PirateEditorBench\",\n  \"renderer\": \"software\",\n  \"results\": [\n", f);
+  for (size_t i = 0; i < entries.size(); ++i) {
+    const Result& r = entries[i];
+    std::fprintf(f, "    {\"name\": \"%s\", \"samples\": %d, \"min_ms\": %.4f, \"median_ms\": %.4f, \"p95_ms\": %.4f, \"mean_ms\": %.4f}%s\n",
+                 r.name.c_str(), r.samples, r.minMs, r.medianMs, r.p95Ms, r.meanMs,
+                 i + 1 < entries.size() ? "," : "");
+  }
+  std::fputs("  ]\n}\n", f);
+
+  if (f != stdout) std::fclose(f);
+  return true;
+}
+
+int Report::compare(const std::string& baselinePath, double tolerance) const {
+  std::ifstream in(baselinePath);
+  if (!in) {
+    std::fprintf(stderr, "Kunne ikke åbne baseline %s\n", baselinePath.c_str());
+    return -1;
+  }
+
+  std::unordered_map<std::string, double> baseline;
+  std::string line;
+  while (std::getline(in, line)) {
+    const char* name = findField(line, "name");
+    const char* median = findField(line, "median_ms");
+    if (!name || !median || *name != '"') continue;
+    const char* end = std::strchr(name + 1, '"');
+    if (!end) continue;
+    baseline[std::string(name + 1, end)] = std::strtod(median, nullptr);
+  }
+
+  int regressions = 0;
+  for (const Result& r : entries) {
+    auto it = baseline.find(r.name);
+    if (it == baseline.end()) {
+      std::fprintf(stderr, "  %-40s ny (ingen baseline)\n", r.name.c_str());
+      continue;
+    }
+
+    const double base = it->second;
+    const double change = base > 0.0 ? (r.medianMs - base) / base : 0.0;
+    const bool regressed = change > tolerance;
+    if (regressed) ++regressions;
+
+    std::fprintf(stderr, "  %-40s %9.3f ms -> %9.3f ms  %+6.1f%%%s\n",
+                 r.name.c_str(), base, r.medianMs, change * 100.0, regressed ? "  REGRESSION" : "");
+  }
+
+  return regressions;
+}
+
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+/*
+ * Samler målinger fra PirateEditorBench og skriver dem som JSON.
+ * Én linje per resultat, så baseline filer kan læses igen uden en JSON parser
+ * og diffes pænt i git.
+ */
+namespace Bench {
+
+struct Result {
+  std::string name;
+  int samples = 0;
+  double minMs = 0.0;
+  double medianMs = 0.0;
+  double p95Ms = 0.0;
+  double meanMs = 0.0;
+};
+
+class Report {
+  public:
+    void add(const std::string& name, std::vector<double> samplesMs);
+
+    /* "-" skriver til stdout */
+    bool write(const std::string& path) const;
+
+    /*
+     * Sammenligner medianer med en tidligere kørsel. Et resultat er en regression
+     * hvis det er mere end tolerance (0.10 = 10%) langsommere end baseline.
+     * Returnerer antal regressioner, eller -1 hvis baseline ikke kunne læses.
+     */
+    int compare(const std::string& baselinePath, double tolerance) const;
+
+    const std::vector<Result>& results() const { return entries; }
+
+  private:
+    std::vector<Result> entries;
+};
+
+}
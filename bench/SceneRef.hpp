@@ -0,0 +1,20 @@
+#pragma once
+
+#include <filesystem>
+#include <string>
+
+namespace Bench {
+
+/*
+ * En scene som benchmarks kører på: en mappe under scenes/ eller levels/ med <navn>_*.csv,
+ * eller et af spillets levels med levels/<n>/level_<n>_*.csv (level >= 0)
+ */
+struct SceneRef {
+  std::filesystem::path root;
+  std::string name;
+  int level = -1;
+
+  std::string id() const { return root.generic_string() + "/" + name; }
+};
+
+}
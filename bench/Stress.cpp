@@ -0,0 +1,233 @@
+#include "Stress.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "memory/FrameArena.hpp"
+#include "profiling/Profiler.hpp"
+#include "scene/Scene.hpp"
+#include "scene/SceneGenerator.hpp"
+#include "scene/SceneSaver.hpp"
+#include "utils/utils.hpp"
+
+namespace Bench {
+
+namespace {
+  struct Placeable {
+    TileType type;
+    int layer;
+    int maxIndex;
+  };
+
+  // Samme lag som paletten i editoren placerer typerne i
+  constexpr Placeable PLACEABLE[] = {
+    { TILE_TYPE_TERRAIN,      1, 15 },
+    { TILE_TYPE_TERRAIN,      1, 15 }, // terrain er det der autotiles - vægt det op
+    { TILE_TYPE_CRATE,        1, 0 },
+    { TILE_TYPE_GRASS,        1, 4 },
+    { TILE_TYPE_ENEMY,        1, 0 },
+    { TILE_TYPE_BG_PALM,      0, 0 },
+    { TILE_TYPE_FG_PALM,      2, 2 },
+    { TILE_TYPE_COIN,         2, 1 },
+    { TILE_TYPE_CONSTRAINT,   2, 1 },
+    { TILE_TYPE_PLAYER_SETUP, 2, 1 },
+  };
+
+  enum class Op { Add, RemoveAt, RemoveLayer, FillRegion, ClearRegion, Count };
+
+  const char* OpName(Op op) {
+    switch (op) {
+      case Op::Add:         return "add";
+      case Op::RemoveAt:    return "removeTileAt";
+      case Op::RemoveLayer: return "removeLayerTiles";
+      case Op::FillRegion:  return "fillRegion";
+      case Op::ClearRegion: return "clearRegion";
+      default:              return "?";
+    }
+  }
+
+  /* Heltal i [0, n) uden <random> distributioner, så sekvensen er ens overalt */
+  int Pick(std::mt19937_64& rng, int n) {
+    return static_cast<int>(rng() % static_cast<std::uint64_t>(n));
+  }
+
+  /* Ikke-tomme celler i en gemt CSV, i samme rækkefølge som LayerSnapshot */
+  std::vector<Scene::SavedTile> ReadSavedLayer(const std::filesystem::path& path) {
+    std::vector<Scene::SavedTile> tiles;
+    const Utils::TileLayer rows = Utils::LoadCSVFile(path.string());
+    for (int y = 0; y < static_cast<int>(rows.size()); ++y) {
+      for (int x = 0; x < static_cast<int>(rows[y].size()); ++x) {
+        if (rows[y][x] >= 0) tiles.push_back({ x, y, rows[y][x] });
+      }
+    }
+    return tiles;
+  }
+
+  /*
+   * Ctrl+S flere gange mens en save kører, med et nyt lag redigeret mellem hver: de ventende
+   * snapshots slås sammen, og til sidst skal filerne på disken svare til scenen
+   */
+  bool CheckOverlappingSaves(Scene::Manager& manager, std::mt19937_64& rng, const StressOptions& options, std::string& error) {
+    const std::filesystem::path root = std::filesystem::temp_directory_path() / "pirate_stress";
+    const std::string name = "Stress";
+
+    Scene::SceneSaver saver;
+    saver.start(manager.snapshotForSave(name, root, true));
+
+    // Saveren regnes som kørende indtil poll, så alle disse venter bag den første
+    for (const Placeable& p : PLACEABLE) {
+      const int x = Pick(rng, options.width);
+      const int y = Pick(rng, options.height);
+      manager.addTileToLayer(TileFactory::createTile(p.type, { (float)x, (float)y }, Pick(rng, p.maxIndex + 1)), p.layer);
+      saver.start(manager.snapshotForSave(name, root));
+    }
+
+    bool ok = true;
+    while (saver.busy()) {
+      if (const std::optional<Scene::SaveResult> result = saver.poll(); result && !result->ok) {
+        error = "save fejlede for " + result->sceneDir.string();
+        ok = false;
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    const Scene::SaveSnapshot expected = manager.snapshotForSave(name, root, true);
+    for (const Scene::LayerSnapshot& layer : expected.layers) {
+      if (!ok) break;
+
+      // Kun det der ligger inden for scenens rect kommer i filen
+      std::vector<Scene::SavedTile> inside;
+      for (const Scene::SavedTile& t : layer.tiles) {
+        if (t.x >= 0 && t.y >= 0 && t.x < expected.width && t.y < expected.height) inside.push_back(t);
+      }
+
+      const std::vector<Scene::SavedTile> onDisk = ReadSavedLayer(expected.sceneDir / (name + layer.suffix));
+      const bool same = std::equal(inside.begin(), inside.end(), onDisk.begin(), onDisk.end(),
+                                   [](const Scene::SavedTile& a, const Scene::SavedTile& b) {
+                                     return a.x == b.x && a.y == b.y && a.index == b.index;
+                                   });
+      if (!same) {
+        error = std::string(layer.suffix) + " på disken passer ikke med scenen (" + std::to_string(onDisk.size()) +
+                " tiles, forventet " + std::to_string(inside.size()) + ")";
+        ok = false;
+      }
+    }
+
+    std::error_code ec;
+    std::filesystem::remove_all(root, ec);
+    return ok;
+  }
+}
+
+bool RunStress(const StressOptions& options, Report& report) {
+  std::fprintf(stderr, "stress: %llu operationer, tjek hver %llu, seed %llu\n",
+               static_cast<unsigned long long>(options.operations),
+               static_cast<unsigned long long>(options.checkEvery),
+               static_cast<unsigned long long>(options.seed));
+
+  Scene::GeneratorConfig config;
+  config.width = options.width;
+  config.height = options.height;
+  config.seed = options.seed;
+  Scene::Manager manager(Scene::GenerateLayout(config), "Stress");
+  Scene::Tiles& tiles = manager.getTiles();
+
+  std::mt19937_64 rng(options.seed);
+  std::vector<double> chunkMs;
+  std::string error;
+  Uint64 busyTicks = 0;
+  Op lastOp = Op::Add;
+
+  const std::uint64_t checkEvery = std::max<std::uint64_t>(1, options.checkEvery);
+  for (std::uint64_t done = 0; done < options.operations;) {
+    const std::uint64_t chunk = std::min(checkEvery, options.operations - done);
+
+    const Uint64 start = SDL_GetPerformanceCounter();
+    for (std::uint64_t i = 0; i < chunk; ++i) {
+      // Én operation svarer til en frame i editoren - frame arenaens scratch frigives imellem
+      Memory::FrameArena::reset();
+      const int x = Pick(rng, options.width);
+      const int y = Pick(rng, options.height);
+
+      // Vægte: 40% add, 20% + 15% enkelt-sletning, 25% regioner
+      const int roll = Pick(rng, 100);
+      lastOp = roll < 40 ? Op::Add
+             : roll < 60 ? Op::RemoveAt
+             : roll < 75 ? Op::RemoveLayer
+             : roll < 88 ? Op::FillRegion
+             : Op::ClearRegion;
+
+      switch (lastOp) {
+        case Op::Add: {
+          const Placeable& p = PLACEABLE[Pick(rng, std::size(PLACEABLE))];
+          const int index = Pick(rng, p.maxIndex + 1);
+          manager.addTileToLayer(TileFactory::createTile(p.type, { (float)x, (float)y }, index), p.layer);
+          break;
+        }
+        case Op::RemoveAt:
+          manager.removeTileAt(x, y, Pick(rng, 3));
+          break;
+        case Op::RemoveLayer:
+          manager.removeLayerTiles(x, y, Pick(rng, 3));
+          break;
+        case Op::FillRegion:
+        case Op::ClearRegion: {
+          // Som multi-select i editoren: op til 8x8 celler ad gangen som én region operation
+          const int w = std::min(1 + Pick(rng, 8), options.width - x);
+          const int h = std::min(1 + Pick(rng, 8), options.height - y);
+          Scene::Selection region;
+          region.set({ x, y, w, h });
+          if (lastOp == Op::FillRegion) {
+            manager.fillRegion(region, TILE_TYPE_TERRAIN, 0);
+          } else {
+            manager.deleteRegion(region, -1);
+          }
+          break;
+        }
+        default: break;
+      }
+    }
+    const Uint64 elapsed = SDL_GetPerformanceCounter() - start;
+    busyTicks += elapsed;
+    chunkMs.push_back(Profiling::Profiler::ticksToMs(elapsed));
+    done += chunk;
+
+    if (!tiles.CheckInvariants(error)) {
+      // Med --check-every 1 er "seneste op" præcis den operation der fejlede
+      std::fprintf(stderr, "stress: invariant brudt efter %llu operationer (seed %llu, seneste op %s): %s\n",
+                   static_cast<unsigned long long>(done), static_cast<unsigned long long>(options.seed),
+                   OpName(lastOp), error.c_str());
+      return false;
+    }
+  }
+
+  const double seconds = Profiling::Profiler::ticksToMs(busyTicks) / 1000.0;
+  size_t tileCount = 0;
+  for (auto* group : tiles.allGroups) tileCount += group->size();
+  std::fprintf(stderr, "stress: %.0f operationer/s (%llu ops på %.2f s, %zu tiles til sidst)\n",
+               seconds > 0.0 ? options.operations / seconds : 0.0,
+               static_cast<unsigned long long>(options.operations), seconds, tileCount);
+
+  report.add("stress/chunk_" + std::to_string(checkEvery), std::move(chunkMs));
+
+  if (!CheckOverlappingSaves(manager, rng, options, error)) {
+    std::fprintf(stderr, "stress: overlappende saves (seed %llu): %s\n",
+                 static_cast<unsigned long long>(options.seed), error.c_str());
+    return false;
+  }
+
+  for (auto* group : tiles.allGroups) {
+    for (auto* t : *group) delete t;
+    group->clear();
+  }
+  tiles.tileLookup.clear();
+  return true;
+}
+
+}
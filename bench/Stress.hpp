@@ -0,0 +1,26 @@
+#pragma once
+
+#include <cstdint>
+
+#include "BenchReport.hpp"
+
+/*
+ * Randomiseret stress test af redigerings-stien: add/remove/region operationer
+ * gennem Scene::Manager med faste frø. Hver checkEvery operation tjekkes at
+ * grupper, tileLookup og autotile stadig er enige (Tiles::CheckInvariants). Til sidst
+ * gemmes scenen med flere overlappende saves, og filerne på disken tjekkes mod scenen.
+ */
+namespace Bench {
+
+struct StressOptions {
+  std::uint64_t operations = 1'000'000;
+  std::uint64_t checkEvery = 10'000;
+  std::uint64_t seed = 1;
+  int width  = 256; // lille område, så operationerne rammer hinanden tit
+  int height = 16;
+};
+
+/* Returnerer false hvis en invariant blev brudt (detaljer skrives til stderr) */
+bool RunStress(const StressOptions& options, Report& report);
+
+}
@@ -0,0 +1,300 @@
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "AllocCheck.hpp"
+#include "BenchReport.hpp"
+#include "SceneRef.hpp"
+#include "Stress.hpp"
+#include "jobs/JobSystem.hpp"
+#include "logging/Logger.hpp"
+#include "profiling/Profiler.hpp"
+#include "scene/Scene.hpp"
+#include "sdl/SDL_Handler.hpp"
+
+/*
+ * PirateEditorBench - headless benchmarks til CI.
+ *
+ * Kører med SDL's offscreen video driver og software rendereren og måler for hver
+ * scene i scenes/ og levels/: load, AutotileAllTerrain, update+draw over en fast
+ * kamera-sweep og saveScene (til en midlertidig mappe).
+ *
+ *   PirateEditorBench [--out fil.json] [--baseline fil.json] [--tolerance 0.10]
+ *                     [--reps 10] [--frames 120] [--filter tekst] [--root mappe] [--verbose]
+ *
+ * Med --stress køres i stedet den randomiserede redigerings-stress test (se Stress.hpp):
+ *
+ *   PirateEditorBench --stress [--stress-ops 1000000] [--check-every 10000] [--seed 1]
+ *
+ * Med --alloc-check køres hele editoren på hver scene, og idle/scroll frames må ikke allokere:
+ *
+ *   PirateEditorBench --alloc-check [--frames 120] [--filter tekst]
+ *
+ * Med --dialog-check åbnes og lukkes dialogerne og popuppen igen og igen, og levende
+ * allokeringer og textures må ikke vokse:
+ *
+ *   PirateEditorBench --dialog-check [--cycles 10] [--filter tekst]
+ *
+ * Exit code 1 betyder at mindst én median er blevet langsommere end baseline tillader
+ * (eller at stress/alloc/dialog testen fejlede).
+ */
+
+namespace fs = std::filesystem;
+
+namespace {
+
+using Bench::SceneRef;
+
+struct Options {
+  std::string out = "-";
+  std::string baseline;
+  std::string filter;
+  std::string root;
+  double tolerance = 0.10;
+  int reps = 10;
+  int frames = 120;
+  bool verbose = false;
+
+  bool stress = false;
+  Bench::StressOptions stressOptions;
+
+  bool allocCheck = false;
+
+  bool dialogCheck = false;
+  int cycles = 10;
+};
+
+constexpr int BENCH_WIDTH  = 1280;
+constexpr int BENCH_HEIGHT = 720;
+
+// Samme grænser som kameraet har i Manager::update
+constexpr float CAMERA_MIN = -512.0f;
+constexpr float CAMERA_MAX = 3072.0f;
+
+void PrintUsage() {
+  std::fputs(
+    "Brug: PirateEditorBench [options]\n"
+    "  --out <fil>          skriv JSON resultat hertil (standard: stdout)\n"
+    "  --baseline <fil>     sammenlign med tidligere resultat, exit 1 ved regression\n"
+    "  --tolerance <x>      tilladt forværring af median (standard 0.10 = 10%)\n"
+    "  --reps <n>           gentagelser for load/autotile/save (standard 10)\n"
+    "  --frames <n>         frames i kamera-sweep (standard 120)\n"
+    "  --filter <tekst>     kør kun scener hvis navn indeholder teksten\n"
+    "  --root <mappe>       mappen med scenes/, levels/ og resources/\n"
+    "  --verbose            vis editorens log\n"
+    "  --stress             kør redigerings-stress testen i stedet for scene benchmarks\n"
+    "  --stress-ops <n>     antal operationer (standard 1000000)\n"
+    "  --check-every <n>    tjek invarianter hver n operationer (standard 10000)\n"
+    "  --seed <n>           frø til stress testen (standard 1)\n"
+    "  --alloc-check        fejl hvis en idle eller scrollende editor frame allokerer\n"
+    "  --dialog-check       fejl hvis dialoger og popup lækker allokeringer eller textures\n"
+    "  --cycles <n>         runder gennem dialogerne (standard 10)\n", stderr);
+}
+
+bool ParseArgs(int argc, char** argv, Options& opt) {
+  for (int i = 1; i < argc; ++i) {
+    const std::string arg = argv[i];
+    auto next = [&]() -> const char* { return i + 1 < argc ? argv[++i] : nullptr; };
+
+    const char* value = nullptr;
+    if (arg == "--verbose")   { opt.verbose = true; continue; }
+    if (arg == "--stress")    { opt.stress = true; continue; }
+    if (arg == "--alloc-check") { opt.allocCheck = true; continue; }
+    if (arg == "--dialog-check") { opt.dialogCheck = true; continue; }
+    if (arg == "--help" || arg == "-h") return false;
+
+    if (!(value = next())) {
+      std::fprintf(stderr, "Mangler værdi til %s\n", arg.c_str());
+      return false;
+    }
+
+    if      (arg == "--out")       opt.out = value;
+    else if (arg == "--baseline")  opt.baseline = value;
+    else if (arg == "--filter")    opt.filter = value;
+    else if (arg == "--root")      opt.root = value;
+    else if (arg == "--tolerance") opt.tolerance = std::atof(value);
+    else if (arg == "--reps")      opt.reps = std::max(1, std::atoi(value));
+    else if (arg == "--frames")    opt.frames = std::max(2, std::atoi(value));
+    else if (arg == "--stress-ops")  opt.stressOptions.operations = std::strtoull(value, nullptr, 10);
+    else if (arg == "--check-every") opt.stressOptions.checkEvery = std::strtoull(value, nullptr, 10);
+    else if (arg == "--seed")        opt.stressOptions.seed = std::strtoull(value, nullptr, 10);
+    else if (arg == "--cycles")      opt.cycles = std::max(1, std::atoi(value));
+    else {
+      std::fprintf(stderr, "Ukendt argument: %s\n", arg.c_str());
+      return false;
+    }
+  }
+  return true;
+}
+
+/* Alle mapper under scenes/ og levels/ med en terrain CSV - enten <navn>_*.csv eller levels/<n>/level_<n>_*.csv */
+std::vector<SceneRef> FindScenes(const std::string& filter) {
+  std::vector<SceneRef> scenes;
+  for (const char* root : { "scenes", "levels" }) {
+    std::error_code ec;
+    for (const auto& entry : fs::directory_iterator(root, ec)) {
+      if (!entry.is_directory()) continue;
+      const std::string name = entry.path().filename().string();
+
+      SceneRef ref { root, name };
+      // Spillets levels hedder levels/<n>/level_<n>_*.csv og indlæses via Layout(level)
+      const bool numbered = !name.empty() && std::all_of(name.begin(), name.end(), [](unsigned char c) { return std::isdigit(c); });
+      if (!fs::exists(entry.path() / (name + "_terrain.csv"))) {
+        if (ref.root != "levels" || !numbered || !fs::exists(entry.path() / ("level_" + name + "_terrain.csv"))) {
+          std::fprintf(stderr, "Springer %s over: ingen %s_terrain.csv eller level_<n>_terrain.csv\n", ref.id().c_str(), name.c_str());
+          continue;
+        }
+        ref.level = std::atoi(name.c_str());
+      }
+
+      if (!filter.empty() && ref.id().find(filter) == std::string::npos) continue;
+      scenes.push_back(std::move(ref));
+    }
+  }
+
+  std::sort(scenes.begin(), scenes.end(), [](const SceneRef& a, const SceneRef& b) { return a.id() < b.id(); });
+  return scenes;
+}
+
+template<typename Fn>
+double TimeMs(Fn&& fn) {
+  const Uint64 start = SDL_GetPerformanceCounter();
+  fn();
+  return Profiling::Profiler::ticksToMs(SDL_GetPerformanceCounter() - start);
+}
+
+/* Første kørsel er opvarmning (texture cache, page faults) og tælles ikke med */
+template<typename Fn>
+std::vector<double> Repeat(int reps, Fn&& fn) {
+  fn();
+  std::vector<double> samples;
+  samples.reserve(reps);
+  for (int i = 0; i < reps; ++i) samples.push_back(TimeMs(fn));
+  return samples;
+}
+
+void BenchScene(const SceneRef& scene, const Options& opt, SDL_Handler& sdl, Scene::Manager& manager, Bench::Report& report) {
+  const std::string id = scene.id();
+  std::fprintf(stderr, "%s\n", id.c_str());
+
+  report.add("load/" + id, Repeat(opt.reps, [&] {
+    if (scene.level >= 0) manager.loadLevel(static_cast<unsigned int>(scene.level));
+    else manager.loadSceneFromFolder(scene.name, scene.root);
+  }));
+
+  report.add("autotile/" + id, Repeat(opt.reps, [&] { manager.getTiles().AutotileAllTerrain(); }));
+
+  // Fast kamera-sweep fra venstre til højre kant med fast deltaTime
+  SDL_State& state = sdl.getState();
+  std::vector<double> frameSamples;
+  frameSamples.reserve(opt.frames);
+  for (int i = -1; i < opt.frames; ++i) {
+    const int frame = std::max(i, 0);
+    state.deltaTime = 1.0f / 60.0f;
+    state.cameraPos.x = CAMERA_MIN + (CAMERA_MAX - CAMERA_MIN) * frame / (opt.frames - 1);
+
+    Render::BeginFrame();
+    const double ms = TimeMs([&] {
+      manager.fixedUpdate(state, state.deltaTime, true);
+      manager.update(state);
+      sdl.clear();
+      manager.draw(state.renderer);
+      sdl.present();
+    });
+    if (i >= 0) frameSamples.push_back(ms);
+  }
+  report.add("frame/" + id, std::move(frameSamples));
+
+  const fs::path saveRoot = fs::temp_directory_path() / "pirate_bench";
+  report.add("save/" + id, Repeat(opt.reps, [&] { manager.saveScene(scene.name, saveRoot); }));
+
+  std::error_code ec;
+  fs::remove_all(saveRoot, ec);
+}
+
+}
+
+int main(int argc, char** argv) {
+  Options opt;
+  if (!ParseArgs(argc, argv, opt)) {
+    PrintUsage();
+    return 2;
+  }
+
+  if (!opt.root.empty()) {
+    std::error_code ec;
+    fs::current_path(opt.root, ec);
+    if (ec) {
+      std::fprintf(stderr, "Kunne ikke skifte til %s\n", opt.root.c_str());
+      return 2;
+    }
+  }
+
+  Log::Init();
+  if (!opt.verbose) SDL_SetLogPriorities(SDL_LOG_PRIORITY_ERROR);
+  Profiling::Profiler::init();
+  Jobs::Scope jobs;
+
+  // Skyerne bruger rand(), så hver kørsel skal have samme frø
+  std::srand(1337);
+
+  SDL_Handler sdl({
+    .title = "PirateEditorBench",
+    .width = BENCH_WIDTH,
+    .height = BENCH_HEIGHT,
+    .headless = true
+  });
+  if (!sdl.isRunning()) {
+    std::fputs("Kunne ikke initialisere SDL headless\n", stderr);
+    return 2;
+  }
+
+  Bench::Report report;
+  bool failed = false;
+  if (opt.stress) {
+    if (!Bench::RunStress(opt.stressOptions, report)) return 1;
+  } else {
+    const std::vector<SceneRef> scenes = FindScenes(opt.filter);
+    if (scenes.empty()) {
+      std::fputs("Ingen scener fundet i scenes/ eller levels/\n", stderr);
+      return 2;
+    }
+
+    if (opt.allocCheck) {
+      const Bench::AllocCheckOptions allocOptions { opt.frames, opt.verbose };
+      for (const SceneRef& scene : scenes) {
+        std::fprintf(stderr, "%s\n", scene.id().c_str());
+        if (!Bench::RunAllocCheck(sdl, scene, allocOptions, report)) failed = true;
+      }
+    } else if (opt.dialogCheck) {
+      const Bench::DialogCheckOptions dialogOptions { opt.cycles, opt.verbose };
+      for (const SceneRef& scene : scenes) {
+        std::fprintf(stderr, "%s\n", scene.id().c_str());
+        if (!Bench::RunDialogCheck(sdl, scene, dialogOptions, report)) failed = true;
+      }
+    } else {
+      Scene::Manager manager(0, "Bench");
+      for (const SceneRef& scene : scenes) {
+        BenchScene(scene, opt, sdl, manager, report);
+      }
+    }
+  }
+
+  if (!report.write(opt.out)) return 2;
+  if (failed) return 1;
+
+  if (!opt.baseline.empty()) {
+    const int regressions = report.compare(opt.baseline, opt.tolerance);
+    if (regressions < 0) return 2;
+    if (regressions > 0) {
+      std::fprintf(stderr, "%d regression(er) over %.0f%% tolerance\n", regressions, opt.tolerance * 100.0);
+      return 1;
+    }
+  }
+
+  return 0;
+}
@@ -0,0 +1,187 @@
+#include "MicroHarness.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <numeric>
+#include <SDL3/SDL.h>
+
+#include "memory/FrameArena.hpp"
+
+#if defined(__linux__)
+  #include <linux/perf_event.h>
+  #include <sys/ioctl.h>
+  #include <sys/syscall.h>
+  #include <unistd.h>
+#endif
+
+namespace Micro {
+
+#if defined(__linux__)
+namespace {
+  int openCounter(std::uint32_t type, std::uint64_t config, int groupFd) {
+    perf_event_attr attr {};
+    attr.size = sizeof(attr);
+    attr.type = type;
+    attr.config = config;
+    attr.disabled = groupFd < 0 ? 1 : 0;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_GROUP;
+    return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, groupFd, 0));
+  }
+}
+
+PerfCounters::PerfCounters() {
+  leader = openCounter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES, -1);
+  if (leader < 0) {
+    std::fputs("perf_event_open ikke tilgængelig - kører uden CPU tællere\n", stderr);
+    return;
+  }
+  fds.push_back(leader);
+
+  const std::uint64_t others[] = {
+    PERF_COUNT_HW_INSTRUCTIONS,
+    PERF_COUNT_HW_CACHE_MISSES,
+    PERF_COUNT_HW_BRANCH_MISSES
+  };
+  for (std::uint64_t config : others) {
+    const int fd = openCounter(PERF_TYPE_HARDWARE, config, leader);
+    if (fd < 0) {
+      // Hele gruppen eller intet, så tallene altid er fra samme kørsel
+      for (int f : fds) close(f);
+      fds.clear();
+      leader = -1;
+      std::fputs("perf_event_open mangler tællere - kører uden CPU tællere\n", stderr);
+      return;
+    }
+    fds.push_back(fd);
+  }
+}
+
+PerfCounters::~PerfCounters() {
+  for (int fd : fds) close(fd);
+}
+
+void PerfCounters::start() {
+  if (leader < 0) return;
+  ioctl(leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+  ioctl(leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+}
+
+CpuCounters PerfCounters::stop() {
+  CpuCounters c;
+  if (leader < 0) return c;
+  ioctl(leader, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+
+  // PERF_FORMAT_GROUP: antal efterfulgt af værdierne i den rækkefølge de blev åbnet
+  std::uint64_t data[1 + 4] {};
+  if (read(leader, data, sizeof(data)) < static_cast<ssize_t>(sizeof(std::uint64_t) * 5)) return c;
+
+  c.valid        = true;
+  c.cycles       = static_cast<double>(data[1]);
+  c.instructions = static_cast<double>(data[2]);
+  c.cacheMisses  = static_cast<double>(data[3]);
+  c.branchMisses = static_cast<double>(data[4]);
+  return c;
+}
+#else
+PerfCounters::PerfCounters() {}
+PerfCounters::~PerfCounters() {}
+void PerfCounters::start() {}
+CpuCounters PerfCounters::stop() { return {}; }
+#endif
+
+Harness::Harness(Options options)
+  : options(std::move(options)) {}
+
+void Harness::run(const std::string& name, std::size_t tiles, std::uint64_t opsPerRep,
+                  const std::function<void()>& fn, const std::function<void()>& setup) {
+  if (!options.filter.empty() && name.find(options.filter) == std::string::npos) return;
+  if (opsPerRep == 0) opsPerRep = 1;
+
+  // Hver kørsel svarer til en frame: frame arenaens scratch (ApplyChanges, floodFill) frigives imellem
+  for (int i = 0; i < options.warmup; ++i) {
+    Memory::FrameArena::reset();
+    if (setup) setup();
+    fn();
+  }
+
+  const double ticksToNs = 1e9 / static_cast<double>(SDL_GetPerformanceFrequency());
+  std::vector<double> samples;
+  samples.reserve(options.reps);
+  CpuCounters total;
+  total.valid = perf.available();
+
+  for (int i = 0; i < options.reps; ++i) {
+    Memory::FrameArena::reset();
+    if (setup) setup();
+
+    perf.start();
+    const Uint64 start = SDL_GetPerformanceCounter();
+    fn();
+    const Uint64 end = SDL_GetPerformanceCounter();
+    const CpuCounters c = perf.stop();
+
+    samples.push_back((end - start) * ticksToNs / opsPerRep);
+    total.valid = total.valid && c.valid;
+    total.cycles       += c.cycles;
+    total.instructions += c.instructions;
+    total.cacheMisses  += c.cacheMisses;
+    total.branchMisses += c.branchMisses;
+  }
+
+  CaseResult r;
+  r.name = name;
+  r.tiles = tiles;
+  r.reps = options.reps;
+  r.opsPerRep = opsPerRep;
+
+  std::sort(samples.begin(), samples.end());
+  auto at = [&](double p) { return samples[std::min(samples.size() - 1, static_cast<size_t>(p * (samples.size() - 1) + 0.5))]; };
+  r.minNs    = samples.front();
+  r.medianNs = at(0.5);
+  r.p95Ns    = at(0.95);
+  r.meanNs   = std::accumulate(samples.begin(), samples.end(), 0.0) / samples.size();
+  double var = 0.0;
+  for (double s : samples) var += (s - r.meanNs) * (s - r.meanNs);
+  r.stddevNs = samples.size() > 1 ? std::sqrt(var / (samples.size() - 1)) : 0.0;
+
+  if (total.valid) {
+    const double ops = static_cast<double>(opsPerRep) * options.reps;
+    r.perOp = { true, total.cycles / ops, total.instructions / ops, total.cacheMisses / ops, total.branchMisses / ops };
+  }
+
+  std::fprintf(stderr, "%-28s %9zu tiles  median %10.1f ns/op  p95 %10.1f ns/op%s\n",
+               name.c_str(), tiles, r.medianNs, r.p95Ns,
+               r.perOp.valid ? "" : "  (ingen perf)");
+  entries.push_back(std::move(r));
+}
+
+bool Harness::writeCSV(const std::string& path) const {
+  std::FILE* f = path == "-" ? stdout : std::fopen(path.c_str(), "wb");
+  if (!f) {
+    std::fprintf(stderr, "Kunne ikke skrive til %s\n", path.c_str());
+    return false;
+  }
+
+  std::fputs("name,tiles,reps,ops_per_rep,min_ns,median_ns,p95_ns,mean_ns,stddev_ns,"
+             "cycles,instructions,ipc,cache_misses,branch_misses\n", f);
+  for (const CaseResult& r : entries) {
+    std::fprintf(f, "%s,%zu,%d,%llu,%.2f,%.2f,%.2f,%.2f,%.2f,",
+                 r.name.c_str(), r.tiles, r.reps, static_cast<unsigned long long>(r.opsPerRep),
+                 r.minNs, r.medianNs, r.p95Ns, r.meanNs, r.stddevNs);
+    if (r.perOp.valid) {
+      const double ipc = r.perOp.cycles > 0.0 ? r.perOp.instructions / r.perOp.cycles : 0.0;
+      std::fprintf(f, "%.1f,%.1f,%.3f,%.3f,%.3f\n", r.perOp.cycles, r.perOp.instructions, ipc,
+                   r.perOp.cacheMisses, r.perOp.branchMisses);
+    } else {
+      std::fputs(",,,,\n", f);
+    }
+  }
+
+  if (f != stdout) std::fclose(f);
+  return true;
+}
+
+}
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+/*
+ * Lille microbenchmark harness: opvarmning, gentagelser, statistik per operation
+ * og CPU tællere (cycles, instructions, cache/branch misses) via perf_event_open
+ * på Linux. Andre platforme og maskiner uden adgang til perf får bare tiderne.
+ */
+namespace Micro {
+
+/* Forhindrer compileren i at fjerne et resultat der ellers ikke bruges */
+template<typename T>
+inline void DoNotOptimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+  asm volatile("" : : "g"(&value) : "memory");
+#else
+  static volatile const void* sink;
+  sink = &value;
+#endif
+}
+
+struct CpuCounters {
+  bool valid = false;
+  double cycles = 0.0;
+  double instructions = 0.0;
+  double cacheMisses = 0.0;
+  double branchMisses = 0.0;
+};
+
+class PerfCounters {
+  public:
+    PerfCounters();
+    ~PerfCounters();
+
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    bool available() const { return leader >= 0; }
+    void start();
+    CpuCounters stop();
+
+  private:
+    int leader = -1;
+    std::vector<int> fds;
+};
+
+struct CaseResult {
+  std::string name;
+  std::size_t tiles = 0;
+  int reps = 0;
+  std::uint64_t opsPerRep = 0;
+
+  // Alle tider er ns per operation
+  double minNs = 0.0;
+  double medianNs = 0.0;
+  double p95Ns = 0.0;
+  double meanNs = 0.0;
+  double stddevNs = 0.0;
+
+  CpuCounters perOp;
+};
+
+struct Options {
+  int warmup = 3;
+  int reps = 15;
+  std::string filter;
+};
+
+class Harness {
+  public:
+    explicit Harness(Options options);
+
+    /*
+     * Kører fn() warmup + reps gange. fn udfører opsPerRep operationer per kald.
+     * setup kaldes før hver kørsel og tæller ikke med i tiden.
+     */
+    void run(const std::string& name, std::size_t tiles, std::uint64_t opsPerRep,
+             const std::function<void()>& fn, const std::function<void()>& setup = {});
+
+    /* CSV med én linje per case og størrelse - klar til at plotte skaleringskurver */
+    bool writeCSV(const std::string& path) const;
+
+    const std::vector<CaseResult>& results() const { return entries; }
+
+  private:
+    Options options;
+    PerfCounters perf;
+    std::vector<CaseResult> entries;
+};
+
+}
@@ -0,0 +1,282 @@
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "MicroHarness.hpp"
+#include "logging/Logger.hpp"
+#include "scene/Scene.hpp"
+#include "scene/SceneGenerator.hpp"
+#include "sdl/SDL_Handler.hpp"
+#include "ui/RichText.hpp"
+
+/*
+ * PirateMicroBench - microbenchmarks af de varme primitiver i scene/tile koden.
+ *
+ * Hver størrelse i --sizes er en syntetisk scene (SceneGenerator) med ca. så mange
+ * tiles, så man kan plotte skaleringskurver (fx 10^3 til 10^6). Output er CSV.
+ *
+ *   PirateMicroBench [--sizes 1000,10000,100000] [--reps 15] [--warmup 3]
+ *                    [--filter navn] [--seed 1] [--out fil.csv] [--root mappe]
+ */
+
+namespace fs = std::filesystem;
+
+namespace {
+
+constexpr int SCENE_HEIGHT   = 32;   // rækker i de syntetiske scener
+constexpr int QUERIES        = 4096; // opslag per rep for lookup cases
+constexpr int EDITS          = 64;   // tiles per rep for remove/add
+
+struct Options {
+  std::vector<std::size_t> sizes { 1000, 10000, 100000 };
+  std::string out = "-";
+  std::string root;
+  unsigned seed = 1;
+  Micro::Options harness;
+};
+
+void PrintUsage() {
+  std::fputs(
+    "Brug: PirateMicroBench [options]\n"
+    "  --sizes <a,b,c>   antal tiles i de syntetiske scener (standard 1000,10000,100000)\n"
+    "  --reps <n>        målte gentagelser (standard 15)\n"
+    "  --warmup <n>      opvarmning før måling (standard 3)\n"
+    "  --filter <navn>   kør kun cases hvis navn indeholder teksten\n"
+    "  --seed <n>        frø til de syntetiske scener (standard 1)\n"
+    "  --out <fil>       skriv CSV hertil (standard: stdout)\n"
+    "  --root <mappe>    mappen med resources/\n", stderr);
+}
+
+bool ParseArgs(int argc, char** argv, Options& opt) {
+  for (int i = 1; i < argc; ++i) {
+    const std::string arg = argv[i];
+    if (arg == "--help" || arg == "-h") return false;
+    if (i + 1 >= argc) {
+      std::fprintf(stderr, "Mangler værdi til %s\n", arg.c_str());
+      return false;
+    }
+    const std::string value = argv[++i];
+
+    if (arg == "--sizes") {
+      opt.sizes.clear();
+      size_t start = 0;
+      while (start <= value.size()) {
+        const size_t comma = std::min(value.find(',', start), value.size());
+        const long long n = std::atoll(value.substr(start, comma - start).c_str());
+        if (n > 0) opt.sizes.push_back(static_cast<std::size_t>(n));
+        start = comma + 1;
+      }
+    }
+    else if (arg == "--reps")   opt.harness.reps = std::max(1, std::atoi(value.c_str()));
+    else if (arg == "--warmup") opt.harness.warmup = std::max(0, std::atoi(value.c_str()));
+    else if (arg == "--filter") opt.harness.filter = value;
+    else if (arg == "--seed")   opt.seed = static_cast<unsigned>(std::atoi(value.c_str()));
+    else if (arg == "--out")    opt.out = value;
+    else if (arg == "--root")   opt.root = value;
+    else {
+      std::fprintf(stderr, "Ukendt argument: %s\n", arg.c_str());
+      return false;
+    }
+  }
+  return !opt.sizes.empty();
+}
+
+/* Syntetisk scene fra generatoren med ca. targetTiles tiles (~16 per kolonne ved 32 rækker og density 0.5) */
+Scene::Layout MakeSyntheticLayout(std::size_t targetTiles, unsigned seed) {
+  Scene::GeneratorConfig config;
+  config.width = std::max<int>(16, static_cast<int>(targetTiles / 16));
+  config.height = SCENE_HEIGHT;
+  config.seed = seed;
+  config.terrainDensity = 0.5f;
+  return Scene::GenerateLayout(config);
+}
+
+void FreeTiles(Scene::Tiles& tiles) {
+  for (auto* group : tiles.allGroups) {
+    for (auto* t : *group) delete t;
+    group->clear();
+  }
+  tiles.tileLookup.clear();
+}
+
+struct Cell { int x; int y; };
+
+void BenchSize(std::size_t size, const Options& opt, Micro::Harness& harness) {
+  std::mt19937 rng(opt.seed + static_cast<unsigned>(size));
+  Scene::Layout layout = MakeSyntheticLayout(size, opt.seed);
+  const Utils::TileLayer terrainLayout = layout.terrainLayout;
+  const int width = static_cast<int>(terrainLayout.front().size());
+  const std::uint64_t cells = static_cast<std::uint64_t>(width) * SCENE_HEIGHT;
+
+  // --- CSV ---
+  const fs::path csvPath = fs::temp_directory_path() / "pirate_micro" / "terrain.csv";
+  Scene::WriteCSV(csvPath, terrainLayout);
+
+  harness.run("Utils::LoadCSVFile", size, cells, [&] {
+    Micro::DoNotOptimize(Utils::LoadCSVFile(csvPath.string()));
+  });
+
+  harness.run("Scene::WriteCSV", size, cells, [&] {
+    Scene::WriteCSV(csvPath, terrainLayout);
+  });
+
+  // --- Tiles ---
+  Scene::Manager manager(std::move(layout), "Micro");
+  Scene::Tiles& tiles = manager.getTiles();
+  if (tiles.terrainTiles.empty()) return;
+
+  std::uniform_int_distribution<int> rx(0, width - 1), ry(0, SCENE_HEIGHT - 1);
+  std::vector<Cell> queries(QUERIES);
+  for (auto& q : queries) q = { rx(rng), ry(rng) };
+
+  std::vector<Cell> terrainCells(QUERIES);
+  std::uniform_int_distribution<size_t> pick(0, tiles.terrainTiles.size() - 1);
+  for (auto& c : terrainCells) {
+    const Tile* t = tiles.terrainTiles[pick(rng)];
+    c = { static_cast<int>(t->position.x), static_cast<int>(t->position.y) };
+  }
+
+  harness.run("Tiles::GetTileOfType", size, QUERIES, [&] {
+    for (const Cell& q : queries) Micro::DoNotOptimize(tiles.GetTileOfType(q.x, q.y, TILE_TYPE_TERRAIN));
+  });
+
+  harness.run("Tiles::AutotileRecalcAt", size, QUERIES, [&] {
+    for (const Cell& c : terrainCells) tiles.AutotileRecalcAt(c.x, c.y);
+  });
+
+  // Unikke terrain celler der skiftevis fjernes og sættes ind igen
+  std::vector<Cell> editCells;
+  for (const Cell& c : terrainCells) {
+    if (editCells.size() == EDITS) break;
+    if (std::none_of(editCells.begin(), editCells.end(), [&](const Cell& e) { return e.x == c.x && e.y == c.y; }))
+      editCells.push_back(c);
+  }
+
+  const int terrainLayer = 1;
+  auto ensurePresent = [&] {
+    for (const Cell& c : editCells)
+      if (!tiles.HasTileOfType(c.x, c.y, TILE_TYPE_TERRAIN))
+        manager.addTileToLayer(TileFactory::createTile(TILE_TYPE_TERRAIN, {(float)c.x, (float)c.y}, 5), terrainLayer);
+  };
+  auto ensureRemoved = [&] {
+    for (const Cell& c : editCells) tiles.RemoveTile(c.x, c.y, terrainLayer);
+  };
+
+  harness.run("Tiles::RemoveTile", size, editCells.size(), [&] {
+    for (const Cell& c : editCells) tiles.RemoveTile(c.x, c.y, terrainLayer);
+  }, ensurePresent);
+
+  std::vector<Tile*> pending;
+  harness.run("Manager::addTileToLayer", size, editCells.size(), [&] {
+    for (Tile* t : pending) manager.addTileToLayer(t, terrainLayer);
+  }, [&] {
+    ensureRemoved();
+    pending.clear();
+    for (const Cell& c : editCells)
+      pending.push_back(TileFactory::createTile(TILE_TYPE_TERRAIN, {(float)c.x, (float)c.y}, 5));
+  });
+
+  // En markering over scenen fyldes og tømmes som én mutation (ét autotile pass)
+  Scene::Selection region;
+  region.set({ 0, 1, std::min(width, 256), SCENE_HEIGHT - 1 });
+  const size_t regionCells = static_cast<size_t>(region.cellCount());
+
+  harness.run("Manager::fillRegion", size, regionCells, [&] {
+    manager.fillRegion(region, TILE_TYPE_TERRAIN, 0);
+  }, [&] { manager.deleteRegion(region, terrainLayer); });
+
+  harness.run("Manager::deleteRegion", size, regionCells, [&] {
+    manager.deleteRegion(region, terrainLayer);
+  }, [&] { manager.fillRegion(region, TILE_TYPE_TERRAIN, 0); });
+
+  // Flood fill af hele den tømte scene (rækkerne under den øverste)
+  Scene::Selection wholeScene;
+  wholeScene.set({ 0, 1, width, SCENE_HEIGHT - 1 });
+  harness.run("Manager::floodFill", size, static_cast<size_t>(wholeScene.cellCount()), [&] {
+    manager.floodFill(0, 1, TILE_TYPE_TERRAIN, 0);
+  }, [&] { manager.deleteRegion(wholeScene, terrainLayer); });
+
+  FreeTiles(tiles);
+}
+
+/* Cases der ikke afhænger af scenens størrelse */
+void BenchFixed(Micro::Harness& harness) {
+  constexpr std::string_view markup = "{white}Edit mode: {green}ON {white}| Layer view: {red}OFF {white}| Layer: {yellow}Terrain";
+  constexpr int TEXTS = 1000;
+
+  UI::RichText text;
+  harness.run("UI::RichText::compile", 0, TEXTS, [&] {
+    for (int i = 0; i < TEXTS; ++i) {
+      text.compile(markup);
+      Micro::DoNotOptimize(text);
+    }
+  });
+
+  harness.run("UI::ForEachRichSegment", 0, TEXTS, [&] {
+    for (int i = 0; i < TEXTS; ++i) {
+      size_t total = 0;
+      UI::ForEachRichSegment(markup, [&](std::string_view seg, UI::TextColor) { total += seg.size(); });
+      Micro::DoNotOptimize(total);
+    }
+  });
+
+  const std::string paths[] = {
+    "resources/decoration/sky/sky_top.png",
+    "resources/decoration/sky/sky_middle.png",
+    "resources/decoration/sky/sky_bottom.png",
+    "resources/decoration/clouds/1.png"
+  };
+  for (const auto& p : paths) Micro::DoNotOptimize(ResourceManager::loadTexture(p));
+
+  harness.run("ResourceManager::loadTexture (hit)", 0, QUERIES, [&] {
+    for (int i = 0; i < QUERIES; ++i) Micro::DoNotOptimize(ResourceManager::loadTexture(paths[i & 3]));
+  });
+}
+
+}
+
+int main(int argc, char** argv) {
+  Options opt;
+  if (!ParseArgs(argc, argv, opt)) {
+    PrintUsage();
+    return 2;
+  }
+
+  if (!opt.root.empty()) {
+    std::error_code ec;
+    fs::current_path(opt.root, ec);
+    if (ec) {
+      std::fprintf(stderr, "Kunne ikke skifte til %s\n", opt.root.c_str());
+      return 2;
+    }
+  }
+
+  Log::Init();
+  SDL_SetLogPriorities(SDL_LOG_PRIORITY_ERROR);
+  std::srand(opt.seed);
+
+  // Tiles henter textures gennem ResourceManager, så vi skal bruge en (headless) renderer
+  SDL_Handler sdl({
+    .title = "PirateMicroBench",
+    .width = 640,
+    .height = 360,
+    .headless = true
+  });
+  if (!sdl.isRunning()) {
+    std::fputs("Kunne ikke initialisere SDL headless\n", stderr);
+    return 2;
+  }
+
+  Micro::Harness harness(opt.harness);
+  BenchFixed(harness);
+  for (std::size_t size : opt.sizes) BenchSize(size, opt, harness);
+
+  std::error_code ec;
+  fs::remove_all(fs::temp_directory_path() / "pirate_micro", ec);
+
+  return harness.writeCSV(opt.out) ? 0 : 2;
+}
@@ -9,25 +9,25 @@ AudioHandler::AudioHandler() {
   initialized = false;
 
   if(!MIX_Init()) {
-    Log::Error("Kunne ikke initialisere SDL_mixer");
+    Log::Error(Log::Category::Audio, "Kunne ikke initialisere SDL_mixer");
     return;
   }
 
   mixer = MIX_CreateMixerDevice(SDL_AUDIO_DEVICE_DEFAULT_PLAYBACK, nullptr);
   if(!mixer) {
-    Log::Error("Kunne ikke oprette mixer");
+    Log::Error(Log::Category::Audio, "Kunne ikke oprette mixer");
     return;
   }
 
   track = MIX_CreateTrack(mixer);
   if(!track) {
-    Log::Error("Kunne ikke oprette track");
+    Log::Error(Log::Category::Audio, "Kunne ikke oprette track");
     return;
   }
 
   overworld_audio = MIX_LoadAudio(mixer, "audio/overworld_music.wav", true);
   if(!overworld_audio) {
-    Log::Error("Kunne ikke indlæse overworld musik");
+    Log::Error(Log::Category::Audio, "Kunne ikke indlæse overworld musik");
     return;
   }
 
@@ -48,7 +48,7 @@ void AudioHandler::destroy() {
 
 void AudioHandler::playTrack() const {
   if(!initialized) {
-    Log::Error("AudioHandler ikke initialiseret");
+    Log::Error(Log::Category::Audio, "AudioHandler ikke initialiseret");
     return;
   }
 
@@ -0,0 +1,291 @@
+#include "JobSystem.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdio>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+#include "SDL3/SDL.h"
+#include "logging/Logger.hpp"
+#include "logging/Trace.hpp"
+
+namespace Jobs {
+
+struct Job {
+  const char* name = nullptr;
+  std::function<void()> fn;
+  std::atomic<int> waiting { 1 };   // deps der ikke er færdige + 1 mens Submit stadig kører
+  std::atomic<bool> done { false };
+  std::mutex lock;
+  std::vector<Handle> continuations; // jobs der venter på dette
+};
+
+namespace {
+  struct Counters {
+    std::atomic<std::uint64_t> jobs { 0 };
+    std::atomic<std::uint64_t> steals { 0 };
+    std::atomic<Uint64> busyTicks { 0 };
+  };
+
+  struct WorkerThread {
+    std::mutex lock;
+    std::deque<Handle> queue;
+    std::thread thread;
+    char name[16] {};
+    Counters counters;
+  };
+
+  std::vector<std::unique_ptr<WorkerThread>> s_workers;
+  Counters s_external; // main og andre tråde der hjælper i Wait
+
+  // Jobs startet fra tråde uden egen kø
+  std::mutex s_globalLock;
+  std::deque<Handle> s_global;
+
+  std::mutex s_sleepLock;
+  std::condition_variable s_sleep;
+  std::atomic<int> s_queued { 0 };
+  std::atomic<bool> s_stop { false };
+
+  thread_local int t_worker = -1;
+
+  Counters& CountersForThread() {
+    return t_worker >= 0 ? s_workers[t_worker]->counters : s_external;
+  }
+
+  void Schedule(Handle job) {
+    if (t_worker >= 0) {
+      WorkerThread& self = *s_workers[t_worker];
+      std::lock_guard guard(self.lock);
+      self.queue.push_back(std::move(job));
+    } else {
+      std::lock_guard guard(s_globalLock);
+      s_global.push_back(std::move(job));
+    }
+    s_queued.fetch_add(1, std::memory_order_release);
+
+    // Låsen tages så en worker ikke kan misse vækningen mellem sit tjek og sin wait
+    { std::lock_guard guard(s_sleepLock); }
+    s_sleep.notify_one();
+  }
+
+  void Finish(Job& job) {
+    std::vector<Handle> ready;
+    {
+      std::lock_guard guard(job.lock);
+      job.done.store(true, std::memory_order_release);
+      ready.swap(job.continuations);
+    }
+    for (Handle& next : ready) {
+      if (next->waiting.fetch_sub(1, std::memory_order_acq_rel) == 1) Schedule(std::move(next));
+    }
+  }
+
+  void Execute(const Handle& job) {
+    Counters& counters = CountersForThread();
+    const Uint64 start = SDL_GetPerformanceCounter();
+    {
+      TRACE_SCOPE(job->name, "job");
+      job->fn();
+    }
+    job->fn = nullptr; // det fangede frigives med det samme, ikke når sidste Handle forsvinder
+    counters.busyTicks.fetch_add(SDL_GetPerformanceCounter() - start, std::memory_order_relaxed);
+    counters.jobs.fetch_add(1, std::memory_order_relaxed);
+    Finish(*job);
+  }
+
+  Handle PopFront(std::mutex& lock, std::deque<Handle>& queue) {
+    std::lock_guard guard(lock);
+    if (queue.empty()) return nullptr;
+    Handle job = std::move(queue.front());
+    queue.pop_front();
+    return job;
+  }
+
+  bool TryRunOne() {
+    Handle job;
+    if (t_worker >= 0) {
+      // Egen kø bagfra - det nyeste job har sine data i cachen
+      WorkerThread& self = *s_workers[t_worker];
+      std::lock_guard guard(self.lock);
+      if (!self.queue.empty()) {
+        job = std::move(self.queue.back());
+        self.queue.pop_back();
+      }
+    }
+    if (!job) job = PopFront(s_globalLock, s_global);
+    if (!job && !s_workers.empty()) {
+      // Stjæl forfra (de ældste, typisk største jobs) - start hos naboen, så alle ikke rammer worker 0
+      const int count = static_cast<int>(s_workers.size());
+      const int first = t_worker >= 0 ? t_worker + 1 : 0;
+      for (int i = 0; i < count && !job; ++i) {
+        const int victim = (first + i) % count;
+        if (victim == t_worker) continue;
+        job = PopFront(s_workers[victim]->lock, s_workers[victim]->queue);
+      }
+      if (job) CountersForThread().steals.fetch_add(1, std::memory_order_relaxed);
+    }
+    if (!job) return false;
+
+    s_queued.fetch_sub(1, std::memory_order_acq_rel);
+    Execute(job);
+    return true;
+  }
+
+  void WorkerLoop(int index) {
+    t_worker = index;
+    Log::Trace::SetThreadName(s_workers[index]->name);
+
+    while (true) {
+      if (TryRunOne()) continue;
+
+      std::unique_lock guard(s_sleepLock);
+      s_sleep.wait(guard, [] { return s_queued.load(std::memory_order_acquire) > 0 || s_stop.load(std::memory_order_acquire); });
+      if (s_stop.load(std::memory_order_acquire) && s_queued.load(std::memory_order_acquire) == 0) break;
+    }
+  }
+
+  WorkerStats ToStats(const char* name, const Counters& counters) {
+    WorkerStats stats;
+    stats.name = name;
+    stats.jobs = counters.jobs.load(std::memory_order_relaxed);
+    stats.steals = counters.steals.load(std::memory_order_relaxed);
+    stats.busyMs = static_cast<double>(counters.busyTicks.load(std::memory_order_relaxed)) * 1000.0 /
+                   static_cast<double>(SDL_GetPerformanceFrequency());
+    return stats;
+  }
+}
+
+void Init(int workers) {
+  if (!s_workers.empty()) return;
+
+  // Mindst én, ellers kører jobs fra main tråden kun når nogen venter på dem
+  if (workers < 0) workers = std::max(1, static_cast<int>(std::thread::hardware_concurrency()) - 1);
+  workers = std::clamp(workers, 0, MAX_WORKERS);
+  s_stop.store(false, std::memory_order_release);
+
+  // Alle workers findes før den første starter - de stjæler fra hinanden via s_workers
+  for (int i = 0; i < workers; ++i) {
+    auto worker = std::make_unique<WorkerThread>();
+    std::snprintf(worker->name, sizeof(worker->name), "job %d", i);
+    s_workers.push_back(std::move(worker));
+  }
+  for (int i = 0; i < workers; ++i) {
+    s_workers[i]->thread = std::thread(WorkerLoop, i);
+  }
+
+  Log::Info("Job system startet med {} workers", workers);
+}
+
+void Shutdown() {
+  if (s_workers.empty()) return;
+
+  {
+    std::lock_guard guard(s_sleepLock);
+    s_stop.store(true, std::memory_order_release);
+  }
+  s_sleep.notify_all();
+  for (auto& worker : s_workers) worker->thread.join();
+  s_workers.clear();
+
+  Log::Info("Job system stoppet");
+}
+
+int WorkerCount() {
+  return static_cast<int>(s_workers.size());
+}
+
+namespace {
+  template <typename Deps>
+  Handle SubmitAfter(const char* name, std::function<void()> fn, const Deps& deps) {
+    auto job = std::make_shared<Job>();
+    job->name = name;
+    job->fn = std::move(fn);
+
+    for (const Handle& dep : deps) {
+      if (!dep) continue;
+      std::lock_guard guard(dep->lock);
+      if (dep->done.load(std::memory_order_acquire)) continue;
+      job->waiting.fetch_add(1, std::memory_order_relaxed);
+      dep->continuations.push_back(job);
+    }
+
+    // Den sidste færdige dep (eller Submit selv) lægger jobbet i kø
+    if (job->waiting.fetch_sub(1, std::memory_order_acq_rel) == 1) Schedule(job);
+    return job;
+  }
+}
+
+Handle Submit(const char* name, std::function<void()> fn, std::initializer_list<Handle> deps) {
+  return SubmitAfter(name, std::move(fn), deps);
+}
+
+Handle Submit(const char* name, std::function<void()> fn, const std::vector<Handle>& deps) {
+  return SubmitAfter(name, std::move(fn), deps);
+}
+
+bool IsDone(const Handle& job) {
+  return !job || job->done.load(std::memory_order_acquire);
+}
+
+void Wait(const Handle& job) {
+  while (!IsDone(job)) {
+    if (!TryRunOne()) std::this_thread::yield();
+  }
+}
+
+void WaitAll(const std::vector<Handle>& jobs) {
+  for (const Handle& job : jobs) Wait(job);
+}
+
+void ParallelFor(const char* name, std::size_t count, std::size_t grain,
+                 const std::function<void(std::size_t, std::size_t)>& fn) {
+  if (count == 0) return;
+  grain = std::max<std::size_t>(grain, 1);
+  const std::size_t chunks = (count + grain - 1) / grain;
+  if (chunks == 1 || s_workers.empty()) {
+    TRACE_SCOPE(name, "job");
+    fn(0, count);
+    return;
+  }
+
+  // fn lever til alle bidder er færdige, så den kan fanges som reference
+  std::vector<Handle> jobs;
+  jobs.reserve(chunks - 1);
+  for (std::size_t c = 1; c < chunks; ++c) {
+    const std::size_t begin = c * grain;
+    const std::size_t end = std::min(count, begin + grain);
+    jobs.push_back(Submit(name, [&fn, begin, end] { fn(begin, end); }));
+  }
+
+  {
+    TRACE_SCOPE(name, "job");
+    fn(0, std::min(count, grain));
+  }
+  WaitAll(jobs);
+}
+
+Stats GetStats() {
+  Stats stats;
+  stats.workers = WorkerCount();
+  stats.queued = static_cast<std::size_t>(std::max(0, s_queued.load(std::memory_order_relaxed)));
+
+  auto add = [&](const WorkerStats& w) {
+    stats.jobs += w.jobs;
+    stats.steals += w.steals;
+    stats.busyMs += w.busyMs;
+  };
+  add(ToStats("main", s_external));
+  for (const auto& worker : s_workers) add(ToStats(worker->name, worker->counters));
+  return stats;
+}
+
+WorkerStats Worker(int index) {
+  if (index < 0 || index >= WorkerCount()) return {};
+  return ToStats(s_workers[index]->name, s_workers[index]->counters);
+}
+
+}
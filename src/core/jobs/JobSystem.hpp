@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <vector>
+
+#include "MainThreadScheduler.hpp"
+
+/*
+ * Fælles tråd-pool med work stealing. Hver worker har sin egen kø: jobs der startes fra en
+ * worker lægges bagerst i dens kø og tages derfra igen (varm cache), mens ledige workers
+ * stjæler forfra i de andres. Jobs fra andre tråde (main, save) går i en fælles kø.
+ *
+ * Et job kan vente på andre (deps) - det lægges først i kø når de alle er færdige, så en
+ * graf af jobs kan bygges uden at nogen tråd blokerer. Wait() og ParallelFor() hjælper til
+ * med at køre jobs mens de venter, så de virker også uden workers (Init ikke kaldt).
+ *
+ * SDL renderer kald skal blive på main tråden: RunOnMainThread lægger dem i
+ * MainThreadScheduler, der kører dem inden for et budget per frame.
+ *
+ * Hvert job er et TRACE_SCOPE ("job" kategorien) på workerens tråd i tracen, og hver worker
+ * tæller jobs, stjålne jobs og travl tid (Stats / Worker).
+ */
+namespace Jobs {
+
+  struct Job;
+  using Handle = std::shared_ptr<Job>;
+
+  inline constexpr int MAX_WORKERS = 32;
+
+  /* workers < 0: én per kerne minus main tråden (mindst én) */
+  void Init(int workers = -1);
+  /* Venter på de jobs der kører og stopper workers */
+  void Shutdown();
+  int WorkerCount();
+
+  /* Init/Shutdown for et scope - til programmer med mange return veje (bench) */
+  struct Scope {
+    explicit Scope(int workers = -1) { Init(workers); }
+    ~Scope() { Shutdown(); }
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+  };
+
+  /* name skal leve hele programmet (string literal) - det bruges i tracen */
+  Handle Submit(const char* name, std::function<void()> fn, std::initializer_list<Handle> deps = {});
+  Handle Submit(const char* name, std::function<void()> fn, const std::vector<Handle>& deps);
+
+  bool IsDone(const Handle& job);
+  /* Kører andre jobs indtil job er færdigt */
+  void Wait(const Handle& job);
+  void WaitAll(const std::vector<Handle>& jobs);
+
+  /* fn(begin, end) over [0, count) i bidder af grain - den kaldende tråd tager selv første bid */
+  void ParallelFor(const char* name, std::size_t count, std::size_t grain,
+                   const std::function<void(std::size_t begin, std::size_t end)>& fn);
+
+  /* Fra en hvilken som helst tråd - se MainThreadScheduler */
+  inline void RunOnMainThread(std::function<void()> fn, Priority priority = Priority::Visible, CancelTokenPtr token = nullptr) {
+    MainThreadScheduler::post(std::move(fn), priority, std::move(token));
+  }
+
+  struct WorkerStats {
+    const char* name = nullptr;
+    std::uint64_t jobs = 0;
+    std::uint64_t steals = 0;
+    double busyMs = 0.0;
+  };
+
+  /* Summen over alle tråde der har kørt jobs (også main når den hjælper i Wait) */
+  struct Stats {
+    int workers = 0;
+    std::size_t queued = 0;
+    std::uint64_t jobs = 0;
+    std::uint64_t steals = 0;
+    double busyMs = 0.0;
+  };
+
+  Stats GetStats();
+  WorkerStats Worker(int index);
+
+}
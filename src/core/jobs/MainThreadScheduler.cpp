@@ -0,0 +1,96 @@
+#include "MainThreadScheduler.hpp"
+
+#include <algorithm>
+#include <deque>
+#include <mutex>
+#include <optional>
+
+#include "SDL3/SDL.h"
+#include "logging/Trace.hpp"
+
+namespace Jobs {
+
+namespace {
+  struct Task {
+    std::function<void()> fn;
+    CancelTokenPtr token;
+  };
+
+  constexpr int PRIORITY_COUNT = static_cast<int>(Priority::Count);
+
+  std::mutex s_lock;
+  std::deque<Task> s_queues[PRIORITY_COUNT];
+
+  // Kun main tråden
+  MainThreadScheduler::Stats s_stats;
+
+  std::optional<Task> PopNext() {
+    std::lock_guard guard(s_lock);
+    for (auto& queue : s_queues) {
+      if (queue.empty()) continue;
+      Task task = std::move(queue.front());
+      queue.pop_front();
+      return task;
+    }
+    return std::nullopt;
+  }
+}
+
+void MainThreadScheduler::post(std::function<void()> fn, Priority priority, CancelTokenPtr token) {
+  {
+    std::lock_guard guard(s_lock);
+    s_queues[static_cast<int>(priority)].push_back({ std::move(fn), std::move(token) });
+  }
+
+  // Main loopet kan stå i SDL_WaitEventTimeout - et tomt user event vækker det
+  SDL_Event wake {};
+  wake.type = SDL_EVENT_USER;
+  SDL_PushEvent(&wake);
+}
+
+std::size_t MainThreadScheduler::run(double budgetMs) {
+  s_stats.ranLastFrame = 0;
+  s_stats.usedMsLastFrame = 0.0;
+  if (!hasWork()) return 0;
+
+  TRACE_SCOPE("MainThreadScheduler::run", "job");
+  const Uint64 start = SDL_GetTicksNS();
+  const Uint64 budgetNs = static_cast<Uint64>(budgetMs * 1e6);
+  Uint64 used = 0;
+
+  // Mindst én task per frame, ellers kunne en task der er større end budgettet aldrig køre
+  while (s_stats.ranLastFrame == 0 || used < budgetNs) {
+    std::optional<Task> task = PopNext();
+    if (!task) break;
+    if (task->token && task->token->cancelled()) {
+      ++s_stats.cancelled;
+      continue;
+    }
+
+    task->fn();
+    ++s_stats.ranLastFrame;
+    used = SDL_GetTicksNS() - start;
+  }
+
+  s_stats.usedMsLastFrame = used / 1e6;
+  if (used > budgetNs) {
+    const double overMs = (used - budgetNs) / 1e6;
+    ++s_stats.overruns;
+    s_stats.worstOverrunMs = std::max(s_stats.worstOverrunMs, overMs);
+  }
+  return s_stats.ranLastFrame;
+}
+
+bool MainThreadScheduler::hasWork() {
+  std::lock_guard guard(s_lock);
+  return std::any_of(std::begin(s_queues), std::end(s_queues), [](const auto& queue) { return !queue.empty(); });
+}
+
+MainThreadScheduler::Stats MainThreadScheduler::stats() {
+  Stats stats = s_stats;
+  std::lock_guard guard(s_lock);
+  for (int i = 0; i < PRIORITY_COUNT; ++i) stats.queued[i] = s_queues[i].size();
+  return stats;
+}
+
+}
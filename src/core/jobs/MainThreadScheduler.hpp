@@ -0,0 +1,65 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+
+/*
+ * Arbejde der skal køre på render tråden (texture uploads, render-target bakes som thumbnails)
+ * lægges her fra en hvilken som helst tråd og køres af main loopet mellem editor.run og present,
+ * højst budgetMs per frame - så en bunke af dem bliver til flere frames i stedet for ét hak.
+ *
+ * Visible køres før Prefetch. Tasks kan ikke afbrydes midt i, så mindst én køres per frame,
+ * og går en frame over budgettet tælles det som et overrun. Tasks med et CancelToken droppes
+ * når tokenet annulleres (fx når brugeren skifter scene).
+ */
+namespace Jobs {
+
+enum class Priority : std::uint8_t {
+  Visible,   // det brugeren kigger på nu
+  Prefetch,  // det brugeren nok kigger på snart
+  Count
+};
+
+/* Deles mellem den der bestiller arbejdet og dets tasks - cancel() gælder dem alle */
+class CancelToken {
+  public:
+    static std::shared_ptr<CancelToken> Make() { return std::make_shared<CancelToken>(); }
+
+    void cancel() { cancelled_.store(true, std::memory_order_release); }
+    bool cancelled() const { return cancelled_.load(std::memory_order_acquire); }
+
+  private:
+    std::atomic<bool> cancelled_ { false };
+};
+
+using CancelTokenPtr = std::shared_ptr<CancelToken>;
+
+class MainThreadScheduler {
+  public:
+    static constexpr double DEFAULT_BUDGET_MS = 2.0;
+
+    struct Stats {
+      std::size_t queued[static_cast<int>(Priority::Count)] {};
+      std::size_t ranLastFrame = 0;
+      double usedMsLastFrame = 0.0;
+      std::uint64_t overruns = 0;
+      double worstOverrunMs = 0.0;
+      std::uint64_t cancelled = 0;
+    };
+
+    /* Trådsikker. Vækker main loopet hvis det venter på input */
+    static void post(std::function<void()> fn, Priority priority = Priority::Visible, CancelTokenPtr token = nullptr);
+
+    /* Main tråden, én gang per frame. Returnerer antal tasks der blev kørt */
+    static std::size_t run(double budgetMs = DEFAULT_BUDGET_MS);
+
+    static bool hasWork();
+    static Stats stats();
+
+    MainThreadScheduler() = delete;
+};
+
+}
@@ -40,6 +40,10 @@ class Vec2 {
     return x * other.x + y * other.y;
   }
 
+  constexpr Vec2 lerp(const Vec2& to, T t) const {
+    return Vec2(x + (to.x - x) * t, y + (to.y - y) * t);
+  }
+
   constexpr T length() const {
     return std::sqrt(x * x + y * y);
   }
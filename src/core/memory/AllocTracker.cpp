@@ -0,0 +1,125 @@
+#include "AllocTracker.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+#if defined(_WIN32)
+  #include <malloc.h>
+#endif
+
+namespace Memory {
+
+namespace detail {
+  thread_local AllocCounters t_counters;
+  // Allokeres ofte på én tråd og frigives på en anden (jobs), så dette tal er fælles
+  std::atomic<std::int64_t> g_live { 0 };
+}
+
+namespace {
+  AllocCounters s_frameStart;
+  AllocCounters s_lastFrame;
+  std::uint64_t s_peakFrameAllocs = 0;
+}
+
+void AllocTracker::beginFrame() {
+  s_frameStart = thread();
+}
+
+void AllocTracker::endFrame() {
+  s_lastFrame = thread() - s_frameStart;
+  s_peakFrameAllocs = std::max(s_peakFrameAllocs, s_lastFrame.allocs);
+}
+
+const AllocCounters& AllocTracker::lastFrame() {
+  return s_lastFrame;
+}
+
+std::uint64_t AllocTracker::peakFrameAllocs() {
+  return s_peakFrameAllocs;
+}
+
+void AllocTracker::resetPeak() {
+  s_peakFrameAllocs = 0;
+}
+
+std::int64_t AllocTracker::live() {
+  return detail::g_live.load(std::memory_order_relaxed);
+}
+
+}
+
+#if defined(PIRATE_TRACK_ALLOCATIONS)
+
+// Erstatter de globale operatorer for hele programmet. Alle varianter går gennem de to
+// funktioner herunder, så new/delete par altid bruger samme allokator.
+namespace {
+  // Samme test på begge sider: kun over-alignede blokke kommer fra _aligned_malloc/aligned_alloc
+  bool overAligned(std::size_t align) { return align > alignof(std::max_align_t); }
+
+  void* trackedAlloc(std::size_t size, std::size_t align) {
+    if (size == 0) size = 1;
+    void* p = nullptr;
+    if (overAligned(align)) {
+#if defined(_WIN32)
+      p = _aligned_malloc(size, align);
+#else
+      p = std::aligned_alloc(align, (size + align - 1) / align * align);
+#endif
+    } else {
+      p = std::malloc(size);
+    }
+
+    if (p) {
+      Memory::detail::t_counters.allocs++;
+      Memory::detail::t_counters.bytes += size;
+      Memory::detail::g_live.fetch_add(1, std::memory_order_relaxed);
+    }
+    return p;
+  }
+
+  void trackedFree(void* p, std::size_t align = 0) noexcept {
+    if (!p) return;
+    Memory::detail::t_counters.frees++;
+    Memory::detail::g_live.fetch_sub(1, std::memory_order_relaxed);
+#if defined(_WIN32)
+    if (overAligned(align)) { _aligned_free(p); return; }
+#endif
+    (void)align;
+    std::free(p);
+  }
+}
+
+void* operator new(std::size_t size) {
+  if (void* p = trackedAlloc(size, 0)) return p;
+  throw std::bad_alloc();
+}
+void* operator new[](std::size_t size) {
+  if (void* p = trackedAlloc(size, 0)) return p;
+  throw std::bad_alloc();
+}
+void* operator new(std::size_t size, std::align_val_t align) {
+  if (void* p = trackedAlloc(size, static_cast<std::size_t>(align))) return p;
+  throw std::bad_alloc();
+}
+void* operator new[](std::size_t size, std::align_val_t align) {
+  if (void* p = trackedAlloc(size, static_cast<std::size_t>(align))) return p;
+  throw std::bad_alloc();
+}
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { return trackedAlloc(size, 0); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return trackedAlloc(size, 0); }
+
+void operator delete(void* p) noexcept { trackedFree(p); }
+void operator delete[](void* p) noexcept { trackedFree(p); }
+void operator delete(void* p, std::size_t) noexcept { trackedFree(p); }
+void operator delete[](void* p, std::size_t) noexcept { trackedFree(p); }
+void operator delete(void* p, std::align_val_t align) noexcept { trackedFree(p, static_cast<std::size_t>(align)); }
+void operator delete[](void* p, std::align_val_t align) noexcept { trackedFree(p, static_cast<std::size_t>(align)); }
+void operator delete(void* p, std::size_t, std::align_val_t align) noexcept { trackedFree(p, static_cast<std::size_t>(align)); }
+void operator delete[](void* p, std::size_t, std::align_val_t align) noexcept { trackedFree(p, static_cast<std::size_t>(align)); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { trackedFree(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { trackedFree(p); }
+
+#endif
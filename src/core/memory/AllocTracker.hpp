@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstdint>
+
+/*
+ * Tæller allokeringer gennem global operator new/delete (AllocTracker.cpp erstatter dem).
+ * Hver tråd har sine egne tællere, så main trådens frame tal ikke forstyrres af lyd- eller
+ * loader-tråde. PROFILE_SCOPE tæller også allokeringer per scope (se Profiler).
+ *
+ * SDL's egne allokeringer (SDL_malloc) går uden om og tælles ikke.
+ *
+ * Bygges uden PIRATE_TRACK_ALLOCATIONS er hooks og tællere væk, og alt returnerer 0.
+ */
+namespace Memory {
+
+struct AllocCounters {
+  std::uint64_t allocs = 0;
+  std::uint64_t frees  = 0;
+  std::uint64_t bytes  = 0; // allokerede bytes (frigivne trækkes ikke fra)
+
+  AllocCounters operator-(const AllocCounters& o) const {
+    return { allocs - o.allocs, frees - o.frees, bytes - o.bytes };
+  }
+};
+
+namespace detail {
+  extern thread_local AllocCounters t_counters;
+}
+
+class AllocTracker {
+  public:
+    static constexpr bool enabled() {
+#if defined(PIRATE_TRACK_ALLOCATIONS)
+      return true;
+#else
+      return false;
+#endif
+    }
+
+    /* Den kaldende tråds tællere siden start */
+    static AllocCounters thread() {
+#if defined(PIRATE_TRACK_ALLOCATIONS)
+      return detail::t_counters;
+#else
+      return {};
+#endif
+    }
+
+    /* Kaldes fra main loopet - lastFrame() er main trådens allokeringer i sidste hele frame */
+    static void beginFrame();
+    static void endFrame();
+    static const AllocCounters& lastFrame();
+
+    /* Højeste antal allokeringer i én frame siden resetPeak() */
+    static std::uint64_t peakFrameAllocs();
+    static void resetPeak();
+
+    /* Levende allokeringer (new minus delete) på tværs af alle tråde - til lækage tjek */
+    static std::int64_t live();
+
+    AllocTracker() = delete;
+};
+
+/* Allokeringer på denne tråd siden scopet startede */
+class AllocScope {
+  public:
+    AllocScope() : start(AllocTracker::thread()) {}
+    AllocCounters delta() const { return AllocTracker::thread() - start; }
+  private:
+    AllocCounters start;
+};
+
+}
@@ -0,0 +1,112 @@
+#include "FrameArena.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+namespace Memory {
+
+namespace {
+  constexpr unsigned char POISON = 0xDD;
+
+  class ArenaResource final : public std::pmr::memory_resource {
+    public:
+      std::byte* buffer = nullptr;
+      std::size_t size = 0;
+      std::size_t top = 0;
+      std::size_t highWater = 0;     // højeste top i denne frame - top går ned igen ved LIFO frees
+      std::size_t peak = 0;
+      std::size_t lastFrameUsed = 0;
+      std::size_t overflows = 0;
+
+      bool owns(const void* p) const {
+        const auto* b = static_cast<const std::byte*>(p);
+        return buffer && b >= buffer && b < buffer + size;
+      }
+
+    private:
+      void* do_allocate(std::size_t bytes, std::size_t align) override {
+        const auto base = reinterpret_cast<std::uintptr_t>(buffer);
+        const std::size_t start = ((base + top + align - 1) & ~(static_cast<std::uintptr_t>(align) - 1)) - base;
+
+        if (!buffer || start + bytes > size) {
+          ++overflows;
+          return std::pmr::new_delete_resource()->allocate(bytes, align);
+        }
+
+        top = start + bytes;
+        highWater = std::max(highWater, top);
+        peak = std::max(peak, top);
+        return buffer + start;
+      }
+
+      void do_deallocate(void* p, std::size_t bytes, std::size_t align) override {
+        if (!owns(p)) {
+          std::pmr::new_delete_resource()->deallocate(p, bytes, align);
+          return;
+        }
+
+        // Sidste allokering kan gives tilbage med det samme (typisk en vector der vokser)
+        if (static_cast<std::byte*>(p) + bytes == buffer + top) top -= bytes;
+      }
+
+      bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+      }
+  };
+
+  ArenaResource s_arena;
+}
+
+void FrameArena::init(std::size_t capacity) {
+  if (s_arena.buffer) return;
+  s_arena.buffer = new std::byte[capacity];
+  s_arena.size = capacity;
+  s_arena.top = 0;
+  s_arena.highWater = 0;
+}
+
+void FrameArena::shutdown() {
+  delete[] s_arena.buffer;
+  s_arena.buffer = nullptr;
+  s_arena.size = 0;
+  s_arena.top = 0;
+  s_arena.highWater = 0;
+}
+
+void FrameArena::reset() {
+#if !defined(NDEBUG)
+  // Også det der blev givet tilbage undervejs - det kan der stadig pege noget på
+  if (s_arena.buffer) std::memset(s_arena.buffer, POISON, s_arena.highWater);
+#endif
+  s_arena.lastFrameUsed = s_arena.highWater;
+  s_arena.top = 0;
+  s_arena.highWater = 0;
+}
+
+std::pmr::memory_resource* FrameArena::resource() {
+  if (!s_arena.buffer) init();
+  return &s_arena;
+}
+
+std::size_t FrameArena::used() {
+  return s_arena.top;
+}
+
+std::size_t FrameArena::capacity() {
+  return s_arena.size;
+}
+
+std::size_t FrameArena::lastFrameUsed() {
+  return s_arena.lastFrameUsed;
+}
+
+std::size_t FrameArena::peak() {
+  return s_arena.peak;
+}
+
+std::size_t FrameArena::overflows() {
+  return s_arena.overflows;
+}
+
+}
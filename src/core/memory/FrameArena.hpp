@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstddef>
+#include <memory_resource>
+#include <vector>
+
+/*
+ * Bump-pointer arena til data der kun lever i én frame (cellelister, rects til batching osv).
+ * Nulstilles øverst i main loopet, så alt allokeret herfra er ugyldigt i næste frame.
+ * Bruges gennem std::pmr containere:
+ *
+ *   Memory::FrameVector<SDL_FRect> rects = Memory::FrameArena::vector<SDL_FRect>();
+ *
+ * Kun main tråden. Løber arenaen tør falder den tilbage til heapen (tælles som overflow og
+ * ses i allokeringstællerne). Debug builds fylder brugt hukommelse med 0xDD ved reset, så
+ * brug efter reset giver tydeligt skrald i stedet for gamle værdier.
+ */
+namespace Memory {
+
+template<typename T>
+using FrameVector = std::pmr::vector<T>;
+
+class FrameArena {
+  public:
+    static constexpr std::size_t DEFAULT_CAPACITY = 512 * 1024;
+
+    /* Allokerer bufferen - kaldes én gang ved opstart (ellers sker det ved første brug) */
+    static void init(std::size_t capacity = DEFAULT_CAPACITY);
+    static void shutdown();
+
+    /* Starter en ny frame - alt fra sidste frame frigives på én gang */
+    static void reset();
+
+    static std::pmr::memory_resource* resource();
+
+    template<typename T>
+    static FrameVector<T> vector() { return FrameVector<T>(resource()); }
+
+    static std::size_t used();
+    static std::size_t capacity();
+    static std::size_t lastFrameUsed(); // højeste forbrug i sidste frame, ikke hvad der stod ved reset
+    static std::size_t peak();
+    static std::size_t overflows(); // allokeringer der ikke kunne være i arenaen siden start
+
+    FrameArena() = delete;
+};
+
+}
@@ -0,0 +1,192 @@
+#include "Profiler.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace Profiling {
+
+namespace {
+  struct Node {
+    const char* name = nullptr;
+    int parent = -1;
+    int depth = 0;
+  };
+
+  // Opdater statistikken et par gange i sekundet i stedet for hver frame
+  constexpr int REPORT_INTERVAL = 30;
+
+  std::array<Node, Profiler::MAX_SCOPES> s_nodes;
+  int s_nodeCount = 0;
+
+  std::array<int, Profiler::MAX_DEPTH> s_stack;
+  int s_stackDepth = 0;
+
+  std::array<Uint64, Profiler::MAX_SCOPES> s_current {};
+  std::array<std::array<Uint64, Profiler::MAX_SCOPES>, Profiler::FRAME_HISTORY> s_history {};
+  std::array<Uint64, Profiler::FRAME_HISTORY> s_frameHistory {};
+
+  // Allokeringer per scope og per frame (main tråden), samme ringbuffer som tiderne
+  std::array<std::uint32_t, Profiler::MAX_SCOPES> s_currentAllocs {};
+  std::array<std::array<std::uint32_t, Profiler::MAX_SCOPES>, Profiler::FRAME_HISTORY> s_allocHistory {};
+  std::array<std::uint32_t, Profiler::FRAME_HISTORY> s_frameAllocHistory {};
+  int s_head = 0;
+  int s_filled = 0;
+
+  Uint64 s_frameStart = 0;
+  Uint64 s_frequency = 1;
+  int s_framesSinceReport = 0;
+
+  Profiler::FrameReport s_report;
+
+  thread_local bool t_isMainThread = false;
+
+  double percentile(std::array<Uint64, Profiler::FRAME_HISTORY>& scratch, int count, double p) {
+    if (count <= 0) return 0.0;
+    int idx = std::clamp(static_cast<int>(p * (count - 1) + 0.5), 0, count - 1);
+    std::nth_element(scratch.begin(), scratch.begin() + idx, scratch.begin() + count);
+    return Profiler::ticksToMs(scratch[idx]);
+  }
+}
+
+void Profiler::init() {
+  t_isMainThread = true;
+  s_frequency = SDL_GetPerformanceFrequency();
+  if (s_frequency == 0) s_frequency = 1;
+  s_frameStart = SDL_GetPerformanceCounter();
+}
+
+bool Profiler::onMainThread() {
+  return t_isMainThread;
+}
+
+double Profiler::ticksToMs(Uint64 ticks) {
+  return static_cast<double>(ticks) * 1000.0 / static_cast<double>(s_frequency);
+}
+
+void Profiler::beginFrame() {
+  s_current.fill(0);
+  s_currentAllocs.fill(0);
+  s_stackDepth = 0;
+  Memory::AllocTracker::beginFrame();
+}
+
+void Profiler::endFrame() {
+  const Uint64 now = SDL_GetPerformanceCounter();
+  Memory::AllocTracker::endFrame();
+  s_frameHistory[s_head] = now - s_frameStart;
+  s_history[s_head] = s_current;
+  s_allocHistory[s_head] = s_currentAllocs;
+  s_frameAllocHistory[s_head] = static_cast<std::uint32_t>(Memory::AllocTracker::lastFrame().allocs);
+  s_frameStart = now;
+
+  s_head = (s_head + 1) % FRAME_HISTORY;
+  s_filled = std::min(s_filled + 1, FRAME_HISTORY);
+
+  if (++s_framesSinceReport >= REPORT_INTERVAL) {
+    s_framesSinceReport = 0;
+    rebuildReport();
+  }
+}
+
+int Profiler::beginScope(const char* name) {
+  if (!t_isMainThread || s_stackDepth >= MAX_DEPTH) return -1;
+
+  const int parent = s_stackDepth > 0 ? s_stack[s_stackDepth - 1] : -1;
+
+  // Samme navn under samme forælder er samme node (navne er string literals)
+  int node = -1;
+  for (int i = 0; i < s_nodeCount; ++i) {
+    if (s_nodes[i].parent == parent && (s_nodes[i].name == name || std::strcmp(s_nodes[i].name, name) == 0)) {
+      node = i;
+      break;
+    }
+  }
+
+  if (node < 0) {
+    if (s_nodeCount >= MAX_SCOPES) return -1;
+    node = s_nodeCount++;
+    s_nodes[node] = { name, parent, s_stackDepth };
+  }
+
+  s_stack[s_stackDepth++] = node;
+  return node;
+}
+
+void Profiler::endScope(int node, Uint64 startTicks, Uint64 endTicks, std::uint64_t allocs) {
+  s_current[node] += endTicks - startTicks;
+  s_currentAllocs[node] += static_cast<std::uint32_t>(allocs);
+  if (s_stackDepth > 0) --s_stackDepth;
+}
+
+const Profiler::FrameReport& Profiler::report() {
+  return s_report;
+}
+
+double Profiler::lastFrameMs() {
+  if (s_filled == 0) return 0.0;
+  return ticksToMs(s_frameHistory[(s_head - 1 + FRAME_HISTORY) % FRAME_HISTORY]);
+}
+
+int Profiler::frameTimes(std::array<float, FRAME_HISTORY>& out) {
+  const int start = (s_head - s_filled + FRAME_HISTORY) % FRAME_HISTORY;
+  for (int i = 0; i < s_filled; ++i) {
+    out[i] = static_cast<float>(ticksToMs(s_frameHistory[(start + i) % FRAME_HISTORY]));
+  }
+  return s_filled;
+}
+
+void Profiler::rebuildReport() {
+  std::array<Uint64, FRAME_HISTORY> scratch;
+  const int count = s_filled;
+
+  // Hele frames
+  Uint64 sum = 0, maxTicks = 0, allocSum = 0;
+  for (int i = 0; i < count; ++i) {
+    scratch[i] = s_frameHistory[i];
+    sum += scratch[i];
+    maxTicks = std::max(maxTicks, scratch[i]);
+    allocSum += s_frameAllocHistory[i];
+  }
+  s_report.avgMs = count > 0 ? ticksToMs(sum) / count : 0.0;
+  s_report.allocs = count > 0 ? static_cast<double>(allocSum) / count : 0.0;
+  s_report.maxMs = ticksToMs(maxTicks);
+  s_report.p95Ms = percentile(scratch, count, 0.95);
+  s_report.p99Ms = percentile(scratch, count, 0.99);
+
+  // Scopes i dybde-først rækkefølge, så overlayet kan vise træet med indrykning
+  std::array<int, MAX_SCOPES> order;
+  int orderCount = 0;
+  std::array<int, MAX_SCOPES> todo;
+  int todoCount = 0;
+  for (int i = s_nodeCount - 1; i >= 0; --i) {
+    if (s_nodes[i].parent == -1) todo[todoCount++] = i;
+  }
+  while (todoCount > 0) {
+    const int n = todo[--todoCount];
+    order[orderCount++] = n;
+    for (int c = s_nodeCount - 1; c >= 0; --c) {
+      if (s_nodes[c].parent == n) todo[todoCount++] = c;
+    }
+  }
+
+  s_report.scopeCount = orderCount;
+  for (int i = 0; i < orderCount; ++i) {
+    const int n = order[i];
+    Uint64 scopeSum = 0, scopeAllocs = 0;
+    for (int f = 0; f < count; ++f) {
+      scratch[f] = s_history[f][n];
+      scopeSum += scratch[f];
+      scopeAllocs += s_allocHistory[f][n];
+    }
+
+    ScopeReport& r = s_report.scopes[i];
+    r.name  = s_nodes[n].name;
+    r.depth = s_nodes[n].depth;
+    r.avgMs = count > 0 ? ticksToMs(scopeSum) / count : 0.0;
+    r.p95Ms = percentile(scratch, count, 0.95);
+    r.p99Ms = percentile(scratch, count, 0.99);
+    r.allocs = count > 0 ? static_cast<double>(scopeAllocs) / count : 0.0;
+  }
+}
+
+}
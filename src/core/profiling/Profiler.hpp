@@ -0,0 +1,112 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <SDL3/SDL.h>
+
+#include "SDL3/SDL_timer.h"
+#include "logging/Trace.hpp"
+#include "memory/AllocTracker.hpp"
+
+/*
+ * Hierarkisk CPU profiler. PROFILE_SCOPE("navn") måler tiden til slutningen af
+ * scopet med SDL_GetPerformanceCounter. Scopes under hinanden bliver til et træ,
+ * og hver frame gemmes i en ringbuffer, så overlayet kan vise gennemsnit, p95 og p99.
+ *
+ * Optages der en trace (Log::Trace) kommer hvert scope også med der. Med
+ * PIRATE_TRACK_ALLOCATIONS tæller hvert scope også allokeringer (Memory::AllocTracker).
+ *
+ * Bygges uden PIRATE_PROFILING forsvinder alle timers helt.
+ */
+namespace Profiling {
+
+class Profiler {
+  public:
+    static constexpr int MAX_SCOPES    = 64;
+    static constexpr int MAX_DEPTH     = 16;
+    static constexpr int FRAME_HISTORY = 240;
+
+    struct ScopeReport {
+      const char* name = nullptr;
+      int depth = 0;
+      double avgMs = 0.0;
+      double p95Ms = 0.0;
+      double p99Ms = 0.0;
+      double allocs = 0.0; // gennemsnit per frame
+    };
+
+    struct FrameReport {
+      double avgMs = 0.0;
+      double p95Ms = 0.0;
+      double p99Ms = 0.0;
+      double maxMs = 0.0;
+      double allocs = 0.0;
+      int scopeCount = 0;
+      std::array<ScopeReport, MAX_SCOPES> scopes {};
+    };
+
+    /* Kaldes fra main tråden - scopes fra andre tråde ignoreres */
+    static void init();
+    static void beginFrame();
+    static void endFrame();
+
+    static int  beginScope(const char* name);
+    static void endScope(int node, Uint64 startTicks, Uint64 endTicks, std::uint64_t allocs = 0);
+
+    static bool onMainThread();
+
+    /* Statistik over de sidste FRAME_HISTORY frames (scopes i træ-rækkefølge) */
+    static const FrameReport& report();
+
+    /* Frame tider i ms, ældste først. Returnerer antal gyldige værdier */
+    static int frameTimes(std::array<float, FRAME_HISTORY>& out);
+    static double lastFrameMs();
+
+    static double ticksToMs(Uint64 ticks);
+    static constexpr bool enabled() {
+#if defined(PIRATE_PROFILING)
+      return true;
+#else
+      return false;
+#endif
+    }
+
+    Profiler() = delete;
+  private:
+    static void rebuildReport();
+};
+
+class ScopedTimer {
+  public:
+    explicit ScopedTimer(const char* name)
+      : name(name)
+      , node(Profiler::beginScope(name))
+      , start(node >= 0 ? SDL_GetPerformanceCounter() : 0)
+      , startAllocs(Memory::AllocTracker::thread().allocs) {}
+
+    ~ScopedTimer() {
+      if (node < 0) return;
+      const Uint64 end = SDL_GetPerformanceCounter();
+      Profiler::endScope(node, start, end, Memory::AllocTracker::thread().allocs - startAllocs);
+      Log::Trace::Complete(name, "profile", start, end);
+    }
+
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+  private:
+    const char* name;
+    int node;
+    Uint64 start;
+    std::uint64_t startAllocs;
+};
+
+}
+
+#define PIRATE_PROFILE_CONCAT_(a, b) a##b
+#define PIRATE_PROFILE_CONCAT(a, b) PIRATE_PROFILE_CONCAT_(a, b)
+
+#if defined(PIRATE_PROFILING)
+  #define PROFILE_SCOPE(name) ::Profiling::ScopedTimer PIRATE_PROFILE_CONCAT(profileScope_, __LINE__)(name)
+#else
+  #define PROFILE_SCOPE(name) ((void)0)
+#endif
@@ -15,7 +15,7 @@ bool ResourceManager::init(SDL_Renderer* renderer) {
 
 [[nodiscard]] SDL_Texture* ResourceManager::loadTexture(const std::string& path) {
   if(!s_renderer) {
-    Log::Critical("ResourceManager er ikke initialiseret!");
+    Log::Critical(Log::Category::Resources, "ResourceManager er ikke initialiseret!");
     return nullptr;
   }
 
@@ -24,9 +24,11 @@ bool ResourceManager::init(SDL_Renderer* renderer) {
     return it->second; // Denne texture er allerede loadet
   }
 
+  TRACE_SCOPE_DETAIL("loadTexture", "resources", path);
+
   SDL_Surface* surface = IMG_Load(path.c_str());
   if(!surface) {
-    Log::Critical("Kunne ikke indlæse billedet: {}", path.c_str());
+    Log::Critical(Log::Category::Resources, "Kunne ikke indlæse billedet: {}", path.c_str());
     return nullptr;
   }
 
@@ -34,11 +36,11 @@ bool ResourceManager::init(SDL_Renderer* renderer) {
   SDL_DestroySurface(surface);
 
   if(!tex) {
-    Log::Critical("Kunne ikke oprette texture fra surface: {}", path.c_str());
+    Log::Critical(Log::Category::Resources, "Kunne ikke oprette texture fra surface: {}", path.c_str());
     return nullptr;
   }
 
-  Log::Info("Indlæste resource: {}", path.c_str());
+  Log::Debug(Log::Category::Resources, "Indlæste resource: {}", path.c_str());
   s_textures[path] = tex;
   return tex;
 }
@@ -46,7 +48,7 @@ bool ResourceManager::init(SDL_Renderer* renderer) {
 SDL_Texture* ResourceManager::loadTileMap(const std::string& path) {
   SDL_Texture* mapTex = loadTexture(path);
   if(!mapTex) {
-    Log::Critical("Kunne ikke indlæse tilemap: {}", path.c_str());
+    Log::Critical(Log::Category::Resources, "Kunne ikke indlæse tilemap: {}", path.c_str());
     return nullptr;
   }
 
@@ -70,7 +72,7 @@ Animation* ResourceManager::getAnimation(const std::string &animID) {
 
 void ResourceManager::clear() {
   for(auto &kv : s_textures) {
-    Log::Info("Slettede resource: {}", kv.first.c_str());
+    Log::Debug(Log::Category::Resources, "Slettede resource: {}", kv.first.c_str());
     SDL_DestroyTexture(kv.second);
   }
 
@@ -88,21 +90,21 @@ void ResourceManager::update(float deltaTime) {
 Animation::Animation(const std::string& animID, const std::filesystem::path& folderPath) {
   std::vector<std::filesystem::path> files = Utils::getAnimationFiles(folderPath);
   if(files.size() == 0) {
-    Log::Error("Kunne ikke oprette animationen \"{}\" ({})", animID, folderPath.string());
+    Log::Error(Log::Category::Resources, "Kunne ikke oprette animationen \"{}\" ({})", animID, folderPath.string());
     return;
   }
 
   for(const auto& file : files) {
     SDL_Texture* tex = ResourceManager::loadTexture(file);
     if(!tex) {
-      Log::Critical("Kunne ikke fuldføre animationen \"{}\", problem med filen \"{}\"", animID, file.string());
+      Log::Critical(Log::Category::Resources, "Kunne ikke fuldføre animationen \"{}\", problem med filen \"{}\"", animID, file.string());
       return;
     }
 
     textures.push_back(ResourceManager::loadTexture(file));
   }
 
-  Log::Info("Indlæste alle textures for animation \"{}\"", animID);
+  Log::Debug(Log::Category::Resources, "Indlæste alle textures for animation \"{}\"", animID);
 }
 
 void Animation::tick(float deltaTime) {
@@ -113,7 +115,7 @@ void Animation::tick(float deltaTime) {
 }
 
 void Animation::draw(SDL_Renderer* renderer, SDL_FRect* srcRect, SDL_FRect* destRect) {
-  SDL_RenderTexture(renderer, textures[(int) current_frame], srcRect, destRect);
+  Render::Texture(renderer, textures[(int) current_frame], srcRect, destRect);
 }
 
 float Animation::getCurrentFrame() const {
@@ -11,6 +11,8 @@
 
 #include "SDL3_ttf/SDL_ttf.h"
 #include "logging/Logger.hpp"
+#include "logging/Trace.hpp"
+#include "sdl/Render.hpp"
 
 const int TILE_SIZE = 64;
 class Animation {
@@ -47,6 +49,9 @@ class ResourceManager {
     static Animation* loadAnimation(const std::string& animID, const std::filesystem::path& folderPath);
     static Animation* getAnimation(const std::string& animID);
 
+    /* Antal indlæste textures - til bench --dialog-check */
+    static size_t textureCount() { return s_textures.size(); }
+
     // Clear alle resources
     static void clear();
 
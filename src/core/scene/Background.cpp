@@ -11,35 +11,38 @@ static const fs::path CLOUDS[3] = {
     fs::path("resources/decoration/clouds/3.png")
 };
 
-Cloud::Cloud(Vec2<float> position) {
-  // Random cloud texture
-  int random = rand() % 3;
-  this->cloud_texture = ResourceManager::loadTexture(CLOUDS[random]);
+Cloud::Cloud(Vec2<float> position, SDL_Texture* texture) {
+  this->cloud_texture = texture;
 
   if(this->cloud_texture == nullptr) {
-    Log::Error("Kunne ikke indlæse sky ved position ({}, {})", position.x, position.y);
+    Log::Error(Log::Category::Render, "Kunne ikke indlæse sky ved position ({}, {})", position.x, position.y);
     return;
   }
 
     this->position = position;
+    this->prevPosition = position;
     this->cloud_rect = {position.x, position.y, (float)cloud_texture->w, (float)cloud_texture->h};
-    Log::Info("Oprettet sky ved ({}, {})", position.x, position.y);
+    Log::Debug(Log::Category::Render, "Oprettet sky ved ({}, {})", position.x, position.y);
 }
 
-void Cloud::update(float deltaTime) {
+void Cloud::step(float dt) {
   if(active) {
-    this->position.x -= deltaTime * 100;
+    this->prevPosition = this->position;
+    this->position.x -= dt * 100;
     if(this->position.x < -cloud_texture->w) {
       this->active = false;
-      Log::Info("Sky ved ({}, {}) blev fjernet", position.x, position.y);
+      Log::Debug(Log::Category::Render, "Sky ved ({}, {}) blev fjernet", position.x, position.y);
     }
-    this->cloud_rect.x = this->position.x;
   }
 }
 
+void Cloud::interpolate(float alpha) {
+  this->cloud_rect.x = prevPosition.lerp(position, alpha).x;
+}
+
 void Cloud::render(SDL_Renderer *renderer) const{
   if(active)
-    SDL_RenderTexture(renderer, cloud_texture, nullptr, &cloud_rect);
+    Render::Texture(renderer, cloud_texture, nullptr, &cloud_rect);
 }
 
 bool Cloud::isActive() const {
@@ -62,6 +65,8 @@ static const fs::path SKY_MIDDLE_PATH = fs::path("resources/decoration/sky/sky_m
 static const fs::path SKY_TOP_PATH = fs::path("resources/decoration/sky/sky_top.png");
 static const int WINDOW_WIDTH = 1280;
 static const int WINDOW_HEIGHT = 800;
+// En sky lever ~(vinduesbredde / 100) sekunder og der kommer én hvert 5. sekund
+static const size_t MAX_CLOUDS = 16;
 bool Background::init() {
   Log::Info("Initialiserer baggrund");
   sky_bottom = ResourceManager::loadTexture(SKY_BOTTOM_PATH);
@@ -73,6 +78,12 @@ bool Background::init() {
     return false;
   }
 
+  // Sky textures slås op én gang - spawnCloud må ikke lave path->string kopier midt i en frame
+  for(size_t i = 0; i < cloud_textures.size(); ++i) {
+    cloud_textures[i] = ResourceManager::loadTexture(CLOUDS[i].string());
+  }
+  clouds.reserve(MAX_CLOUDS);
+
   sky_top_rect = {0, 0, (float)WINDOW_WIDTH, 200};
   sky_middle_rect = {0, 200, (float)WINDOW_WIDTH, 400};
   sky_bottom_rect = {0, 600, (float)WINDOW_WIDTH, 200};
@@ -80,28 +91,26 @@ bool Background::init() {
 }
 
 void Background::spawnCloud(Vec2<float> position) {
-  clouds.emplace_back(Cloud(position));
+  // Random cloud texture
+  const int random = rand() % 3;
+  if(clouds.size() >= MAX_CLOUDS) return;
+  clouds.emplace_back(position, cloud_textures[random]);
 }
 
 static const float CLOUD_SPAWN_INTERVAL = 5.0f;
-void Background::update(SDL_State& state) noexcept {
+void Background::fixedUpdate(SDL_State& state, float dt) noexcept {
   if(cloudTimer >= CLOUD_SPAWN_INTERVAL) {
     spawnCloud({state.windowWidth, static_cast<float>(rand()) / RAND_MAX * (state.windowHeight - 650)});
     cloudTimer = 0.0f;
   }
 
-  cloudTimer += state.deltaTime;
+  cloudTimer += dt;
 
   // Opdater skyer
   for(auto& cloud : clouds) {
-    cloud.update(state.deltaTime);
+    cloud.step(dt);
   }
 
-  // Opdater rects ud fra state->windowWidth og height
-  sky_top_rect = {0, 0, state.windowWidth, state.windowHeight * 0.25f};
-  sky_middle_rect = {0, state.windowHeight * 0.25f, state.windowWidth, state.windowHeight * 0.5f};
-  sky_bottom_rect = {0, state.windowHeight * 0.75f, state.windowWidth, state.windowHeight * 0.25f};
-
   // Fjern inaktive skyer
   clouds.erase(
       std::remove_if(clouds.begin(), clouds.end(),
@@ -110,16 +119,37 @@ void Background::update(SDL_State& state) noexcept {
   );
 }
 
+// Skyerne flytter sig langsomt (100 px/s), så uden input er 30 Hz nok til dem
+static const int CLOUD_IDLE_HZ = 30;
+int Background::idleWakeMs() const {
+  if(!clouds.empty()) return 1000 / CLOUD_IDLE_HZ;
+  return static_cast<int>(std::ceil(std::max(0.0f, CLOUD_SPAWN_INTERVAL - cloudTimer) * 1000.0f));
+}
+
+void Background::update(SDL_State& state) noexcept {
+  PROFILE_SCOPE("Background::update");
+  for(auto& cloud : clouds) {
+    cloud.interpolate(state.stepAlpha);
+  }
+
+  // Opdater rects ud fra state->windowWidth og height
+  sky_top_rect = {0, 0, state.windowWidth, state.windowHeight * 0.25f};
+  sky_middle_rect = {0, state.windowHeight * 0.25f, state.windowWidth, state.windowHeight * 0.5f};
+  sky_bottom_rect = {0, state.windowHeight * 0.75f, state.windowWidth, state.windowHeight * 0.25f};
+}
+
 void Background::render(SDL_Renderer *renderer) const {
+    PROFILE_SCOPE("Background::render");
+    Render::SubsystemScope renderScope(Render::Subsystem::Background);
     // Render background
     // Render top
-    SDL_RenderTexture(renderer, sky_top, nullptr, &sky_top_rect);
+    Render::Texture(renderer, sky_top, nullptr, &sky_top_rect);
 
     // Render middle
-    SDL_RenderTexture(renderer, sky_middle, nullptr, &sky_middle_rect);
+    Render::Texture(renderer, sky_middle, nullptr, &sky_middle_rect);
 
     // Render bottom
-    SDL_RenderTexture(renderer, sky_bottom, nullptr, &sky_bottom_rect);
+    Render::Texture(renderer, sky_bottom, nullptr, &sky_bottom_rect);
 
     // Render clouds
     for(const auto& cloud : clouds) {
@@ -1,16 +1,19 @@
 #pragma once
 
+#include <array>
+
 #include "SDL3/SDL_rect.h"
 #include "SDL3/SDL_video.h"
 #include "SDL3/SDL_render.h"
 #include "logging/Logger.hpp"
 #include "sdl/SDL_Handler.hpp"
 #include "resources/ResourceManager.hpp"
+#include "profiling/Profiler.hpp"
 
 
 class Cloud {
 public:
-    Cloud(Vec2<float> position);
+    Cloud(Vec2<float> position, SDL_Texture* texture);
 
     // Tillad flytning
     Cloud(Cloud&&) noexcept = default;
@@ -20,11 +23,13 @@ public:
     Cloud(const Cloud&) = delete;
     Cloud& operator=(const Cloud&) = delete;
 
-    void update(float deltaTime);
+    void step(float dt);
+    void interpolate(float alpha);
     void render(SDL_Renderer* renderer) const;
     bool isActive() const;
 private:
     Vec2<float> position;
+    Vec2<float> prevPosition;
     SDL_Texture* cloud_texture;
     SDL_FRect cloud_rect;
     bool active = true;
@@ -35,9 +40,16 @@ class Background {
 public:
     Background();
 
+    /* Simulation i faste skridt (skyer bevæger sig og spawner) */
+    void fixedUpdate(SDL_State& state, float dt) noexcept;
+    /* Én gang per frame: rects ud fra vinduet og skyer interpoleret med state.stepAlpha */
     void update(SDL_State& state) noexcept;
     void render(SDL_Renderer* renderer) const;
     void spawnCloud(Vec2<float> position);
+
+    /* Hvornår baggrunden ændrer sig næste gang (ms): skyer i bevægelse eller næste spawn */
+    int idleWakeMs() const;
+    bool hasClouds() const { return !clouds.empty(); }
 private:
     float cloudTimer = 3.5f;
     std::vector<Cloud> clouds;
@@ -48,5 +60,6 @@ private:
     SDL_Texture* sky_top;
     SDL_Texture* sky_middle;
     SDL_Texture* sky_bottom;
+    std::array<SDL_Texture*, 3> cloud_textures {};
     bool init();
 };
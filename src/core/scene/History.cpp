@@ -0,0 +1,161 @@
+#include "History.hpp"
+
+#include <algorithm>
+#include <tuple>
+
+#include "Scene.hpp"
+#include "logging/Logger.hpp"
+
+namespace Scene {
+
+void History::setMemoryCap(std::size_t bytes) {
+  memoryCap_ = bytes;
+  enforceCap();
+}
+
+void History::record(const std::vector<CellDelta>& deltas) {
+  if (deltas.empty()) return;
+
+  if (strokeDepth_ > 0) {
+    // Et langt strøg tæller med i loftet mens det samles, ikke først når det afsluttes
+    const std::size_t before = strokeBytes();
+    stroke_.insert(stroke_.end(), deltas.begin(), deltas.end());
+    memoryUsed_ += strokeBytes() - before;
+    enforceCap();
+    return;
+  }
+
+  std::vector<CellDelta> copy = deltas;
+  push(Encode(copy));
+}
+
+void History::beginStroke() {
+  ++strokeDepth_;
+}
+
+void History::endStroke() {
+  if (strokeDepth_ == 0 || --strokeDepth_ > 0) return;
+
+  memoryUsed_ -= strokeBytes();
+  Command command = Encode(stroke_);
+  std::vector<CellDelta>().swap(stroke_);
+  push(std::move(command));
+}
+
+std::size_t History::undo(Manager& manager) {
+  // Strøget ejes af den der åbnede det - undo/redo venter til det er afsluttet
+  if (strokeDepth_ > 0 || undo_.empty()) return 0;
+
+  Command command = std::move(undo_.back());
+  undo_.pop_back();
+  const std::size_t cells = Apply(manager, command, false);
+  redo_.push_back(std::move(command));
+  return cells;
+}
+
+std::size_t History::redo(Manager& manager) {
+  if (strokeDepth_ > 0 || redo_.empty()) return 0;
+
+  Command command = std::move(redo_.back());
+  redo_.pop_back();
+  const std::size_t cells = Apply(manager, command, true);
+  undo_.push_back(std::move(command));
+  return cells;
+}
+
+void History::clear() {
+  undo_.clear();
+  redo_.clear();
+  // Et åbent strøg forbliver åbent (det lukkes af den der åbnede det) - kun indholdet smides væk
+  std::vector<CellDelta>().swap(stroke_);
+  memoryUsed_ = 0;
+}
+
+History::Command History::Encode(std::vector<CellDelta>& deltas) {
+  // Terrain index bestemmes af autotile - kun om cellen har terrain er interessant
+  for (CellDelta& d : deltas) {
+    if (d.type != TILE_TYPE_TERRAIN) continue;
+    d.before = d.before < 0 ? -1 : 0;
+    d.after  = d.after  < 0 ? -1 : 0;
+  }
+
+  // Samme celle og type flere gange (et strøg, eller en flytning hvor cellen både tømmes og fyldes)
+  // foldes til første før og sidste efter. Stabil sortering bevarer rækkefølgen inden for cellen
+  std::stable_sort(deltas.begin(), deltas.end(), [](const CellDelta& a, const CellDelta& b) {
+    return std::tie(a.type, a.y, a.x) < std::tie(b.type, b.y, b.x);
+  });
+
+  Command command;
+  for (size_t i = 0; i < deltas.size();) {
+    const CellDelta& first = deltas[i];
+    size_t j = i + 1;
+    while (j < deltas.size() && deltas[j].type == first.type && deltas[j].x == first.x && deltas[j].y == first.y) ++j;
+    const int before = first.before;
+    const int after = deltas[j - 1].after;
+    const int x = first.x;
+    const int y = first.y;
+    const TileType type = first.type;
+    i = j;
+    if (before == after) continue;
+
+    ++command.cells;
+    if (!command.runs.empty()) {
+      Run& last = command.runs.back();
+      if (last.y == y && last.x + last.length == x && last.type == type &&
+          last.before == before && last.after == after && last.length < UINT16_MAX) {
+        ++last.length;
+        continue;
+      }
+    }
+    command.runs.push_back({ x, y, 1, static_cast<std::uint8_t>(type),
+                             static_cast<std::int16_t>(before), static_cast<std::int16_t>(after) });
+  }
+
+  command.runs.shrink_to_fit();
+  return command;
+}
+
+std::size_t History::Apply(Manager& manager, const Command& command, bool forward) {
+  PROFILE_SCOPE("History::Apply");
+  ChangeSet changes;
+  for (const Run& run : command.runs) {
+    const TileType type = static_cast<TileType>(run.type);
+    const int value = forward ? run.after : run.before;
+    for (int i = 0; i < run.length; ++i) {
+      if (value < 0) changes.removals.push_back({ run.x + i, run.y, type, 0 });
+      else           changes.placements.push_back({ run.x + i, run.y, type, value });
+    }
+  }
+
+  // Uden om historikken - en undo skal ikke selv optages som en ny kommando
+  manager.applyFromHistory(changes);
+  return command.cells;
+}
+
+void History::push(Command command) {
+  if (command.cells == 0) return;
+
+  for (const Command& c : redo_) memoryUsed_ -= c.bytes();
+  redo_.clear();
+
+  memoryUsed_ += command.bytes();
+  undo_.push_back(std::move(command));
+  enforceCap();
+}
+
+void History::enforceCap() {
+  while (memoryUsed_ > memoryCap_ && !redo_.empty()) {
+    memoryUsed_ -= redo_.front().bytes();
+    redo_.pop_front();
+  }
+  // Den nyeste kommando beholdes altid, ellers kunne en stor fill aldrig fortrydes
+  while (memoryUsed_ > memoryCap_ && undo_.size() > 1) {
+    memoryUsed_ -= undo_.front().bytes();
+    undo_.pop_front();
+  }
+  if (memoryUsed_ > memoryCap_) {
+    Log::Debug(Log::Category::Scene, "Undo historik over loftet ({} > {} bytes) med én kommando", memoryUsed_, memoryCap_);
+  }
+}
+
+}
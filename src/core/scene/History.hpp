@@ -0,0 +1,95 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+#include "tiles/TileManager.hpp"
+
+namespace Scene {
+
+class Manager;
+
+/* Én celles ændring for én type: tileset index før og efter (-1 = ingen tile) */
+struct CellDelta {
+  int x = 0;
+  int y = 0;
+  TileType type = TILE_TYPE_TERRAIN;
+  int before = -1;
+  int after = -1;
+};
+
+/*
+ * Undo/redo af scene mutationer. Manager melder hver ChangeSet (og enkelt-celle operationerne)
+ * ind som deltas, der foldes per celle og pakkes i runs af vandrette naboceller med samme type
+ * og før/efter index - en fyldt 50k rect fylder få hundrede runs. Terrain gemmes kun som
+ * til stede/ikke til stede, da autotile genberegner index (og dermed naboernes ændringer).
+ *
+ * Undo og redo anvendes som én samlet ChangeSet. Et strøg (beginStroke/endStroke) samler
+ * alle ændringer imens til én kommando - undo og redo gør intet mens et strøg er åbent.
+ * Historikken (inklusive det åbne strøg) holdes under memoryCap ved at smide de ældste
+ * kommandoer væk.
+ */
+class History {
+  public:
+    static constexpr std::size_t DEFAULT_MEMORY_CAP = 8 * 1024 * 1024;
+
+    explicit History(std::size_t memoryCap = DEFAULT_MEMORY_CAP) : memoryCap_(memoryCap) {}
+
+    void setMemoryCap(std::size_t bytes);
+    std::size_t memoryCap() const { return memoryCap_; }
+    std::size_t memoryUsed() const { return memoryUsed_; }
+
+    /* Kaldes af Manager for hver mutation - uden for et strøg bliver det én kommando */
+    void record(const std::vector<CellDelta>& deltas);
+
+    void beginStroke();
+    void endStroke();
+    bool inStroke() const { return strokeDepth_ > 0; }
+
+    bool canUndo() const { return !undo_.empty(); }
+    bool canRedo() const { return !redo_.empty(); }
+    std::size_t undoDepth() const { return undo_.size(); }
+    std::size_t redoDepth() const { return redo_.size(); }
+
+    /* Returnerer antal celler der blev ændret (0 = intet at fortryde eller et strøg er åbent) */
+    std::size_t undo(Manager& manager);
+    std::size_t redo(Manager& manager);
+
+    void clear();
+
+  private:
+    // Celle x..x+length-1 på række y
+    struct Run {
+      std::int32_t x;
+      std::int32_t y;
+      std::uint16_t length;
+      std::uint8_t type;
+      std::int16_t before;
+      std::int16_t after;
+    };
+
+    struct Command {
+      std::vector<Run> runs;
+      std::size_t cells = 0;
+
+      std::size_t bytes() const { return sizeof(Command) + runs.capacity() * sizeof(Run); }
+    };
+
+    static Command Encode(std::vector<CellDelta>& deltas);
+    static std::size_t Apply(Manager& manager, const Command& command, bool forward);
+
+    void push(Command command);
+    void enforceCap();
+    std::size_t strokeBytes() const { return stroke_.capacity() * sizeof(CellDelta); }
+
+    std::deque<Command> undo_;
+    std::deque<Command> redo_;
+    std::vector<CellDelta> stroke_;
+    int strokeDepth_ = 0;
+    std::size_t memoryCap_;
+    std::size_t memoryUsed_ = 0;
+};
+
+}
@@ -0,0 +1,265 @@
+#include "Journal.hpp"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstring>
+#include <iterator>
+#include <tuple>
+#include <utility>
+
+#include "Scene.hpp"
+#include "logging/Logger.hpp"
+#include "logging/Trace.hpp"
+
+namespace Scene {
+
+namespace {
+  // Fil: "PJNL" + version, derefter records: u32 payload længde, u32 CRC32(payload), payload.
+  // Payload er celler af ENTRY_BYTES i maskinens byte order - journalen flyttes ikke mellem maskiner
+  constexpr char MAGIC[4] = { 'P', 'J', 'N', 'L' };
+  constexpr std::uint32_t VERSION = 1;
+  constexpr std::size_t HEADER_BYTES = 8;
+  constexpr std::size_t RECORD_HEADER_BYTES = 8;
+  constexpr std::size_t ENTRY_BYTES = 4 + 4 + 1 + 2; // x, y, type, index efter (-1 = ingen tile)
+
+  constexpr std::array<std::uint32_t, 256> CRC_TABLE = [] {
+    std::array<std::uint32_t, 256> table {};
+    for (std::uint32_t i = 0; i < 256; ++i) {
+      std::uint32_t c = i;
+      for (int k = 0; k < 8; ++k) c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+      table[i] = c;
+    }
+    return table;
+  }();
+
+  std::uint32_t Crc32(const char* data, std::size_t size) {
+    std::uint32_t crc = 0xFFFFFFFFu;
+    for (std::size_t i = 0; i < size; ++i) {
+      crc = CRC_TABLE[(crc ^ static_cast<std::uint8_t>(data[i])) & 0xFF] ^ (crc >> 8);
+    }
+    return crc ^ 0xFFFFFFFFu;
+  }
+
+  template <typename T>
+  char* Put(char* p, T value) {
+    std::memcpy(p, &value, sizeof(T));
+    return p + sizeof(T);
+  }
+
+  template <typename T>
+  const char* Get(const char* p, T& value) {
+    std::memcpy(&value, p, sizeof(T));
+    return p + sizeof(T);
+  }
+
+  void WriteHeader(std::ostream& out) {
+    out.write(MAGIC, sizeof(MAGIC));
+    out.write(reinterpret_cast<const char*>(&VERSION), sizeof(VERSION));
+  }
+
+  std::vector<char> ReadFile(const std::filesystem::path& path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in.is_open()) return {};
+    return std::vector<char>(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+  }
+}
+
+Journal::~Journal() {
+  close();
+}
+
+void Journal::open(const std::filesystem::path& sceneDir, std::uintmax_t validBytes) {
+  close();
+  // Også hvis åbningen fejler - gamle mærker peger ind i en anden fil
+  ++generation_;
+
+  const std::filesystem::path path = sceneDir / FILE_NAME;
+  std::error_code ec;
+  std::filesystem::create_directories(sceneDir, ec);
+
+  if (validBytes < HEADER_BYTES) {
+    std::ofstream fresh(path, std::ios::binary | std::ios::trunc);
+    WriteHeader(fresh);
+    validBytes = HEADER_BYTES;
+  } else if (std::filesystem::file_size(path, ec) != validBytes) {
+    // Den halve record fra et crash skal ikke ligge foran de nye
+    std::filesystem::resize_file(path, validBytes, ec);
+  }
+
+  out_.open(path, std::ios::binary | std::ios::app);
+  if (!out_.is_open()) {
+    Log::Error(Log::Category::Scene, "Kunne ikke åbne journal: {} - ændringer journaliseres ikke", path.string());
+    return;
+  }
+
+  sceneDir_ = sceneDir;
+  pending_.clear();
+  checkpoint_.reset();
+  appended_ = validBytes;
+  dropped_ = 0;
+  stop_ = false;
+  worker_ = std::thread(&Journal::run, this);
+  Log::Debug(Log::Category::Scene, "Journal åbnet: {} ({} bytes)", path.string(), validBytes);
+}
+
+void Journal::close() {
+  if (!worker_.joinable()) return;
+  {
+    std::lock_guard lock(mutex_);
+    stop_ = true;
+  }
+  wake_.notify_one();
+  worker_.join();
+  sceneDir_.clear();
+}
+
+void Journal::append(const std::vector<CellDelta>& deltas) {
+  if (!worker_.joinable() || deltas.empty()) return;
+
+  const std::size_t payload = deltas.size() * ENTRY_BYTES;
+  std::lock_guard lock(mutex_);
+  const std::size_t start = pending_.size();
+  pending_.resize(start + RECORD_HEADER_BYTES + payload);
+
+  char* body = pending_.data() + start + RECORD_HEADER_BYTES;
+  char* p = body;
+  for (const CellDelta& d : deltas) {
+    p = Put<std::int32_t>(p, d.x);
+    p = Put<std::int32_t>(p, d.y);
+    p = Put<std::uint8_t>(p, static_cast<std::uint8_t>(d.type));
+    p = Put<std::int16_t>(p, static_cast<std::int16_t>(d.after));
+  }
+
+  char* header = pending_.data() + start;
+  header = Put<std::uint32_t>(header, static_cast<std::uint32_t>(payload));
+  Put<std::uint32_t>(header, Crc32(body, payload));
+  appended_ += RECORD_HEADER_BYTES + payload;
+}
+
+std::uint64_t Journal::mark() const {
+  std::lock_guard lock(mutex_);
+  return appended_;
+}
+
+void Journal::checkpoint(std::uint64_t generation, std::uint64_t mark) {
+  // appended_ og dropped_ er startet forfra siden mærket blev taget (genindlæsning eller save-as)
+  if (!worker_.joinable() || generation != generation_) return;
+  {
+    std::lock_guard lock(mutex_);
+    checkpoint_ = std::max(checkpoint_.value_or(0), mark);
+  }
+  wake_.notify_one();
+}
+
+void Journal::run() {
+  Log::Trace::SetThreadName("journal");
+  std::vector<char> batch;
+
+  std::unique_lock lock(mutex_);
+  while (true) {
+    wake_.wait_for(lock, std::chrono::milliseconds(FLUSH_INTERVAL_MS), [&] { return stop_ || checkpoint_.has_value(); });
+    batch.swap(pending_);
+    const std::optional<std::uint64_t> checkpoint = std::exchange(checkpoint_, std::nullopt);
+    const bool stopping = stop_;
+    lock.unlock();
+
+    // Alt før et checkpoint er i denne batch eller allerede skrevet
+    if (!batch.empty()) writeBatch(batch);
+    batch.clear();
+    if (checkpoint) compact(*checkpoint);
+    if (stopping) break;
+
+    lock.lock();
+  }
+
+  out_.close();
+}
+
+void Journal::writeBatch(const std::vector<char>& batch) {
+  TRACE_SCOPE_DETAIL("Journal::writeBatch", "save", std::to_string(batch.size()));
+  out_.write(batch.data(), static_cast<std::streamsize>(batch.size()));
+  out_.flush();
+  if (!out_) {
+    Log::Error(Log::Category::Scene, "Skrivning til journal i {} fejlede", sceneDir_.string());
+    out_.clear();
+  }
+}
+
+void Journal::compact(std::uint64_t mark) {
+  if (mark <= dropped_ + HEADER_BYTES) return;
+  TRACE_SCOPE("Journal::compact", "save");
+
+  const std::filesystem::path path = sceneDir_ / FILE_NAME;
+  out_.close();
+
+  const std::vector<char> data = ReadFile(path);
+  const std::size_t cut = std::min<std::size_t>(mark - dropped_, data.size());
+  const bool ok = WriteFileAtomic(path, [&](std::ostream& out) {
+    WriteHeader(out);
+    out.write(data.data() + cut, static_cast<std::streamsize>(data.size() - cut));
+  }, true);
+  if (ok) dropped_ += cut - HEADER_BYTES;
+
+  out_.open(path, std::ios::binary | std::ios::app);
+  Log::Debug(Log::Category::Scene, "Journal {} komprimeret til {} bytes", path.string(), HEADER_BYTES + data.size() - cut);
+}
+
+JournalReplay Journal::Replay(const std::filesystem::path& sceneDir, ChangeSet& out) {
+  TRACE_SCOPE_DETAIL("Journal::Replay", "scene", sceneDir.string());
+  JournalReplay replay;
+  const std::filesystem::path path = sceneDir / FILE_NAME;
+  const std::vector<char> data = ReadFile(path);
+  replay.fileBytes = data.size();
+  if (data.empty()) return replay;
+
+  std::uint32_t version = 0;
+  if (data.size() < HEADER_BYTES || std::memcmp(data.data(), MAGIC, sizeof(MAGIC)) != 0 ||
+      (Get(data.data() + sizeof(MAGIC), version), version != VERSION)) {
+    Log::Warn(Log::Category::Scene, "Ukendt journal format: {} - ignoreres", path.string());
+    return replay;
+  }
+
+  std::vector<CellDelta> cells;
+  std::size_t pos = HEADER_BYTES;
+  while (data.size() - pos >= RECORD_HEADER_BYTES) {
+    std::uint32_t payload = 0;
+    std::uint32_t crc = 0;
+    Get(Get(data.data() + pos, payload), crc);
+    if (payload % ENTRY_BYTES != 0 || data.size() - pos - RECORD_HEADER_BYTES < payload) break;
+
+    const char* p = data.data() + pos + RECORD_HEADER_BYTES;
+    if (Crc32(p, payload) != crc) break;
+
+    for (std::size_t i = 0; i < payload / ENTRY_BYTES; ++i) {
+      std::int32_t x, y;
+      std::uint8_t type;
+      std::int16_t after;
+      p = Get(Get(Get(Get(p, x), y), type), after);
+      if (type > TILE_TYPE_CONSTRAINT) continue;
+      cells.push_back({ x, y, static_cast<TileType>(type), -1, after });
+    }
+    ++replay.records;
+    pos += RECORD_HEADER_BYTES + payload;
+  }
+
+  replay.validBytes = pos;
+  if (pos != data.size()) {
+    Log::Warn(Log::Category::Scene, "Journal {} er afbrudt efter {} af {} bytes - resten ignoreres", path.string(), pos, data.size());
+  }
+
+  // Kun den sidste tilstand per celle og type betyder noget - ét samlet ChangeSet og ét autotile pass
+  std::stable_sort(cells.begin(), cells.end(), [](const CellDelta& a, const CellDelta& b) {
+    return std::tie(a.type, a.y, a.x) < std::tie(b.type, b.y, b.x);
+  });
+  for (std::size_t i = 0; i < cells.size(); ++i) {
+    const CellDelta& c = cells[i];
+    if (i + 1 < cells.size() && cells[i + 1].type == c.type && cells[i + 1].x == c.x && cells[i + 1].y == c.y) continue;
+    if (c.after < 0) out.removals.push_back({ c.x, c.y, c.type, 0 });
+    else             out.placements.push_back({ c.x, c.y, c.type, c.after });
+    ++replay.cells;
+  }
+  return replay;
+}
+
+}
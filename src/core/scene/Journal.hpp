@@ -0,0 +1,93 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+#include "History.hpp"
+
+namespace Scene {
+
+struct ChangeSet;
+
+/* Hvad der blev fundet i en journal ved indlæsning */
+struct JournalReplay {
+  size_t records = 0;
+  size_t cells = 0;
+  std::uintmax_t validBytes = 0; // op til første ødelagte/halve record (eller 0 uden gyldig header)
+  std::uintmax_t fileBytes = 0;
+};
+
+/*
+ * Write-ahead journal per scene (<scene>/.journal). Hver mutation tilføjes som én binær record
+ * (længde, CRC32 og celler med tilstanden efter ændringen), og en baggrundstråd skriver dem
+ * samlet hvert FLUSH_INTERVAL_MS - main tråden rører aldrig disken. Ved indlæsning lægges
+ * journalen oven på sidste fulde save. Records er absolutte, så det er ufarligt at afspille
+ * noget der allerede er gemt - efter en save fjernes kun det der kom før snapshottet.
+ *
+ * En halv record i slutningen (crash midt i en skrivning) fanges af længde/CRC og smides væk.
+ */
+class Journal {
+  public:
+    static constexpr const char* FILE_NAME = ".journal";
+    /* Bliver journalen større end dette, gemmes scenen helt ved indlæsning og journalen tømmes */
+    static constexpr std::uintmax_t COMPACT_BYTES = 1024 * 1024;
+    static constexpr int FLUSH_INTERVAL_MS = 250;
+
+    Journal() = default;
+    ~Journal();
+
+    Journal(const Journal&) = delete;
+    Journal& operator=(const Journal&) = delete;
+
+    /* Skriver fremover til sceneDir/.journal. validBytes fra Replay - resten (en halv record) skæres af */
+    void open(const std::filesystem::path& sceneDir, std::uintmax_t validBytes);
+    /* Skriver det ventende og stopper tråden */
+    void close();
+    bool isOpen() const { return worker_.joinable(); }
+    const std::filesystem::path& sceneDir() const { return sceneDir_; }
+    /* Tælles op ved hver open - et mærke gælder kun for den generation det blev taget i */
+    std::uint64_t generation() const { return generation_; }
+
+    /* Main tråden: én mutation = én record. Ignoreres når journalen ikke er åben */
+    void append(const std::vector<CellDelta>& deltas);
+
+    /* Position efter alt tilføjet indtil nu - tages sammen med et save snapshot */
+    std::uint64_t mark() const;
+    /*
+     * Snapshottet taget ved mark er gemt: records før mark fjernes fra filen (på tråden).
+     * Mærker fra en ældre generation (scenen er genindlæst eller gemt et andet sted siden) ignoreres
+     */
+    void checkpoint(std::uint64_t generation, std::uint64_t mark);
+
+    /* Læser alle gyldige records i rækkefølge ind i out (foldet per celle - sidste tilstand vinder) */
+    static JournalReplay Replay(const std::filesystem::path& sceneDir, ChangeSet& out);
+
+  private:
+    void run();
+    void writeBatch(const std::vector<char>& batch);
+    void compact(std::uint64_t mark);
+
+    std::filesystem::path sceneDir_;
+    std::uint64_t generation_ = 0;
+    std::thread worker_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable wake_;
+    bool stop_ = false;
+    std::vector<char> pending_;            // records der endnu ikke er skrevet
+    std::uint64_t appended_ = 0;           // logisk position efter sidste append
+    std::optional<std::uint64_t> checkpoint_;
+
+    // Kun tråden
+    std::ofstream out_;
+    std::uint64_t dropped_ = 0;            // bytes fjernet af checkpoints - logisk = fysisk + dropped_
+};
+
+}
@@ -3,27 +3,67 @@
 #include "SDL3/SDL_render.h"
 #include "logging/Logger.hpp"
 #include "resources/ResourceManager.hpp"
+#include "jobs/JobSystem.hpp"
+#include "memory/FrameArena.hpp"
+#include <algorithm>
+#include <cstdint>
 #include <filesystem>
+#include <fstream>
+#include <unordered_set>
+#include <utility>
 
 namespace Scene {
 
-static void WriteCSV(const std::filesystem::path& filePath, const std::vector<std::vector<int>>& data) {
-  std::filesystem::create_directories(filePath.parent_path());
-  std::ofstream out(filePath);
-  if (!out.is_open()) {
-    Log::Error("Kunne ikke åbne fil til skrivning: {}", filePath.string());
-    return;
-  }
+namespace {
+  // Modsat Tiles::makeTileKey
+  int KeyX(long long key) { return static_cast<int>(key >> 32); }
+  int KeyY(long long key) { return static_cast<int>(static_cast<unsigned int>(key)); }
+}
 
-  for (size_t y = 0; y < data.size(); ++y) {
-    for (size_t x = 0; x < data[y].size(); ++x) {
-      out << data[y][x];
-      if (x < data[y].size() - 1) out << ",";
+bool WriteFileAtomic(const std::filesystem::path& filePath, const std::function<void(std::ostream&)>& write, bool binary) {
+  std::error_code ec;
+  std::filesystem::create_directories(filePath.parent_path(), ec);
+
+  std::filesystem::path tmpPath = filePath;
+  tmpPath += ".tmp";
+  {
+    std::ofstream out(tmpPath, binary ? std::ios::out | std::ios::binary : std::ios::out);
+    if (!out.is_open()) {
+      Log::Error(Log::Category::Scene, "Kunne ikke åbne fil til skrivning: {}", tmpPath.string());
+      return false;
+    }
+    write(out);
+    out.flush();
+    if (!out) {
+      Log::Error(Log::Category::Scene, "Skrivning til {} fejlede", tmpPath.string());
+      out.close();
+      std::filesystem::remove(tmpPath, ec);
+      return false;
     }
-    out << "\n";
   }
-  out.close();
-  Log::Info("Gemte {}", filePath.string());
+
+  std::filesystem::rename(tmpPath, filePath, ec);
+  if (ec) {
+    Log::Error(Log::Category::Scene, "Kunne ikke omdøbe {} til {}: {}", tmpPath.string(), filePath.string(), ec.message());
+    std::filesystem::remove(tmpPath, ec);
+    return false;
+  }
+  return true;
+}
+
+bool WriteCSV(const std::filesystem::path& filePath, const Utils::TileLayer& data) {
+  TRACE_SCOPE("WriteCSV", "save");
+  const bool ok = WriteFileAtomic(filePath, [&](std::ostream& out) {
+    for (size_t y = 0; y < data.size(); ++y) {
+      for (size_t x = 0; x < data[y].size(); ++x) {
+        out << data[y][x];
+        if (x < data[y].size() - 1) out << ",";
+      }
+      out << "\n";
+    }
+  });
+  if (ok) Log::Debug(Log::Category::Scene, "Gemte {}", filePath.string());
+  return ok;
 }
 
 // Bestem max grid size på alle tiletypes
@@ -39,26 +79,13 @@ static Vec2<int> ComputeMapSize(const Tiles& tiles) {
   return { maxX + 1, maxY + 1 };
 }
 
-// Konverter tilegroup til 2D matrix
-static std::vector<std::vector<int>> MakeCSVDataForType(const TileGroup& group, int width, int height) {
-  std::vector<std::vector<int>> grid(height, std::vector<int>(width, -1));
-  for (auto* tile : group) {
-    int x = static_cast<int>(tile->position.x);
-    int y = static_cast<int>(tile->position.y);
-    if (x >= 0 && x < width && y >= 0 && y < height) {
-      grid[y][x] = tile->getTileIndex();
-    }
-  }
-  return grid;
-}
-
 static void RenderMiniBackground(SDL_Renderer *renderer, int mapW, int mapH) {
   SDL_Texture* sky_top    = ResourceManager::loadTexture("resources/decoration/sky/sky_top.png");
   SDL_Texture* sky_middle = ResourceManager::loadTexture("resources/decoration/sky/sky_middle.png");
   SDL_Texture* sky_bottom = ResourceManager::loadTexture("resources/decoration/sky/sky_bottom.png");
 
   if(!sky_top || !sky_middle || !sky_bottom) {
-    Log::Error("Kunne ikke indlæse sky-textures til thumbnail");
+    Log::Error(Log::Category::Scene, "Kunne ikke indlæse sky-textures til thumbnail");
     return;
   }
 
@@ -70,9 +97,9 @@ static void RenderMiniBackground(SDL_Renderer *renderer, int mapW, int mapH) {
   SDL_FRect middleRect { 0, topH, (float)mapW, middleH };
   SDL_FRect bottomRect { 0, topH + middleH, (float)mapW, bottomH };
 
-  SDL_RenderTexture(renderer, sky_top,    nullptr, &topRect);
-  SDL_RenderTexture(renderer, sky_middle, nullptr, &middleRect);
-  SDL_RenderTexture(renderer, sky_bottom, nullptr, &bottomRect);
+  Render::Texture(renderer, sky_top,    nullptr, &topRect);
+  Render::Texture(renderer, sky_middle, nullptr, &middleRect);
+  Render::Texture(renderer, sky_bottom, nullptr, &bottomRect);
 
   SDL_Texture* cloud1 = ResourceManager::loadTexture("resources/decoration/clouds/1.png");
   SDL_Texture* cloud2 = ResourceManager::loadTexture("resources/decoration/clouds/2.png");
@@ -86,16 +113,39 @@ static void RenderMiniBackground(SDL_Renderer *renderer, int mapW, int mapH) {
     SDL_GetTextureSize(cloud2, &cw, &ch);
     SDL_FRect c3 { mapW * 0.35f, mapH * 0.05f, cw, ch };
     SDL_GetTextureSize(cloud3, &cw, &ch);
-    SDL_RenderTexture(renderer, cloud1, nullptr, &c1);
-    SDL_RenderTexture(renderer, cloud2, nullptr, &c2);
-    SDL_RenderTexture(renderer, cloud3, nullptr, &c3);
+    Render::Texture(renderer, cloud1, nullptr, &c1);
+    Render::Texture(renderer, cloud2, nullptr, &c2);
+    Render::Texture(renderer, cloud3, nullptr, &c3);
   }
 }
 
+static void FreeTileGroup(TileGroup& g) {
+  for(auto* t : g) delete t;
+  g.clear();
+}
+
+static void FreeAllTiles(Tiles& t) {
+  for(auto* group : t.allGroups) {
+    FreeTileGroup(*group);
+  }
+
+  t.tileLookup.clear();
+}
+
 SDL_Texture* BuildSceneThumbnail(SDL_Renderer* renderer, const std::string& sceneName, int thumbW, int thumbH) {
-  Layout lay(sceneName);
-  Tiles temp(lay);
-  temp.AutotileAllTerrain();
+  Layout lay = [&] { TRACE_SCOPE("Layout", "thumbnail"); return Layout(sceneName); }();
+  return BuildSceneThumbnail(renderer, lay, sceneName, thumbW, thumbH);
+}
+
+SDL_Texture* BuildSceneThumbnail(SDL_Renderer* renderer, const Layout& lay, const std::string& sceneName, int thumbW, int thumbH) {
+  TRACE_SCOPE_DETAIL("BuildSceneThumbnail", "thumbnail", sceneName);
+  Render::SubsystemScope renderScope(Render::Subsystem::Thumbnail);
+
+  // Tiles henter deres teksturer gennem ResourceManager - derfor på render tråden
+  Tiles temp = [&] { TRACE_SCOPE("Tiles", "thumbnail"); return Tiles(lay); }();
+
+  // De midlertidige tiles ejes af os - frigives på alle veje ud af funktionen
+  struct FreeOnExit { Tiles& tiles; ~FreeOnExit() { FreeAllTiles(tiles); } } freeTemp { temp };
 
   for (auto* group : temp.allGroups)
     for (auto* t : *group)
@@ -106,7 +156,7 @@ SDL_Texture* BuildSceneThumbnail(SDL_Renderer* renderer, const std::string& scen
   int mapH = std::max(1, grid.y * TILE_SIZE);
 
   if (mapW <= 0 || mapH <= 0) {
-    Log::Warn("Scene '{}' har ingen tiles - springer thumbnail over", sceneName);
+    Log::Warn(Log::Category::Scene, "Scene '{}' har ingen tiles - springer thumbnail over", sceneName);
     return nullptr;
   }
 
@@ -119,14 +169,14 @@ SDL_Texture* BuildSceneThumbnail(SDL_Renderer* renderer, const std::string& scen
 
   SDL_Texture* fullTex = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, visibleW, visibleH);
   if (!fullTex) {
-    Log::Error("Kunne ikke oprette thumbnail-render-target for '{}', fejl: {}", sceneName, SDL_GetError());
+    Log::Error(Log::Category::Scene, "Kunne ikke oprette thumbnail-render-target for '{}', fejl: {}", sceneName, SDL_GetError());
     return nullptr;
   }
 
   SDL_SetTextureBlendMode(fullTex, SDL_BLENDMODE_BLEND);
-  SDL_SetRenderTarget(renderer, fullTex);
+  Render::SetTarget(renderer, fullTex);
   SDL_SetRenderDrawColor(renderer, 18, 18, 24, 255);
-  SDL_RenderClear(renderer);
+  Render::Clear(renderer);
 
   RenderMiniBackground(renderer, visibleW, visibleH);
 
@@ -137,19 +187,19 @@ SDL_Texture* BuildSceneThumbnail(SDL_Renderer* renderer, const std::string& scen
     }
   }
 
-  SDL_SetRenderTarget(renderer, nullptr);
+  Render::SetTarget(renderer, nullptr);
 
   SDL_Texture* thumb = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, thumbW, thumbH);
   if (!thumb) {
-    Log::Error("Kunne ikke oprette thumbnail-tekstur for '{}'", sceneName);
+    Log::Error(Log::Category::Scene, "Kunne ikke oprette thumbnail-tekstur for '{}'", sceneName);
     SDL_DestroyTexture(fullTex);
     return nullptr;
   }
 
   SDL_SetTextureBlendMode(thumb, SDL_BLENDMODE_BLEND);
-  SDL_SetRenderTarget(renderer, thumb);
+  Render::SetTarget(renderer, thumb);
   SDL_SetRenderDrawColor(renderer, 12, 12, 16, 255);
-  SDL_RenderClear(renderer);
+  Render::Clear(renderer);
 
   float sx = (float)thumbW / visibleW;
   float sy = (float)thumbH / visibleH;
@@ -164,10 +214,10 @@ SDL_Texture* BuildSceneThumbnail(SDL_Renderer* renderer, const std::string& scen
     (float)dstH
   };
 
-  SDL_RenderTexture(renderer, fullTex, nullptr, &dst);
+  Render::Texture(renderer, fullTex, nullptr, &dst);
 
   // Luk op efter os
-  SDL_SetRenderTarget(renderer, nullptr);
+  Render::SetTarget(renderer, nullptr);
   SDL_DestroyTexture(fullTex);
 
   return thumb;
@@ -175,21 +225,35 @@ SDL_Texture* BuildSceneThumbnail(SDL_Renderer* renderer, const std::string& scen
 
 
 
-void Manager::saveScene(const std::string& sceneName) {
-  std::filesystem::path sceneDir = std::filesystem::path("scenes") / sceneName;
-  std::filesystem::create_directories(sceneDir);
+Vec2<int> Manager::sceneSize() const {
+  // Mindst standardstørrelsen, men store (fx genererede) scener må ikke blive klippet
+  const Vec2<int> used = ComputeMapSize(tiles);
+  const int layoutWidth = layout.terrainLayout.empty() ? 0 : static_cast<int>(layout.terrainLayout.front().size());
+  return {
+    std::max({ DEFAULT_SCENE_WIDTH, used.x, layoutWidth }),
+    std::max({ DEFAULT_SCENE_HEIGHT, used.y, static_cast<int>(layout.terrainLayout.size()) })
+  };
+}
 
-  Log::Info("Gemmer scene til: {}", sceneDir.string());
+SaveSnapshot Manager::snapshotForSave(const std::string& sceneName, const std::filesystem::path& root, bool all) {
+  TRACE_SCOPE_DETAIL("Manager::snapshotForSave", "save", sceneName);
+  SaveSnapshot snapshot;
+  snapshot.sceneName = sceneName;
+  snapshot.sceneDir = root / sceneName;
+  snapshot.sequence = ++snapshotCount;
 
-  const int width  = 60;
-  const int height = 11;
+  const Vec2<int> size = sceneSize();
+  snapshot.width = size.x;
+  snapshot.height = size.y;
 
-  Log::Info("Map size (fast): {} x {}", width, height);
+  // Alle filer deler samme størrelse, så et nyt sted eller en ny størrelse kræver dem alle
+  const bool full = all || snapshot.sceneDir != savedDir || size.x != savedSize.x || size.y != savedSize.y;
+  const std::uint32_t types = full ? ~0u : tiles.dirtyTypes;
 
   struct TypeFile {
     TileType type;
     const char* suffix;
-    TileGroup* group;
+    const TileGroup* group;
   } typeFiles[] = {
     { TILE_TYPE_BG_PALM,     "_bg_palms.csv",   &tiles.bgPalmsTiles },
     { TILE_TYPE_COIN,        "_coins.csv",      &tiles.coinsTiles },
@@ -203,13 +267,61 @@ void Manager::saveScene(const std::string& sceneName) {
   };
 
   for (const auto& entry : typeFiles) {
-    auto data = MakeCSVDataForType(*entry.group, width, height);
-    std::filesystem::path filePath = sceneDir / (sceneName + entry.suffix);
-    WriteCSV(filePath, data);
-    Log::Info("Gemte {}", filePath.string());
+    if (!(types & (1u << entry.type))) continue;
+
+    LayerSnapshot layer { entry.type, entry.suffix, {} };
+    layer.tiles.reserve(entry.group->size());
+    for (const Tile* t : *entry.group) {
+      layer.tiles.push_back({ static_cast<int>(t->position.x), static_cast<int>(t->position.y), t->getTileIndex() });
+    }
+    std::sort(layer.tiles.begin(), layer.tiles.end(), [](const SavedTile& a, const SavedTile& b) {
+      return a.y != b.y ? a.y < b.y : a.x < b.x;
+    });
+    snapshot.layers.push_back(std::move(layer));
   }
 
-  Log::Info("Scene gemt til: {}", sceneName);
+  tiles.dirtyTypes = 0;
+  savedDir = snapshot.sceneDir;
+  savedSize = size;
+
+  if (journal) {
+    // Save-as: journalen følger scenen til den nye mappe. Den gamle beholder sine ændringer
+    if (journal->sceneDir() != snapshot.sceneDir) journal->open(snapshot.sceneDir, 0);
+    snapshot.journalMark = journal->mark();
+    snapshot.journalGeneration = journal->generation();
+  }
+
+  Log::Debug(Log::Category::Scene, "Snapshot af '{}': {} af 9 lag, {} x {}", sceneName, snapshot.layers.size(), size.x, size.y);
+  return snapshot;
+}
+
+void Manager::saveScene(const std::string& sceneName, const std::filesystem::path& root) {
+  TRACE_SCOPE_DETAIL("Manager::saveScene", "save", sceneName);
+  Log::Info(Log::Category::Scene, "Gemmer scene til: {}", (root / sceneName).string());
+
+  const SaveResult result = SceneSaver::Write(snapshotForSave(sceneName, root, true));
+  saveFinished(result);
+  if (!result.ok) {
+    Log::Error(Log::Category::Scene, "Scene '{}' blev kun delvist gemt ({} filer)", sceneName, result.written);
+    return;
+  }
+
+  Log::Info(Log::Category::Scene, "Scene gemt til: {}", sceneName);
+}
+
+void Manager::saveFinished(const SaveResult& result) {
+  // En fejlet save til en mappe scenen er flyttet væk fra er dækket af save-as'ens fulde snapshot
+  if (result.sceneDir != savedDir) return;
+
+  if (!result.ok) {
+    // Snapshots der allerede venter har ikke de fejlede lag - deres mærker må ikke komprimere dem væk
+    markDirty(result.failedTypes);
+    checkpointFrom = snapshotCount + 1;
+    return;
+  }
+
+  // Det der stod i journalen før snapshottet er nu i CSV filerne
+  if (journal && result.sequence >= checkpointFrom) journal->checkpoint(result.journalGeneration, result.journalMark);
 }
 
 // bitmask: N=1, E=2, S=4, W=8
@@ -233,7 +345,7 @@ const std::array<int,16> Tiles::TERRAIN_16_MAP = {
 };
 
 
-Tile* Tiles::GetTileOfType(int gx, int gy, TileType type) {
+Tile* Tiles::GetTileOfType(int gx, int gy, TileType type) const {
   long long key = makeTileKey(gx, gy);
   auto it = tileLookup.find(key);
   if (it == tileLookup.end()) return nullptr;
@@ -243,10 +355,15 @@ Tile* Tiles::GetTileOfType(int gx, int gy, TileType type) {
   return nullptr;
 }
 
-bool Tiles::HasTileOfType(int gx, int gy, TileType type) {
+bool Tiles::HasTileOfType(int gx, int gy, TileType type) const {
   return GetTileOfType(gx, gy, type) != nullptr;
 }
 
+bool Tiles::IsPlaced(int gx, int gy, TileType type, int tileIndex) const {
+  const Tile* t = GetTileOfType(gx, gy, type);
+  return t && (type == TILE_TYPE_TERRAIN || t->getTileIndex() == tileIndex);
+}
+
 int Tiles::Make4BitMask(int x, int y, std::function<bool(int,int)> isSame) {
   int mask = 0;
   if (isSame(x, y-1)) mask |= 1;  // N
@@ -256,10 +373,7 @@ int Tiles::Make4BitMask(int x, int y, std::function<bool(int,int)> isSame) {
   return mask;
 }
 
-void Tiles::AutotileRecalcAt(int x, int y) {
-  Tile* t = GetTileOfType(x, y, TILE_TYPE_TERRAIN);
-  if (!t) return;
-
+int Tiles::ComputeTerrainIndex(int x, int y) const {
   auto isSame = [&](int ax, int ay) {
       return HasTileOfType(ax, ay, TILE_TYPE_TERRAIN);
   };
@@ -287,7 +401,269 @@ void Tiles::AutotileRecalcAt(int x, int y) {
       else                    tileIndex = 15; // helt isoleret
   }
 
-  t->setTileIndex(tileIndex);
+  return tileIndex;
+}
+
+void Tiles::AutotileRecalcAt(int x, int y) {
+  Tile* t = GetTileOfType(x, y, TILE_TYPE_TERRAIN);
+  if (!t) return;
+
+  t->setTileIndex(ComputeTerrainIndex(x, y));
+}
+
+TileGroup* Tiles::GroupForType(TileType type) {
+  switch (type) {
+    case TILE_TYPE_TERRAIN:       return &terrainTiles;
+    case TILE_TYPE_CRATE:         return &crateTiles;
+    case TILE_TYPE_GRASS:         return &grassTiles;
+    case TILE_TYPE_PLAYER_SETUP:  return &playerSetupTiles;
+    case TILE_TYPE_ENEMY:         return &enemyTiles;
+    case TILE_TYPE_COIN:          return &coinsTiles;
+    case TILE_TYPE_FG_PALM:       return &fgPalmsTiles;
+    case TILE_TYPE_BG_PALM:       return &bgPalmsTiles;
+    case TILE_TYPE_CONSTRAINT:    return &constraintTiles;
+    default:                      return nullptr;
+  }
+}
+
+void Tiles::EraseTile(Tile* tile) {
+  MarkDirty(tile->getType());
+  if (TileGroup* group = GroupForType(tile->getType())) {
+    group->erase(std::remove(group->begin(), group->end(), tile), group->end());
+  }
+
+  const long long key = makeTileKey(static_cast<int>(tile->position.x), static_cast<int>(tile->position.y));
+  auto it = tileLookup.find(key);
+  if (it != tileLookup.end()) {
+    auto& cell = it->second;
+    cell.erase(std::remove(cell.begin(), cell.end(), tile), cell.end());
+    if (cell.empty()) tileLookup.erase(it);
+  }
+
+  delete tile;
+}
+
+int Tiles::LayerForType(TileType type) const {
+  switch (type) {
+    case TILE_TYPE_BG_PALM:       return 0;
+    case TILE_TYPE_TERRAIN:
+    case TILE_TYPE_CRATE:
+    case TILE_TYPE_GRASS:
+    case TILE_TYPE_ENEMY:         return 1;
+    case TILE_TYPE_FG_PALM:
+    case TILE_TYPE_COIN:
+    case TILE_TYPE_PLAYER_SETUP:
+    case TILE_TYPE_CONSTRAINT:    return 2;
+    default:                      return -1;
+  }
+}
+
+void Tiles::CollectRegion(const Selection& selection, int layerIndex, std::vector<TilePlacement>& out) const {
+  auto collectCell = [&](int x, int y, const std::vector<Tile*>& cell) {
+    for (const Tile* t : cell) {
+      if (layerIndex != -1 && LayerForType(t->getType()) != layerIndex) continue;
+      out.push_back({ x, y, t->getType(), t->getTileIndex() });
+    }
+  };
+
+  for (const CellRect& r : selection.rects()) {
+    if (r.area() <= static_cast<long long>(tileLookup.size())) {
+      for (int y = r.y; y < r.y + r.h; ++y) {
+        for (int x = r.x; x < r.x + r.w; ++x) {
+          auto it = tileLookup.find(makeTileKey(x, y));
+          if (it != tileLookup.end()) collectCell(x, y, it->second);
+        }
+      }
+    } else {
+      // Rect'en er større end antallet af optagede celler - så er det billigere at gå dem igennem
+      for (const auto& [key, cell] : tileLookup) {
+        const int x = KeyX(key);
+        const int y = KeyY(key);
+        if (r.contains(x, y)) collectCell(x, y, cell);
+      }
+    }
+  }
+}
+
+size_t Tiles::ApplyChanges(const ChangeSet& changes, std::vector<CellDelta>* record) {
+  PROFILE_SCOPE("Tiles::ApplyChanges");
+  // Scratch der kun lever under kaldet - frame arenaen i stedet for heapen
+  Memory::FrameVector<Tile*> doomed = Memory::FrameArena::vector<Tile*>();
+  Memory::FrameVector<TileGroup*> touchedGroups = Memory::FrameArena::vector<TileGroup*>();
+  Memory::FrameVector<long long> terrainCells = Memory::FrameArena::vector<long long>(); // celler hvor terrain kom til eller forsvandt
+  size_t applied = 0;
+
+  auto detach = [&](Tile* tile, std::vector<Tile*>& cell) {
+    cell.erase(std::remove(cell.begin(), cell.end(), tile), cell.end());
+    doomed.push_back(tile);
+    TileGroup* group = GroupForType(tile->getType());
+    if (std::find(touchedGroups.begin(), touchedGroups.end(), group) == touchedGroups.end()) {
+      touchedGroups.push_back(group);
+    }
+  };
+
+  for (const TilePlacement& r : changes.removals) {
+    const long long key = makeTileKey(r.x, r.y);
+    auto it = tileLookup.find(key);
+    if (it == tileLookup.end()) continue;
+
+    auto& cell = it->second;
+    auto found = std::find_if(cell.begin(), cell.end(), [&](const Tile* t) { return t->getType() == r.type; });
+    if (found == cell.end()) continue;
+
+    if (record) record->push_back({ r.x, r.y, r.type, (*found)->getTileIndex(), -1 });
+    MarkDirty(r.type);
+    detach(*found, cell);
+    if (cell.empty()) tileLookup.erase(it);
+    if (r.type == TILE_TYPE_TERRAIN) terrainCells.push_back(key);
+    ++applied;
+  }
+
+  for (const TilePlacement& p : changes.placements) {
+    TileGroup* group = GroupForType(p.type);
+    if (!group) continue;
+
+    const long long key = makeTileKey(p.x, p.y);
+    auto& cell = tileLookup[key];
+    auto found = std::find_if(cell.begin(), cell.end(), [&](const Tile* t) { return t->getType() == p.type; });
+    if (record) record->push_back({ p.x, p.y, p.type, found != cell.end() ? (*found)->getTileIndex() : -1, p.index });
+    MarkDirty(p.type);
+    if (found != cell.end()) detach(*found, cell);
+
+    Tile* tile = TileFactory::createTile(p.type, { static_cast<float>(p.x), static_cast<float>(p.y) }, p.index);
+    cell.push_back(tile);
+    group->push_back(tile);
+    if (p.type == TILE_TYPE_TERRAIN) terrainCells.push_back(key);
+    ++applied;
+  }
+
+  // Grupperne gennemløbes én gang hver i stedet for én erase per tile
+  if (!doomed.empty()) {
+    std::sort(doomed.begin(), doomed.end());
+    auto isDoomed = [&](Tile* t) { return std::binary_search(doomed.begin(), doomed.end(), t); };
+    for (TileGroup* group : touchedGroups) {
+      group->erase(std::remove_if(group->begin(), group->end(), isDoomed), group->end());
+    }
+    for (Tile* t : doomed) delete t;
+  }
+
+  // Ved kopieret indhold er terrain med placeret terrain på alle fire sider allerede rigtigt
+  Memory::FrameVector<long long> placedTerrain = Memory::FrameArena::vector<long long>();
+  if (changes.keepTerrainIndex) {
+    for (const TilePlacement& p : changes.placements) {
+      if (p.type == TILE_TYPE_TERRAIN) placedTerrain.push_back(makeTileKey(p.x, p.y));
+    }
+    std::sort(placedTerrain.begin(), placedTerrain.end());
+  }
+  auto isInterior = [&](int x, int y) {
+    auto placed = [&](int ax, int ay) { return std::binary_search(placedTerrain.begin(), placedTerrain.end(), makeTileKey(ax, ay)); };
+    return placed(x, y) && placed(x, y - 1) && placed(x + 1, y) && placed(x, y + 1) && placed(x - 1, y);
+  };
+
+  // Ét autotile pass: hver berørt celle og dens naboer genberegnes én gang
+  if (!terrainCells.empty()) {
+    Memory::FrameVector<long long> recalc = Memory::FrameArena::vector<long long>();
+    recalc.reserve(terrainCells.size() * 5);
+    for (long long key : terrainCells) {
+      const int x = KeyX(key);
+      const int y = KeyY(key);
+      if (!placedTerrain.empty() && isInterior(x, y)) continue;
+      recalc.push_back(key);
+      recalc.push_back(makeTileKey(x, y - 1));
+      recalc.push_back(makeTileKey(x + 1, y));
+      recalc.push_back(makeTileKey(x, y + 1));
+      recalc.push_back(makeTileKey(x - 1, y));
+    }
+    std::sort(recalc.begin(), recalc.end());
+    recalc.erase(std::unique(recalc.begin(), recalc.end()), recalc.end());
+    for (long long key : recalc) AutotileRecalcAt(KeyX(key), KeyY(key));
+  }
+
+  return applied;
+}
+
+bool Tiles::CheckInvariants(std::string& error) const {
+  const std::pair<const TileGroup*, TileType> typedGroups[] = {
+    { &terrainTiles,     TILE_TYPE_TERRAIN },
+    { &crateTiles,       TILE_TYPE_CRATE },
+    { &grassTiles,       TILE_TYPE_GRASS },
+    { &playerSetupTiles, TILE_TYPE_PLAYER_SETUP },
+    { &enemyTiles,       TILE_TYPE_ENEMY },
+    { &coinsTiles,       TILE_TYPE_COIN },
+    { &fgPalmsTiles,     TILE_TYPE_FG_PALM },
+    { &bgPalmsTiles,     TILE_TYPE_BG_PALM },
+    { &constraintTiles,  TILE_TYPE_CONSTRAINT }
+  };
+
+  // Grupper: rigtig type, ingen dubletter, og hver tile findes i lookup under sin position
+  std::unordered_set<const Tile*> inGroups;
+  for (const auto& [group, type] : typedGroups) {
+    for (const Tile* t : *group) {
+      if (!t) { error = "nullptr i en tile gruppe"; return false; }
+
+      const int x = static_cast<int>(t->position.x);
+      const int y = static_cast<int>(t->position.y);
+      if (t->getType() != type) {
+        error = std::format("tile ({}, {}) af type {} ligger i gruppen for type {}", x, y, (int)t->getType(), (int)type);
+        return false;
+      }
+      if (!inGroups.insert(t).second) {
+        error = std::format("tile ({}, {}) ligger i flere grupper eller to gange i samme", x, y);
+        return false;
+      }
+
+      auto it = tileLookup.find(makeTileKey(x, y));
+      if (it == tileLookup.end() || std::find(it->second.begin(), it->second.end(), t) == it->second.end()) {
+        error = std::format("tile ({}, {}) mangler i tileLookup", x, y);
+        return false;
+      }
+    }
+  }
+
+  // Lookup: ingen tomme celler, ingen døde pointers, højst én tile per type per celle
+  size_t inLookup = 0;
+  for (const auto& [key, cell] : tileLookup) {
+    if (cell.empty()) { error = "tom celle i tileLookup"; return false; }
+
+    for (size_t i = 0; i < cell.size(); ++i) {
+      const Tile* t = cell[i];
+      const int x = static_cast<int>(t->position.x);
+      const int y = static_cast<int>(t->position.y);
+      if (!inGroups.count(t)) {
+        error = std::format("tileLookup peger på en tile ({}, {}) der ikke er i nogen gruppe", x, y);
+        return false;
+      }
+      if (makeTileKey(x, y) != key) {
+        error = std::format("tile ({}, {}) ligger under forkert nøgle i tileLookup", x, y);
+        return false;
+      }
+      for (size_t j = 0; j < i; ++j) {
+        if (cell[j]->getType() == t->getType()) {
+          error = std::format("to tiles af type {} på ({}, {})", (int)t->getType(), x, y);
+          return false;
+        }
+      }
+    }
+    inLookup += cell.size();
+  }
+
+  if (inLookup != inGroups.size()) {
+    error = std::format("{} tiles i grupper men {} i tileLookup", inGroups.size(), inLookup);
+    return false;
+  }
+
+  // Autotile: hver terrain tile skal have samme index som en genberegning fra bunden
+  for (const Tile* t : terrainTiles) {
+    const int x = static_cast<int>(t->position.x);
+    const int y = static_cast<int>(t->position.y);
+    const int expected = ComputeTerrainIndex(x, y);
+    if (t->getTileIndex() != expected) {
+      error = std::format("terrain ({}, {}) har index {} men autotile giver {}", x, y, t->getTileIndex(), expected);
+      return false;
+    }
+  }
+
+  return true;
 }
 
 Tiles::Tiles(Tiles&& other) noexcept
@@ -301,6 +677,7 @@ Tiles::Tiles(Tiles&& other) noexcept
   , bgPalmsTiles(std::move(other.bgPalmsTiles))
   , constraintTiles(std::move(other.constraintTiles))
   , tileLookup(std::move(other.tileLookup))
+  , dirtyTypes(other.dirtyTypes)
 {
   rebuildPointers_();
 }
@@ -317,6 +694,7 @@ Tiles& Tiles::operator=(Tiles&& other) noexcept {
     bgPalmsTiles      = std::move(other.bgPalmsTiles);
     constraintTiles   = std::move(other.constraintTiles);
     tileLookup        = std::move(other.tileLookup);
+    dirtyTypes        = other.dirtyTypes;
     rebuildPointers_();
   }
   return *this;
@@ -351,10 +729,19 @@ void Tiles::AutotileRecalcNeighborsAround(int x, int y) {
 }
 
 void Tiles::AutotileAllTerrain() {
-  for (auto* t : terrainTiles) {
-    int gx = static_cast<int>(t->position.x);
-    int gy = static_cast<int>(t->position.y);
-    AutotileRecalcAt(gx, gy);
+  PROFILE_SCOPE("Tiles::AutotileAllTerrain");
+  // Index beregnes parallelt (kun læsning af tileLookup) og sættes bagefter på denne tråd,
+  // da setTileIndex spørger SDL om texturens størrelse
+  std::vector<int> indices(terrainTiles.size());
+  Jobs::ParallelFor("AutotileAllTerrain", terrainTiles.size(), AUTOTILE_GRAIN, [&](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+      const Tile* t = terrainTiles[i];
+      indices[i] = ComputeTerrainIndex(static_cast<int>(t->position.x), static_cast<int>(t->position.y));
+    }
+  });
+
+  for (size_t i = 0; i < terrainTiles.size(); ++i) {
+    terrainTiles[i]->setTileIndex(indices[i]);
   }
 }
 
@@ -371,51 +758,61 @@ void DrawTileGroup(const TileGroup& group, SDL_Renderer* renderer) {
   }
 }
 
+namespace {
+  // Lagene i en Layout og deres navn i filnavnet
+  const std::pair<Utils::TileLayer Layout::*, const char*> LAYOUT_FILES[] = {
+    { &Layout::bgPalmsLayout,     "bg_palms" },
+    { &Layout::coinsLayout,       "coins" },
+    { &Layout::constraintsLayout, "constraints" },
+    { &Layout::cratesLayout,      "crates" },
+    { &Layout::enemiesLayout,     "enemies" },
+    { &Layout::fgPalmsLayout,     "fg_palms" },
+    { &Layout::grassLayout,       "grass" },
+    { &Layout::playerSetupLayout, "player" },
+    { &Layout::terrainLayout,     "terrain" },
+  };
+
+  /* Hver CSV parses som sit eget job - de er uafhængige, og parsing er det dyre ved en load */
+  template <typename LoadFn>
+  void LoadLayoutFiles(Layout& layout, const LoadFn& load) {
+    Jobs::ParallelFor("LoadLayoutFiles", std::size(LAYOUT_FILES), 1, [&](size_t begin, size_t end) {
+      for (size_t i = begin; i < end; ++i) {
+        layout.*LAYOUT_FILES[i].first = load(LAYOUT_FILES[i].second);
+      }
+    });
+
+    // Samme fil som constraintsLayout - læses kun én gang
+    layout.constraintLayout = layout.constraintsLayout;
+  }
+}
+
 Layout::Layout(unsigned int level) {
-  bgPalmsLayout     = LoadLevelLayout(level, "bg_palms");
-  coinsLayout       = LoadLevelLayout(level, "coins");
-  constraintsLayout = LoadLevelLayout(level, "constraints");
-  cratesLayout      = LoadLevelLayout(level, "crates");
-  enemiesLayout     = LoadLevelLayout(level, "enemies");
-  fgPalmsLayout     = LoadLevelLayout(level, "fg_palms");
-  grassLayout       = LoadLevelLayout(level, "grass");
-  playerSetupLayout = LoadLevelLayout(level, "player");
-  terrainLayout     = LoadLevelLayout(level, "terrain");
-  constraintLayout  = LoadLevelLayout(level, "constraints");
+  LoadLayoutFiles(*this, [&](const char* name) { return LoadLevelLayout(level, name); });
 }
 
 Utils::TileLayer Layout::LoadLevelLayout(unsigned int level, const std::string& name) {
   Utils::TileLayer result = Utils::LoadCSVFile(std::format("levels/{0}/level_{0}_{1}.csv", level, name));
   if(result.empty()) {
-    Log::Error("Kunne ikke validere resultat fra Utils::LoadCSVFile ({})", name);
+    Log::Error(Log::Category::Scene, "Kunne ikke validere resultat fra Utils::LoadCSVFile ({})", name);
     return {};
   }
 
   return result;
 }
 
-Utils::TileLayer Layout::LoadSceneLayout(const std::string &sceneName, const std::string &suffix) {
-  std::filesystem::path p = std::filesystem::path("scenes") / sceneName / (sceneName + "_" + suffix + ".csv");
+Utils::TileLayer Layout::LoadSceneLayout(const std::string &sceneName, const std::string &suffix, const std::filesystem::path& root) {
+  std::filesystem::path p = root / sceneName / (sceneName + "_" + suffix + ".csv");
   Utils::TileLayer result = Utils::LoadCSVFile(p.string());
   if(result.empty()) {
-    Log::Error("Kunne ikke indlæse scene fra CSV: {}", p.string());
+    Log::Error(Log::Category::Scene, "Kunne ikke indlæse scene fra CSV: {}", p.string());
     return {};
   }
 
   return result;
 }
 
-Layout::Layout(const std::string& sceneName) {
-  bgPalmsLayout     = LoadSceneLayout(sceneName, "bg_palms");
-  coinsLayout       = LoadSceneLayout(sceneName, "coins");
-  constraintsLayout = LoadSceneLayout(sceneName, "constraints");
-  cratesLayout      = LoadSceneLayout(sceneName, "crates");
-  enemiesLayout     = LoadSceneLayout(sceneName, "enemies");
-  fgPalmsLayout     = LoadSceneLayout(sceneName, "fg_palms");
-  grassLayout       = LoadSceneLayout(sceneName, "grass");
-  playerSetupLayout = LoadSceneLayout(sceneName, "player");
-  terrainLayout     = LoadSceneLayout(sceneName, "terrain");
-  constraintLayout  = LoadSceneLayout(sceneName, "constraints");
+Layout::Layout(const std::string& sceneName, const std::filesystem::path& root) {
+  LoadLayoutFiles(*this, [&](const char* name) { return LoadSceneLayout(sceneName, name, root); });
 }
 
 Tiles::Tiles(const Layout& layout) {
@@ -462,6 +859,7 @@ TileGroup Tiles::LoadTiles(TileType type, const Utils::TileLayer& layout, std::u
 }
 
 void Tiles::UpdateTiles(SDL_State &state, float mapHeight, float cameraX) {
+  PROFILE_SCOPE("Tiles::UpdateTiles");
   float mapOffsetY = state.windowHeight - mapHeight;
   if(mapOffsetY < 0) mapOffsetY = 0; // hvis vinduet er mindre end map
 
@@ -472,6 +870,8 @@ void Tiles::UpdateTiles(SDL_State &state, float mapHeight, float cameraX) {
 }
 
 void Tiles::DrawTiles(SDL_Renderer* renderer) const {
+  PROFILE_SCOPE("Tiles::DrawTiles");
+  Render::SubsystemScope renderScope(Render::Subsystem::Tiles);
   for(const auto* group : allGroups) {
     DrawTileGroup(*group, renderer);
   }
@@ -490,42 +890,28 @@ void Tiles::RemoveTile(int gridX, int gridY, int layerIndex) {
 
   auto& targetGroups = layerGroups[layerIndex];
 
-  // Alle tiles i layerIndex der matcher positionen
-  std::vector<Tile*> toRemove;
-  for (auto* group : targetGroups) {
-      auto& g = *group;
-      for (auto* tile : g) {
-          if ((int)tile->position.x == gridX && (int)tile->position.y == gridY) {
-              toRemove.push_back(tile);
-          }
-      }
+  // Cellen har højst én tile per type, så tiles i laget kan fjernes direkte fra cellen
+  // uden en midlertidig liste (sletning med Delete holdt nede kører hver frame)
+  for (size_t i = tilesAtPos.size(); i-- > 0;) {
+    Tile* tile = tilesAtPos[i];
+    TileGroup* group = GroupForType(tile->getType());
+    if (std::find(targetGroups.begin(), targetGroups.end(), group) == targetGroups.end()) continue;
+
+    group->erase(std::remove(group->begin(), group->end(), tile), group->end());
+    tilesAtPos.erase(tilesAtPos.begin() + i);
+    MarkDirty(tile->getType());
+    delete tile;
   }
 
-  // Fjern fra groups
-  for (auto* group : targetGroups) {
-      auto& g = *group;
-      g.erase(std::remove_if(g.begin(), g.end(), [&](Tile* t) {
-          return std::find(toRemove.begin(), toRemove.end(), t) != toRemove.end();
-      }), g.end());
-  }
-
-  // Fjern fra lookup
-  tilesAtPos.erase(std::remove_if(tilesAtPos.begin(), tilesAtPos.end(),
-    [&](Tile* t) {
-      return std::find(toRemove.begin(), toRemove.end(), t) != toRemove.end();
-    }),
-    tilesAtPos.end());
-
   if (tilesAtPos.empty())
     tileLookup.erase(it);
-
-  for (auto* t : toRemove)
-    delete t;
 }
 
 
 
 void Tiles::DrawTiles(SDL_Renderer* renderer, int visibleLayer) const {
+  PROFILE_SCOPE("Tiles::DrawTiles");
+  Render::SubsystemScope renderScope(Render::Subsystem::Tiles);
   const Uint8 activeAlpha = 255;
   const Uint8 inactiveAlpha = 80;
 
@@ -553,11 +939,11 @@ void Tiles::DrawTiles(SDL_Renderer* renderer, int visibleLayer) const {
 
         Uint8 oldAlpha = 255;
         SDL_GetTextureAlphaMod(tile->texture, &oldAlpha);
-        SDL_SetTextureAlphaMod(tile->texture, layerAlpha);
+        Render::SetTextureAlphaMod(tile->texture, layerAlpha);
 
         tile->draw(renderer);
 
-        SDL_SetTextureAlphaMod(tile->texture, oldAlpha);
+        Render::SetTextureAlphaMod(tile->texture, oldAlpha);
       }
     }
   }
@@ -570,28 +956,43 @@ Manager::Manager(unsigned int level, const std::string& name)
   , layout(Layout(level))
   , tiles(Tiles(layout))
 {
-  Log::Info("Indlæste scene \"{}\" successfuldt", name);
+  Log::Info(Log::Category::Scene, "Indlæste scene \"{}\" successfuldt", name);
 }
 
-void Manager::update(SDL_State& state, bool lockCamera) noexcept {
-  bg.update(state);
+Manager::Manager(Layout sceneLayout, const std::string& name)
+  : name(name)
+  , level(0)
+  , layout(std::move(sceneLayout))
+  , tiles(Tiles(layout))
+{
+  Log::Info(Log::Category::Scene, "Oprettede scene \"{}\" fra layout", name);
+}
+
+void Manager::fixedUpdate(SDL_State& state, float dt, bool lockCamera) noexcept {
+  bg.fixedUpdate(state, dt);
 
-  state.cameraX = 0.0f;
+  state.cameraPrevStepPos = state.cameraStepPos;
   if(!lockCamera) {
-    if((state.keyState[SDL_SCANCODE_RIGHT] || state.keyState[SDL_SCANCODE_D]) && state.cameraPos.x < 3072) {
-      state.cameraX += scrollSpeed * state.deltaTime;
+    if((state.keyState[SDL_SCANCODE_RIGHT] || state.keyState[SDL_SCANCODE_D]) && state.cameraStepPos.x < 3072) {
+      state.cameraStepPos.x += scrollSpeed * dt;
     }
 
-    if((state.keyState[SDL_SCANCODE_LEFT] || state.keyState[SDL_SCANCODE_A]) && state.cameraPos.x > -512) {
-      state.cameraX -= scrollSpeed * state.deltaTime;
+    if((state.keyState[SDL_SCANCODE_LEFT] || state.keyState[SDL_SCANCODE_A]) && state.cameraStepPos.x > -512) {
+      state.cameraStepPos.x -= scrollSpeed * dt;
     }
   }
+}
+
+void Manager::update(SDL_State& state) noexcept {
+  PROFILE_SCOPE("Manager::update");
+  bg.update(state);
 
   float mapHeight = layout.terrainLayout.size() * TILE_SIZE;
   tiles.UpdateTiles(state, mapHeight, state.cameraPos.x);
 };
 
 void Manager::draw(SDL_Renderer* renderer, int visibleLayer) const noexcept {
+  PROFILE_SCOPE("Manager::draw");
   SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
   bg.render(renderer);
   tiles.DrawTiles(renderer, visibleLayer);
@@ -599,24 +1000,33 @@ void Manager::draw(SDL_Renderer* renderer, int visibleLayer) const noexcept {
 
 void Manager::addTileToLayer(Tile* tile, int layerIndex) {
   if (!tile) return;
-  if (layerIndex < 0 || layerIndex >= (int)tiles.layerGroups.size()) return;
+  if (layerIndex < 0 || layerIndex >= (int)tiles.layerGroups.size()) {
+    delete tile;
+    return;
+  }
 
-  switch (tile->getType()) {
-    case TILE_TYPE_TERRAIN:       tiles.terrainTiles.push_back(tile); break;
-    case TILE_TYPE_CRATE:         tiles.crateTiles.push_back(tile); break;
-    case TILE_TYPE_GRASS:         tiles.grassTiles.push_back(tile); break;
-    case TILE_TYPE_PLAYER_SETUP:  tiles.playerSetupTiles.push_back(tile); break;
-    case TILE_TYPE_ENEMY:         tiles.enemyTiles.push_back(tile); break;
-    case TILE_TYPE_COIN:          tiles.coinsTiles.push_back(tile); break;
-    case TILE_TYPE_FG_PALM:       tiles.fgPalmsTiles.push_back(tile); break;
-    case TILE_TYPE_BG_PALM:       tiles.bgPalmsTiles.push_back(tile); break;
-    case TILE_TYPE_CONSTRAINT:    tiles.constraintTiles.push_back(tile); break;
-    default: break;
+  TileGroup* group = tiles.GroupForType(tile->getType());
+  if (!group) {
+    Log::Warn(Log::Category::Scene, "Kan ikke placere tile af type {}", (int)tile->getType());
+    delete tile;
+    return;
   }
 
   // Beregn GRID koordinater
   const int gx = static_cast<int>(tile->position.x);
   const int gy = static_cast<int>(tile->position.y);
+
+  // Højst én tile af hver type per celle - en ny erstatter den gamle
+  Tile* existing = tiles.GetTileOfType(gx, gy, tile->getType());
+  if (recording()) {
+    record({ { gx, gy, tile->getType(), existing ? existing->getTileIndex() : -1, tile->getTileIndex() } });
+  }
+  if (existing) {
+    tiles.EraseTile(existing);
+  }
+
+  group->push_back(tile);
+  tiles.MarkDirty(tile->getType());
   long long key = Tiles::makeTileKey(gx, gy);
   tiles.tileLookup[key].push_back(tile);
 
@@ -627,7 +1037,26 @@ void Manager::addTileToLayer(Tile* tile, int layerIndex) {
 }
 
 
+void Manager::recordRemoval(int gridX, int gridY, int layerIndex) {
+  if (!recording() || layerIndex < 0 || layerIndex >= (int)tiles.layerGroups.size()) return;
+
+  Selection cell;
+  cell.set({ gridX, gridY, 1, 1 });
+  std::vector<TilePlacement> removed;
+  tiles.CollectRegion(cell, layerIndex, removed);
+
+  std::vector<CellDelta> deltas;
+  for (const TilePlacement& t : removed) deltas.push_back({ t.x, t.y, t.type, t.index, -1 });
+  record(deltas);
+}
+
+void Manager::record(const std::vector<CellDelta>& deltas) {
+  if (history) history->record(deltas);
+  if (journal) journal->append(deltas);
+}
+
 void Manager::removeTileAt(int gridX, int gridY, int layerIndex) {
+  recordRemoval(gridX, gridY, layerIndex);
   // Husk om der var terrain her, så vi ved om vi skal autotile naboer bagefter
   Tile* before = tiles.GetTileOfType(gridX, gridY, TILE_TYPE_TERRAIN);
   tiles.RemoveTile(gridX, gridY, layerIndex);
@@ -637,6 +1066,7 @@ void Manager::removeTileAt(int gridX, int gridY, int layerIndex) {
 }
 
 void Manager::removeLayerTiles(int gridX, int gridY, int layerIndex) {
+  recordRemoval(gridX, gridY, layerIndex);
   Tile* before = tiles.GetTileOfType(gridX, gridY, TILE_TYPE_TERRAIN);
   tiles.RemoveTile(gridX, gridY, layerIndex);
   if (before) {
@@ -644,34 +1074,212 @@ void Manager::removeLayerTiles(int gridX, int gridY, int layerIndex) {
   }
 }
 
-static void FreeTileGroup(TileGroup& g) {
-  for(auto* t : g) delete t;
-  g.clear();
+size_t Manager::applyChanges(const ChangeSet& changes) {
+  return commit(changes);
 }
 
-static void FreeAllTiles(Tiles& t) {
-  for(auto* group : t.allGroups) {
-    FreeTileGroup(*group);
+size_t Manager::commit(const ChangeSet& changes) {
+  if (!recording()) return tiles.ApplyChanges(changes);
+
+  std::vector<CellDelta> deltas;
+  const size_t applied = tiles.ApplyChanges(changes, &deltas);
+  record(deltas);
+  return applied;
+}
+
+size_t Manager::applyFromHistory(const ChangeSet& changes) {
+  if (!journal) return tiles.ApplyChanges(changes);
+
+  std::vector<CellDelta> deltas;
+  const size_t applied = tiles.ApplyChanges(changes, &deltas);
+  journal->append(deltas);
+  return applied;
+}
+
+size_t Manager::deleteRegion(const Selection& selection, int layerIndex) {
+  PROFILE_SCOPE("Manager::deleteRegion");
+  ChangeSet changes;
+  tiles.CollectRegion(selection, layerIndex, changes.removals);
+  return commit(changes);
+}
+
+size_t Manager::fillRegion(const Selection& selection, TileType type, int tileIndex) {
+  PROFILE_SCOPE("Manager::fillRegion");
+  if (!tiles.GroupForType(type)) {
+    Log::Warn(Log::Category::Scene, "Kan ikke fylde med tile af type {}", (int)type);
+    return 0;
   }
 
-  t.tileLookup.clear();
+  ChangeSet changes;
+  changes.placements.reserve(static_cast<size_t>(selection.cellCount()));
+  for (const CellRect& r : selection.rects()) {
+    for (int y = r.y; y < r.y + r.h; ++y) {
+      for (int x = r.x; x < r.x + r.w; ++x) {
+        if (tiles.IsPlaced(x, y, type, tileIndex)) continue;
+        changes.placements.push_back({ x, y, type, tileIndex });
+      }
+    }
+  }
+  return commit(changes);
 }
 
-void Manager::loadSceneFromFolder(const std::string& sceneName) {
-  Layout newLayout(sceneName);
+size_t Manager::moveRegion(const Selection& selection, int layerIndex, int dx, int dy) {
+  PROFILE_SCOPE("Manager::moveRegion");
+  if (dx == 0 && dy == 0) return 0;
 
-  if(newLayout.terrainLayout.empty()) {
-    Log::Warn("Scene '{}' er tom - initialiserer som en ny scene", sceneName);
+  ChangeSet changes;
+  tiles.CollectRegion(selection, layerIndex, changes.removals);
+  changes.placements.reserve(changes.removals.size());
+  changes.keepTerrainIndex = true;
+  for (const TilePlacement& t : changes.removals) {
+    changes.placements.push_back({ t.x + dx, t.y + dy, t.type, t.index });
   }
+  return commit(changes);
+}
 
-  FreeAllTiles(tiles);
+std::vector<TilePlacement> Manager::copyRegion(const Selection& selection, int layerIndex) const {
+  std::vector<TilePlacement> copied;
+  tiles.CollectRegion(selection, layerIndex, copied);
 
-  layout = std::move(newLayout);
-  tiles = Tiles(layout);
-  tiles.AutotileAllTerrain();
+  const CellRect origin = selection.bounds();
+  for (TilePlacement& t : copied) {
+    t.x -= origin.x;
+    t.y -= origin.y;
+  }
+  return copied;
+}
+
+size_t Manager::pasteRegion(const std::vector<TilePlacement>& copied, int originX, int originY) {
+  PROFILE_SCOPE("Manager::pasteRegion");
+  ChangeSet changes;
+  changes.placements.reserve(copied.size());
+  changes.keepTerrainIndex = true;
+  for (const TilePlacement& t : copied) {
+    changes.placements.push_back({ originX + t.x, originY + t.y, t.type, t.index });
+  }
+  return commit(changes);
+}
+
+size_t Manager::floodFill(int startX, int startY, TileType type, int tileIndex) {
+  PROFILE_SCOPE("Manager::floodFill");
+  if (!tiles.GroupForType(type)) return 0;
+
+  // Øverste række er ikke en del af banen
+  const Vec2<int> size = sceneSize();
+  const CellRect bounds { 0, 1, size.x, size.y - 1 };
+  if (!bounds.contains(startX, startY) || tiles.HasTileOfType(startX, startY, type)) return 0;
+
+  // Scratch i frame arenaen - lever kun under kaldet
+  Memory::FrameVector<std::uint8_t> visited(static_cast<size_t>(bounds.area()), 0, Memory::FrameArena::resource());
+  auto cell = [&](int x, int y) -> std::uint8_t& {
+    return visited[static_cast<size_t>(y - bounds.y) * bounds.w + (x - bounds.x)];
+  };
+  auto open = [&](int x, int y) { return !cell(x, y) && !tiles.HasTileOfType(x, y, type); };
+
+  ChangeSet changes;
+  Memory::FrameVector<std::pair<int, int>> pending = Memory::FrameArena::vector<std::pair<int, int>>();
+  pending.push_back({ startX, startY });
+  while (!pending.empty()) {
+    const auto [x, y] = pending.back();
+    pending.pop_back();
+    if (!open(x, y)) continue;
+
+    // Hele det åbne stykke af rækken på én gang
+    int left = x, right = x;
+    while (left > bounds.x && open(left - 1, y)) --left;
+    while (right + 1 < bounds.x + bounds.w && open(right + 1, y)) ++right;
+    for (int cx = left; cx <= right; ++cx) {
+      cell(cx, y) = 1;
+      changes.placements.push_back({ cx, y, type, tileIndex });
+    }
+
+    // Første celle i hvert åbne stykke over og under bliver næste seed
+    for (int ny : { y - 1, y + 1 }) {
+      if (ny < bounds.y || ny >= bounds.y + bounds.h) continue;
+      bool inRun = false;
+      for (int cx = left; cx <= right; ++cx) {
+        const bool isOpen = open(cx, ny);
+        if (isOpen && !inRun) pending.push_back({ cx, ny });
+        inRun = isOpen;
+      }
+    }
+  }
+
+  return commit(changes);
+}
+
+void Manager::loadSceneFromFolder(const std::string& sceneName, const std::filesystem::path& root) {
+  TRACE_SCOPE_DETAIL("Manager::loadSceneFromFolder", "scene", sceneName);
+
+  Layout newLayout = [&] { TRACE_SCOPE("Layout", "scene"); return Layout(sceneName, root); }();
+
+  // Den forrige scenes ventende records skrives inden journalen (måske den samme) læses
+  if (journal) journal->close();
+
+  if(newLayout.terrainLayout.empty()) {
+    Log::Warn(Log::Category::Scene, "Scene '{}' er tom - initialiserer som en ny scene", sceneName);
+  }
+
+  replaceLayout(std::move(newLayout));
 
   name = sceneName;
-  Log::Info("Scene '{}' indlæst fra 'scenes/{}'", name, sceneName);
+  savedDir = root / sceneName;
+  savedSize = sceneSize();
+  // Saves der stadig kører er af den forrige indlæsning og må ikke checkpointe den nye journal
+  checkpointFrom = snapshotCount + 1;
+  if (history) history->clear();
+
+  if (journal) {
+    // Ændringer siden sidste save (eller før et crash) lægges oven på CSV filerne
+    ChangeSet replayed;
+    const JournalReplay replay = Journal::Replay(savedDir, replayed);
+    if (!replayed.empty()) {
+      tiles.ApplyChanges(replayed);
+      Log::Info(Log::Category::Scene, "Journal: {} celler fra {} ændringer genskabt i '{}'", replay.cells, replay.records, sceneName);
+    }
+    journal->open(savedDir, replay.validBytes);
+
+    if (replay.validBytes > Journal::COMPACT_BYTES) {
+      Log::Info(Log::Category::Scene, "Journal for '{}' er {} bytes - gemmer scenen og tømmer den", sceneName, replay.validBytes);
+      saveScene(sceneName, root);
+    }
+  }
+  Log::Info(Log::Category::Scene, "Scene '{}' indlæst fra '{}'", name, (root / sceneName).string());
+}
+
+void Manager::loadLevel(unsigned int levelNumber) {
+  TRACE_SCOPE_DETAIL("Manager::loadLevel", "scene", std::to_string(levelNumber));
+
+  Layout newLayout = [&] { TRACE_SCOPE("Layout", "scene"); return Layout(levelNumber); }();
+  if (newLayout.terrainLayout.empty()) {
+    Log::Warn(Log::Category::Scene, "Level {} er tomt", levelNumber);
+  }
+
+  // Levels gemmes som scener (save-as), så der er ingen journal for dem
+  if (journal) journal->close();
+  replaceLayout(std::move(newLayout));
+
+  level = levelNumber;
+  name = std::format("level_{}", levelNumber);
+  savedDir.clear();
+  savedSize = sceneSize();
+  checkpointFrom = snapshotCount + 1;
+  if (history) history->clear();
+  Log::Info(Log::Category::Scene, "Level {} indlæst", levelNumber);
+}
+
+void Manager::replaceLayout(Layout newLayout) {
+  {
+    TRACE_SCOPE("FreeAllTiles", "scene");
+    FreeAllTiles(tiles);
+  }
+
+  layout = std::move(newLayout);
+  {
+    // Tiles konstruktøren autotiler allerede alt terrain
+    TRACE_SCOPE("Tiles", "scene");
+    tiles = Tiles(layout);
+  }
 }
 
 Tile* Manager::getTileAt(int gridX, int gridY) {
@@ -12,6 +12,11 @@
 #include "utils/utils.hpp"
 #include "sdl/SDL_Handler.hpp"
 #include "Background.hpp"
+#include "Selection.hpp"
+#include "History.hpp"
+#include "Journal.hpp"
+#include "SceneSaver.hpp"
+#include "profiling/Profiler.hpp"
 
 #include "SDL3/SDL_blendmode.h"
 #include "SDL3/SDL_events.h"
@@ -23,12 +28,44 @@
 namespace Scene {
   using TileGroup = std::vector<Tile*>;
 
+  // Størrelsen på en ny/tom scene
+  constexpr int DEFAULT_SCENE_WIDTH  = 60;
+  constexpr int DEFAULT_SCENE_HEIGHT = 11;
+
   void UpdateTileGroup(TileGroup& group, float mapOffsetY, float cameraX);
   void DrawTileGroup(TileGroup& group, SDL_Renderer* renderer);
 
   static void RenderMiniBackground(SDL_Renderer* renderer, int mapW, int mapH);
+  bool WriteCSV(const std::filesystem::path& filePath, const Utils::TileLayer& data);
+  /* Skriver til <fil>.tmp og omdøber over filen, så den aldrig står halvt skrevet */
+  bool WriteFileAtomic(const std::filesystem::path& filePath, const std::function<void(std::ostream&)>& write, bool binary = false);
   SDL_Texture* BuildSceneThumbnail(SDL_Renderer* renderer, const std::string& sceneName, int thumbW = 240, int thumbH = 135);
 
+/* Én tile beskrevet ved værdi - celle, type og tileset index */
+struct TilePlacement {
+  int x = 0;
+  int y = 0;
+  TileType type = TILE_TYPE_TERRAIN;
+  int index = 0;
+};
+
+/*
+ * En samlet ændring af scenen. Fjernelser (identificeret ved celle og type - der er højst
+ * én tile per type per celle) anvendes før placeringer, og en placering erstatter en
+ * eksisterende tile af samme type. Hele sættet anvendes med én opdatering af grupperne
+ * og ét autotile pass over de berørte celler.
+ */
+struct ChangeSet {
+  std::vector<TilePlacement> removals;
+  std::vector<TilePlacement> placements;
+  // Placeringerne er kopieret fra en konsistent scene (paste, flyt): terrain der er omgivet af
+  // placeret terrain beholder sit index, og autotile kører kun langs kanten af det indsatte
+  bool keepTerrainIndex = false;
+
+  bool empty() const { return removals.empty() && placements.empty(); }
+  void clear() { removals.clear(); placements.clear(); keepTerrainIndex = false; }
+};
+
 struct Layout {
   Utils::TileLayer bgPalmsLayout;
   Utils::TileLayer coinsLayout;
@@ -42,12 +79,16 @@ struct Layout {
   Utils::TileLayer constraintLayout;
 
   [[nodiscard]] static Utils::TileLayer LoadLevelLayout(unsigned int level, const std::string& name);
-  [[nodiscard]] static Utils::TileLayer LoadSceneLayout(const std::string& sceneName, const std::string& suffix);
+  [[nodiscard]] static Utils::TileLayer LoadSceneLayout(const std::string& sceneName, const std::string& suffix, const std::filesystem::path& root = "scenes");
 
+  Layout() = default;
   explicit Layout(unsigned int level);
-  explicit Layout(const std::string& sceneName);
+  explicit Layout(const std::string& sceneName, const std::filesystem::path& root = "scenes");
 };
 
+/* Kun rendering delen - Layout kan indlæses på en anden tråd, resten skal på render tråden */
+SDL_Texture* BuildSceneThumbnail(SDL_Renderer* renderer, const Layout& layout, const std::string& sceneName, int thumbW = 240, int thumbH = 135);
+
 struct Tiles {
   TileGroup terrainTiles;
   TileGroup crateTiles;
@@ -88,12 +129,47 @@ struct Tiles {
   static inline long long makeTileKey(int x, int y);
   Tile* GetTile(int gridX, int gridY);
 
-  Tile* GetTileOfType(int gridX, int gridY, TileType type);
-  bool HasTileOfType(int gridX, int gridY, TileType type);
+  Tile* GetTileOfType(int gridX, int gridY, TileType type) const;
+  bool HasTileOfType(int gridX, int gridY, TileType type) const;
+  /* Cellen har allerede præcis den tile (terrain index styres af autotile, så kun typen tæller) */
+  bool IsPlaced(int gridX, int gridY, TileType type, int tileIndex) const;
+
+  /* Gruppen en tile af typen hører til (nullptr for typer der ikke kan placeres) */
+  TileGroup* GroupForType(TileType type);
+
+  /* Fjerner én bestemt tile fra gruppe og lookup og sletter den */
+  void EraseTile(Tile* tile);
+
+  /* Bit per TileType hvis CSV ikke matcher scenen længere - sættes af alle mutationer */
+  std::uint32_t dirtyTypes = 0;
+  void MarkDirty(TileType type) { dirtyTypes |= 1u << type; }
 
+  /* Laget (0-2) typen tegnes i, -1 for typer der ikke kan placeres */
+  int LayerForType(TileType type) const;
+
+  /*
+   * De tiles der findes i markeringen (layerIndex -1 = alle lag). Kigger kun på optagede
+   * celler: små rects slås op celle for celle, store gennemløber lookup i stedet.
+   */
+  void CollectRegion(const Selection& selection, int layerIndex, std::vector<TilePlacement>& out) const;
+
+  /* Anvender hele sættet som én mutation. Returnerer antal tiles fjernet + placeret.
+     record får én CellDelta per ændret tile (til undo) */
+  size_t ApplyChanges(const ChangeSet& changes, std::vector<CellDelta>* record = nullptr);
+
+  /*
+   * Tjekker at grupper, tileLookup og autotile indices er enige. Returnerer false
+   * og en beskrivelse af den første fejl. Dyr - bruges af stress tests, ikke per frame.
+   */
+  bool CheckInvariants(std::string& error) const;
+
+  /* Det index autotile ville give terrain på (x, y) */
+  int ComputeTerrainIndex(int x, int y) const;
   void AutotileRecalcAt(int x, int y);
   void AutotileRecalcNeighborsAround(int x, int y);
+  /* Fordeles over job systemet i bidder af AUTOTILE_GRAIN tiles */
   void AutotileAllTerrain();
+  static constexpr size_t AUTOTILE_GRAIN = 2048;
 
   static int Make4BitMask(int x, int y, std::function<bool(int, int)> isSame);
   static const std::array<int, 16> TERRAIN_16_MAP;
@@ -112,25 +188,69 @@ private:
 class Manager {
   public:
     Manager(unsigned int level, const std::string& name);
+    Manager(Layout layout, const std::string& name);
     ~Manager() = default;
 
     Manager(const Manager&) = default;
     Manager(Manager&&) noexcept = default;
 
-    void update(SDL_State& state, bool lockCamera = false) noexcept;
+    /* Kamera og baggrund i faste skridt - lockCamera holder kameraet stille (dialoger) */
+    void fixedUpdate(SDL_State& state, float dt, bool lockCamera = false) noexcept;
+    /* Én gang per frame før draw: tiles placeres ud fra det interpolerede state.cameraPos */
+    void update(SDL_State& state) noexcept;
     void draw(SDL_Renderer* renderer, int visibleLayer = -1) const noexcept;
-    void saveScene(const std::string& sceneName);
+    /* Skriver alle lag med det samme på den kaldende tråd */
+    void saveScene(const std::string& sceneName, const std::filesystem::path& root = "scenes");
+    /*
+     * Kopi af de lag der er ændret siden sidste save til samme sted (alle ved et nyt navn eller
+     * en ny størrelse) til SceneSaver. Lagene regnes som gemt - resultatet skal gives til saveFinished
+     */
+    SaveSnapshot snapshotForSave(const std::string& sceneName, const std::filesystem::path& root = "scenes", bool all = false);
+    /*
+     * Fejlede lag markeres beskidte igen. Journalen komprimeres kun op til et mærke når alt
+     * journaliseret før det er skrevet - efter en fejl først når et snapshot taget bagefter lykkes
+     */
+    void saveFinished(const SaveResult& result);
+    void markDirty(std::uint32_t types) { tiles.dirtyTypes |= types; }
+    bool hasUnsavedChanges() const { return tiles.dirtyTypes != 0; }
 
     void addTileToLayer(Tile* tile, int layerIndex);
     void removeTileAt(int gridX, int gridY, int layerIndex);
     void removeLayerTiles(int gridX, int gridY, int layerIndex);
 
+    /* Region operationer - hver er én ChangeSet med ét autotile pass. layerIndex -1 = alle lag */
+    size_t applyChanges(const ChangeSet& changes);
+    size_t deleteRegion(const Selection& selection, int layerIndex);
+    size_t fillRegion(const Selection& selection, TileType type, int tileIndex);
+    size_t moveRegion(const Selection& selection, int layerIndex, int dx, int dy);
+    /* Tiles i markeringen med koordinater relativt til markeringens øverste venstre hjørne */
+    std::vector<TilePlacement> copyRegion(const Selection& selection, int layerIndex) const;
+    size_t pasteRegion(const std::vector<TilePlacement>& tiles, int originX, int originY);
+    /* Scanline flood fill af de sammenhængende celler uden en tile af typen, inden for scenen */
+    size_t floodFill(int startX, int startY, TileType type, int tileIndex);
+
+    /* Scenens størrelse i celler - mindst standardstørrelsen og altid stor nok til alle tiles */
+    Vec2<int> sceneSize() const;
+
+    /* Alle mutationer meldes ind i historikken når den er sat (nullptr = ingen undo) */
+    void setHistory(History* h) { history = h; }
+    History* getHistory() const { return history; }
+    /* Alle mutationer (også undo/redo) skrives til journalen når den er sat. Den åbnes af loadSceneFromFolder */
+    void setJournal(Journal* j) { journal = j; }
+    Journal* getJournal() const { return journal; }
+    /* Undo/redo: anvendes og journaliseres, men optages ikke i historikken */
+    size_t applyFromHistory(const ChangeSet& changes);
+
     Tile* getTileAt(int gridX, int gridY);
 
-    void loadSceneFromFolder(const std::string& sceneName);
+    void loadSceneFromFolder(const std::string& sceneName, const std::filesystem::path& root = "scenes");
+    /* Et af spillets levels (levels/<n>/level_<n>_*.csv) - journaliseres ikke */
+    void loadLevel(unsigned int levelNumber);
 
     const std::string& getName() const { return name; }
     Background& getBackground() { return bg; }
+    Tiles& getTiles() { return tiles; }
+    const Tiles& getTiles() const { return tiles; }
 
   private:
     // Camera - måske lave dette som en class på et tidspunkt
@@ -141,6 +261,23 @@ class Manager {
     Layout layout;
     Tiles tiles;
     Background bg;
+    History* history = nullptr;
+    Journal* journal = nullptr;
+
+    // Hvor og i hvilken størrelse scenen sidst blev gemt/indlæst - afgør om kun beskidte lag skal skrives
+    std::filesystem::path savedDir;
+    Vec2<int> savedSize;
+    std::uint64_t snapshotCount = 0;
+    std::uint64_t checkpointFrom = 0; // første snapshot der må checkpointe journalen (efter en fejl eller indlæsning)
+
+    /* Anvender sættet og melder ændringerne til historikken og journalen */
+    size_t commit(const ChangeSet& changes);
+    /* Frigiver de gamle tiles og bygger nye (med autotile) ud fra layoutet */
+    void replaceLayout(Layout newLayout);
+    bool recording() const { return history || journal; }
+    void record(const std::vector<CellDelta>& deltas);
+    /* Melder cellens tiles i laget som slettet - kaldes før enkelt-celle sletningerne */
+    void recordRemoval(int gridX, int gridY, int layerIndex);
 };
 
 };
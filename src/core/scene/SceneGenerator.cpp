@@ -0,0 +1,216 @@
+#include "SceneGenerator.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace Scene {
+
+namespace {
+  /* splitmix64 - lille, hurtig og ens på alle platforme */
+  class Rng {
+    public:
+      explicit Rng(std::uint64_t seed) : state(seed) {}
+
+      std::uint64_t next() {
+        std::uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+      }
+
+      double uniform() { return (next() >> 11) * (1.0 / 9007199254740992.0); }
+      bool chance(double p) { return uniform() < p; }
+
+      /* Heltal i [lo, hi] */
+      int range(int lo, int hi) { return lo + static_cast<int>(uniform() * (hi - lo + 1)); }
+
+    private:
+      std::uint64_t state;
+  };
+
+  double hash01(std::uint64_t seed, std::int64_t i) {
+    Rng r(seed ^ (static_cast<std::uint64_t>(i) * 0xD1B54A32D192ED03ull));
+    return r.uniform();
+  }
+
+  /* 1D value noise i [0, 1) */
+  double valueNoise(std::uint64_t seed, double x) {
+    const double fl = std::floor(x);
+    const std::int64_t i = static_cast<std::int64_t>(fl);
+    const double t = x - fl;
+    const double s = t * t * (3.0 - 2.0 * t);
+    return hash01(seed, i) * (1.0 - s) + hash01(seed, i + 1) * s;
+  }
+
+  double fbm(std::uint64_t seed, double x) {
+    double sum = 0.0, amp = 0.5, norm = 0.0;
+    for (int octave = 0; octave < 3; ++octave) {
+      sum += valueNoise(seed + octave, x) * amp;
+      norm += amp;
+      x *= 2.0;
+      amp *= 0.5;
+    }
+    return sum / norm;
+  }
+
+  constexpr int EMPTY = -1;
+
+  struct Grid {
+    int width, height;
+    Utils::TileLayer& cells;
+
+    bool inside(int x, int y) const { return x >= 0 && x < width && y >= 0 && y < height; }
+    bool solid(int x, int y) const { return inside(x, y) && cells[y][x] != EMPTY; }
+
+    /* Sand hvis hele rektanglet (inkl. kanter udenfor kortet) er tomt */
+    bool clear(int x0, int y0, int x1, int y1) const {
+      for (int y = y0; y <= y1; ++y)
+        for (int x = x0; x <= x1; ++x)
+          if (solid(x, y)) return false;
+      return true;
+    }
+  };
+
+  // Alle tiles skrives med et gyldigt index - Tiles autotiler terrain når scenen indlæses
+  constexpr int TERRAIN_INDEX = 5;
+}
+
+Layout GenerateLayout(const GeneratorConfig& config) {
+  const int width  = std::max(config.width, 8);
+  const int height = std::max(config.height, 6);
+  Rng rng(config.seed);
+
+  Layout layout;
+  const Utils::TileLayer empty(height, std::vector<int>(width, EMPTY));
+  for (Utils::TileLayer* layer : { &layout.bgPalmsLayout, &layout.coinsLayout, &layout.constraintsLayout,
+                                   &layout.cratesLayout, &layout.enemiesLayout, &layout.fgPalmsLayout,
+                                   &layout.grassLayout, &layout.playerSetupLayout, &layout.terrainLayout }) {
+    *layer = empty;
+  }
+
+  Grid terrain { width, height, layout.terrainLayout };
+
+  // --- Jord: højde fra noise, huller hvor en anden noise kanal er lav ---
+  const double density = std::clamp(static_cast<double>(config.terrainDensity), 0.0, 1.0);
+  const int maxGround = height - 3;
+  const double pitThreshold = 0.2 * (1.0 - density);
+  std::vector<int> ground(width, 0);
+
+  for (int x = 0; x < width; ++x) {
+    const bool edge = x < 3 || x >= width - 3; // start og slut har altid fast grund
+    if (!edge && valueNoise(config.seed + 101, x * config.noiseScale * 3.0) < pitThreshold) continue;
+
+    const double n = fbm(config.seed, x * config.noiseScale);
+    ground[x] = std::clamp(static_cast<int>(n * 2.0 * density * maxGround) + 1, 1, maxGround);
+    for (int y = height - ground[x]; y < height; ++y) layout.terrainLayout[y][x] = TERRAIN_INDEX;
+  }
+
+  auto surfaceY = [&](int x) { return height - ground[x] - 1; };
+
+  // --- Platforme: vandrette løb på 1-6 tiles (isoleret, venstre/højre cap og mid) ---
+  const int platformCount = static_cast<int>(width * config.platformsPer100 / 100.0f);
+  for (int i = 0; i < platformCount; ++i) {
+    const int length = rng.range(1, 6);
+    const int x0 = rng.range(0, width - length);
+    const int y  = rng.range(1, height - 4);
+    if (!terrain.clear(x0 - 1, y - 1, x0 + length, y + 1)) continue;
+
+    for (int x = x0; x < x0 + length; ++x) {
+      layout.terrainLayout[y][x] = TERRAIN_INDEX;
+      if (y > 0 && rng.chance(config.coinDensity * 2.0)) layout.coinsLayout[y - 1][x] = rng.range(0, 1);
+    }
+  }
+
+  // --- Søjler: lodrette løb på 1-4 tiles (top/bund cap og mid) ---
+  const int columnCount = static_cast<int>(width * config.columnsPer100 / 100.0f);
+  for (int i = 0; i < columnCount; ++i) {
+    const int length = rng.range(1, 4);
+    const int x  = rng.range(0, width - 1);
+    const int y0 = rng.range(1, std::max(1, height - 3 - length));
+    if (!terrain.clear(x - 1, y0 - 1, x + 1, y0 + length)) continue;
+
+    for (int y = y0; y < y0 + length; ++y) layout.terrainLayout[y][x] = TERRAIN_INDEX;
+  }
+
+  // --- Objekter på overfladen ---
+  std::vector<bool> occupied(width, false);
+  auto freeSurface = [&](int x) {
+    return ground[x] > 0 && !occupied[x] && !terrain.solid(x, surfaceY(x)) && surfaceY(x) >= 0;
+  };
+
+  // Player start og slut
+  layout.playerSetupLayout[surfaceY(0)][0] = 0;
+  layout.playerSetupLayout[surfaceY(width - 1)][width - 1] = 1;
+  occupied[0] = occupied[width - 1] = true;
+
+  // Fjender går mellem to constraints på flade stykker af mindst 4 kolonner
+  for (int x = 1; x < width - 1;) {
+    int end = x;
+    while (end + 1 < width - 1 && ground[end + 1] == ground[x] && ground[x] > 0) ++end;
+    const int length = end - x + 1;
+
+    if (ground[x] > 0 && length >= 4 && rng.chance(std::min(1.0, static_cast<double>(config.enemyDensity) * length))) {
+      const int y = surfaceY(x);
+      const int enemyX = rng.range(x + 1, end - 1);
+      if (freeSurface(x) && freeSurface(end) && freeSurface(enemyX)) {
+        layout.constraintsLayout[y][x] = 1;
+        layout.constraintsLayout[y][end] = 1;
+        layout.enemiesLayout[y][enemyX] = 0;
+        occupied[x] = occupied[end] = occupied[enemyX] = true;
+      }
+    }
+    x = end + 1;
+  }
+
+  for (int x = 0; x < width; ++x) {
+    if (ground[x] == 0) continue;
+    const int y = surfaceY(x);
+
+    if (freeSurface(x) && rng.chance(config.crateDensity)) {
+      layout.cratesLayout[y][x] = 0;
+      occupied[x] = true;
+    } else if (freeSurface(x) && rng.chance(config.fgPalmDensity)) {
+      layout.fgPalmsLayout[y][x] = rng.range(1, 2); // 1 = lille, 2 = stor
+      occupied[x] = true;
+    }
+
+    if (y >= 0 && rng.chance(config.bgPalmDensity)) layout.bgPalmsLayout[y][x] = 0;
+    if (y >= 0 && !terrain.solid(x, y) && rng.chance(config.grassDensity)) layout.grassLayout[y][x] = rng.range(0, 4);
+
+    // Mønter svæver 1-2 felter over jorden
+    const int coinY = y - rng.range(1, 2);
+    if (coinY >= 0 && !terrain.solid(x, coinY) && rng.chance(config.coinDensity))
+      layout.coinsLayout[coinY][x] = rng.range(0, 1);
+  }
+
+  layout.constraintLayout = layout.constraintsLayout;
+  return layout;
+}
+
+bool WriteLayout(const Layout& layout, const std::string& sceneName, const std::filesystem::path& root) {
+  TRACE_SCOPE_DETAIL("WriteLayout", "save", sceneName);
+
+  const struct {
+    const char* suffix;
+    const Utils::TileLayer& data;
+  } files[] = {
+    { "_bg_palms.csv",    layout.bgPalmsLayout },
+    { "_coins.csv",       layout.coinsLayout },
+    { "_constraints.csv", layout.constraintsLayout },
+    { "_crates.csv",      layout.cratesLayout },
+    { "_enemies.csv",     layout.enemiesLayout },
+    { "_fg_palms.csv",    layout.fgPalmsLayout },
+    { "_grass.csv",       layout.grassLayout },
+    { "_player.csv",      layout.playerSetupLayout },
+    { "_terrain.csv",     layout.terrainLayout }
+  };
+
+  const std::filesystem::path sceneDir = root / sceneName;
+  bool ok = true;
+  for (const auto& file : files) {
+    ok = WriteCSV(sceneDir / (sceneName + file.suffix), file.data) && ok;
+  }
+  return ok;
+}
+
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+
+#include "Scene.hpp"
+
+/*
+ * Procedural generator af syntetiske scener til stress- og skaleringstests.
+ *
+ * Samme config + seed giver altid præcis samme scene, også på tværs af platforme
+ * (egen hash-baseret RNG i stedet for <random> distributioner, som ikke er ens
+ * mellem standardbiblioteker).
+ */
+namespace Scene {
+
+struct GeneratorConfig {
+  int width  = DEFAULT_SCENE_WIDTH;
+  int height = DEFAULT_SCENE_HEIGHT;
+  std::uint64_t seed = 1;
+
+  // Terræn: jordhøjde fra noise. density styrer gennemsnitshøjden og hvor mange huller der er
+  float terrainDensity = 0.35f;
+  float noiseScale     = 0.04f;
+
+  // Strukturer per 100 kolonner - platforme (vandrette) og søjler (lodrette) rammer alle autotile tilfælde
+  float platformsPer100 = 6.0f;
+  float columnsPer100   = 3.0f;
+
+  // Sandsynlighed per ledig overflade-celle
+  float coinDensity    = 0.10f;
+  float enemyDensity   = 0.04f;
+  float crateDensity   = 0.03f;
+  float grassDensity   = 0.35f;
+  float fgPalmDensity  = 0.04f;
+  float bgPalmDensity  = 0.06f;
+};
+
+/* Laver et layout med alle ni lag i scenens størrelse */
+[[nodiscard]] Layout GenerateLayout(const GeneratorConfig& config);
+
+/* Skriver layoutet som root/<navn>/<navn>_<lag>.csv - samme format som saveScene */
+bool WriteLayout(const Layout& layout, const std::string& sceneName, const std::filesystem::path& root = "scenes");
+
+}
@@ -0,0 +1,139 @@
+#include "SceneSaver.hpp"
+
+#include <algorithm>
+#include <charconv>
+
+#include "Scene.hpp"
+#include "logging/Logger.hpp"
+#include "logging/Trace.hpp"
+
+namespace Scene {
+
+namespace {
+  /* Rækkerne skrives direkte fra den sorterede tile liste - intet fuldt grid i hukommelsen */
+  void EncodeLayer(std::ostream& out, const LayerSnapshot& layer, int width, int height) {
+    std::string line;
+    line.reserve(static_cast<size_t>(width) * 4);
+    char number[16];
+
+    auto next = layer.tiles.begin();
+    const auto end = layer.tiles.end();
+    for (int y = 0; y < height; ++y) {
+      line.clear();
+      for (int x = 0; x < width; ++x) {
+        // Tiles uden for scenens rect (negative koordinater) kommer ikke med - som før
+        while (next != end && (next->y < y || (next->y == y && next->x < x))) ++next;
+
+        const int value = (next != end && next->y == y && next->x == x) ? next->index : -1;
+        const auto r = std::to_chars(number, number + sizeof(number), value);
+        line.append(number, r.ptr);
+        if (x < width - 1) line.push_back(',');
+      }
+      line.push_back('\n');
+      out.write(line.data(), static_cast<std::streamsize>(line.size()));
+    }
+  }
+
+  /* Det nyeste lag vinder - lag som kun det ventende snapshot har flyttes med over */
+  void Merge(SaveSnapshot& waiting, SaveSnapshot&& newer) {
+    // Ny størrelse giver altid et fuldt snapshot, så de gamle lag er forældede
+    if (newer.width == waiting.width && newer.height == waiting.height) {
+      for (LayerSnapshot& layer : waiting.layers) {
+        const bool replaced = std::any_of(newer.layers.begin(), newer.layers.end(),
+                                          [&](const LayerSnapshot& l) { return l.type == layer.type; });
+        if (!replaced) newer.layers.push_back(std::move(layer));
+      }
+    }
+    // Mærker fra forskellige generationer kan ikke sammenlignes - det nyeste gælder
+    if (newer.journalGeneration == waiting.journalGeneration)
+      newer.journalMark = std::max(newer.journalMark, waiting.journalMark);
+    Log::Debug(Log::Category::Scene, "Ventende save af '{}' slået sammen med en nyere ({} lag)", newer.sceneName, newer.layers.size());
+    waiting = std::move(newer);
+  }
+}
+
+SceneSaver::~SceneSaver() {
+  join();
+}
+
+void SceneSaver::start(SaveSnapshot snapshot) {
+  if (!running_) {
+    launch(std::move(snapshot));
+    return;
+  }
+
+  // Den ventendes lag er ikke beskidte længere - de skal med, ellers skrives de aldrig
+  if (!pending_.empty() && pending_.back().sceneDir == snapshot.sceneDir) {
+    Merge(pending_.back(), std::move(snapshot));
+    return;
+  }
+  pending_.push_back(std::move(snapshot));
+}
+
+std::optional<SaveResult> SceneSaver::poll() {
+  std::optional<SaveResult> done;
+  if (running_ && finished_.load(std::memory_order_acquire)) {
+    join();
+    done = std::move(result_);
+  }
+
+  if (!running_ && !pending_.empty()) {
+    SaveSnapshot next = std::move(pending_.front());
+    pending_.pop_front();
+    launch(std::move(next));
+  }
+  return done;
+}
+
+void SceneSaver::launch(SaveSnapshot snapshot) {
+  currentScene_ = snapshot.sceneName;
+  filesDone_.store(0, std::memory_order_relaxed);
+  filesTotal_.store(static_cast<int>(snapshot.layers.size()), std::memory_order_relaxed);
+  finished_.store(false, std::memory_order_relaxed);
+  running_ = true;
+
+  worker_ = std::thread([this, snapshot = std::move(snapshot)] {
+    Log::Trace::SetThreadName("save");
+    result_ = Write(snapshot, &filesDone_);
+    finished_.store(true, std::memory_order_release);
+  });
+}
+
+void SceneSaver::join() {
+  if (worker_.joinable()) worker_.join();
+  running_ = false;
+  finished_.store(false, std::memory_order_relaxed);
+}
+
+SaveResult SceneSaver::Write(const SaveSnapshot& snapshot, std::atomic<int>* progress) {
+  TRACE_SCOPE_DETAIL("SceneSaver::Write", "save", snapshot.sceneName);
+  const Uint64 start = SDL_GetTicksNS();
+
+  SaveResult result;
+  result.sceneName = snapshot.sceneName;
+  result.sceneDir = snapshot.sceneDir;
+  result.journalMark = snapshot.journalMark;
+  result.journalGeneration = snapshot.journalGeneration;
+  result.sequence = snapshot.sequence;
+
+  for (const LayerSnapshot& layer : snapshot.layers) {
+    const std::filesystem::path filePath = snapshot.sceneDir / (snapshot.sceneName + layer.suffix);
+    const bool ok = WriteFileAtomic(filePath, [&](std::ostream& out) {
+      EncodeLayer(out, layer, snapshot.width, snapshot.height);
+    });
+
+    if (ok) {
+      ++result.written;
+      Log::Debug(Log::Category::Scene, "Gemte {}", filePath.string());
+    } else {
+      result.ok = false;
+      result.failedTypes |= 1u << layer.type;
+    }
+    if (progress) progress->fetch_add(1, std::memory_order_relaxed);
+  }
+
+  result.ms = (SDL_GetTicksNS() - start) / 1e6;
+  return result;
+}
+
+}
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "tiles/TileManager.hpp"
+
+namespace Scene {
+
+/* Én tile som den skrives til CSV */
+struct SavedTile {
+  int x;
+  int y;
+  int index;
+};
+
+/* Et lag (én CSV fil) kopieret ud af scenen - sorteret efter række og kolonne */
+struct LayerSnapshot {
+  TileType type;
+  const char* suffix;
+  std::vector<SavedTile> tiles;
+};
+
+/*
+ * Uforanderlig kopi af de lag der skal gemmes. Tages på main tråden (kun de beskidte lag),
+ * og derefter kan scenen redigeres videre mens snapshottet skrives i baggrunden.
+ */
+struct SaveSnapshot {
+  std::string sceneName;
+  std::filesystem::path sceneDir;
+  int width = 0;
+  int height = 0;
+  std::vector<LayerSnapshot> layers;
+  std::uint64_t journalMark = 0; // journalens position da snapshottet blev taget
+  std::uint64_t journalGeneration = 0; // og dens generation - mærket gælder kun i den
+  std::uint64_t sequence = 0;    // løbenummer fra Manager::snapshotForSave
+};
+
+struct SaveResult {
+  std::string sceneName;
+  std::filesystem::path sceneDir;
+  std::uint64_t journalMark = 0;
+  std::uint64_t journalGeneration = 0;
+  std::uint64_t sequence = 0;
+  bool ok = true;
+  std::uint32_t failedTypes = 0; // bit per TileType der ikke blev skrevet - markeres beskidte igen
+  size_t written = 0;
+  double ms = 0.0;
+};
+
+/*
+ * Skriver SaveSnapshots på en baggrundstråd. Hver fil skrives til en .tmp ved siden af og
+ * omdøbes over den gamle, så en afbrudt save aldrig efterlader en halv CSV. Kommer der en
+ * ny save mens en kører, venter den. Ventende saves til samme mappe slås sammen per lag
+ * (det nyeste lag vinder, lag kun det ældre snapshot havde beholdes).
+ */
+class SceneSaver {
+  public:
+    SceneSaver() = default;
+    ~SceneSaver();
+
+    SceneSaver(const SceneSaver&) = delete;
+    SceneSaver& operator=(const SceneSaver&) = delete;
+
+    void start(SaveSnapshot snapshot);
+
+    /* Main tråden, én gang per frame: starter en ventende save og afleverer en færdig */
+    std::optional<SaveResult> poll();
+
+    bool busy() const { return running_ || !pending_.empty(); }
+    int filesDone() const { return filesDone_.load(std::memory_order_relaxed); }
+    int filesTotal() const { return filesTotal_.load(std::memory_order_relaxed); }
+    const std::string& currentScene() const { return currentScene_; }
+
+    /* Skriver snapshottet på den kaldende tråd (saveScene og benchmarks) */
+    static SaveResult Write(const SaveSnapshot& snapshot, std::atomic<int>* progress = nullptr);
+
+  private:
+    void launch(SaveSnapshot snapshot);
+    void join();
+
+    std::thread worker_;
+    bool running_ = false;
+    std::deque<SaveSnapshot> pending_;
+    std::string currentScene_;
+
+    std::atomic<bool> finished_ { false };
+    std::atomic<int> filesDone_ { 0 };
+    std::atomic<int> filesTotal_ { 0 };
+    SaveResult result_; // skrives af tråden før finished_ sættes
+};
+
+}
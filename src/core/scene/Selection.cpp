@@ -0,0 +1,111 @@
+#include "Selection.hpp"
+
+#include <algorithm>
+#include <climits>
+
+namespace Scene {
+
+CellRect CellRect::FromCorners(int x0, int y0, int x1, int y1) {
+  const int minX = std::min(x0, x1);
+  const int minY = std::min(y0, y1);
+  return { minX, minY, std::max(x0, x1) - minX + 1, std::max(y0, y1) - minY + 1 };
+}
+
+void Selection::set(const CellRect& rect) {
+  rects_.clear();
+  if (!rect.empty()) rects_.push_back(rect);
+}
+
+void Selection::add(const CellRect& rect) {
+  if (rect.empty()) return;
+  subtract(rect);
+  rects_.push_back(rect);
+  merge();
+}
+
+void Selection::clipTop(int minY) {
+  subtract({ INT_MIN / 2, INT_MIN / 2, INT_MAX, minY - INT_MIN / 2 });
+}
+
+void Selection::offset(int dx, int dy) {
+  for (auto& r : rects_) {
+    r.x += dx;
+    r.y += dy;
+  }
+}
+
+bool Selection::contains(int x, int y) const {
+  for (const auto& r : rects_) {
+    if (r.contains(x, y)) return true;
+  }
+  return false;
+}
+
+long long Selection::cellCount() const {
+  long long count = 0;
+  for (const auto& r : rects_) count += r.area();
+  return count;
+}
+
+CellRect Selection::bounds() const {
+  if (rects_.empty()) return {};
+  int minX = INT_MAX, minY = INT_MAX, maxX = INT_MIN, maxY = INT_MIN;
+  for (const auto& r : rects_) {
+    minX = std::min(minX, r.x);
+    minY = std::min(minY, r.y);
+    maxX = std::max(maxX, r.x + r.w);
+    maxY = std::max(maxY, r.y + r.h);
+  }
+  return { minX, minY, maxX - minX, maxY - minY };
+}
+
+void Selection::subtract(const CellRect& cut) {
+  // På plads: urørte rects rykkes frem, stykkerne lægges bagerst - kapaciteten genbruges (Rect værktøjet kalder hver frame)
+  const size_t count = rects_.size();
+  size_t kept = 0;
+
+  for (size_t i = 0; i < count; ++i) {
+    const CellRect r = rects_[i];
+    const int ix0 = std::max(r.x, cut.x);
+    const int iy0 = std::max(r.y, cut.y);
+    const int ix1 = std::min(r.x + r.w, cut.x + cut.w);
+    const int iy1 = std::min(r.y + r.h, cut.y + cut.h);
+    if (ix0 >= ix1 || iy0 >= iy1) {
+      rects_[kept++] = r;
+      continue;
+    }
+
+    // Op til fire stykker omkring overlappet: hele bredden over og under, siderne ved siden af
+    if (iy0 > r.y)             rects_.push_back({ r.x, r.y, r.w, iy0 - r.y });
+    if (iy1 < r.y + r.h)       rects_.push_back({ r.x, iy1, r.w, r.y + r.h - iy1 });
+    if (ix0 > r.x)             rects_.push_back({ r.x, iy0, ix0 - r.x, iy1 - iy0 });
+    if (ix1 < r.x + r.w)       rects_.push_back({ ix1, iy0, r.x + r.w - ix1, iy1 - iy0 });
+  }
+
+  rects_.erase(rects_.begin() + kept, rects_.begin() + count);
+}
+
+void Selection::merge() {
+  // Rects er disjunkte, så to der deler en hel kant kan bare lægges sammen. Gentages til intet ændrer sig
+  bool changed = true;
+  while (changed) {
+    changed = false;
+    for (size_t i = 0; i < rects_.size() && !changed; ++i) {
+      for (size_t j = i + 1; j < rects_.size(); ++j) {
+        CellRect& a = rects_[i];
+        const CellRect& b = rects_[j];
+        const bool sameColumn = a.x == b.x && a.w == b.w && (a.y + a.h == b.y || b.y + b.h == a.y);
+        const bool sameRow    = a.y == b.y && a.h == b.h && (a.x + a.w == b.x || b.x + b.w == a.x);
+        if (!sameColumn && !sameRow) continue;
+
+        if (sameColumn) { a.y = std::min(a.y, b.y); a.h += b.h; }
+        else            { a.x = std::min(a.x, b.x); a.w += b.w; }
+        rects_.erase(rects_.begin() + j);
+        changed = true;
+        break;
+      }
+    }
+  }
+}
+
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <vector>
+
+namespace Scene {
+
+/* Rektangel af celler i grid koordinater (w/h i celler) */
+struct CellRect {
+  int x = 0;
+  int y = 0;
+  int w = 0;
+  int h = 0;
+
+  bool empty() const { return w <= 0 || h <= 0; }
+  bool contains(int cx, int cy) const { return cx >= x && cx < x + w && cy >= y && cy < y + h; }
+  long long area() const { return empty() ? 0 : static_cast<long long>(w) * h; }
+
+  /* Rect'en mellem to hjørneceller (begge inklusive, i vilkårlig rækkefølge) */
+  static CellRect FromCorners(int x0, int y0, int x1, int y1);
+};
+
+/*
+ * Markering som en liste af disjunkte rects i stedet for én celle per element.
+ * Et træk giver én rect uanset størrelse; tilføjes der flere klippes overlap væk og
+ * naborects der flugter lægges sammen, så highlight kan tegnes som få, hele rects.
+ */
+class Selection {
+  public:
+    void clear() { rects_.clear(); }
+    bool empty() const { return rects_.empty(); }
+
+    /* Erstatter markeringen med én rect */
+    void set(const CellRect& rect);
+    /* Lægger rect'en til (union med det der allerede er markeret) */
+    void add(const CellRect& rect);
+    /* Fjerner alle rects (eller dele af dem) der ligger over y (grid rækker < minY) */
+    void clipTop(int minY);
+    /* Flytter hele markeringen dx, dy celler */
+    void offset(int dx, int dy);
+
+    bool contains(int x, int y) const;
+    long long cellCount() const;
+    CellRect bounds() const;
+
+    const std::vector<CellRect>& rects() const { return rects_; }
+
+  private:
+    void subtract(const CellRect& cut);
+    void merge();
+
+    std::vector<CellRect> rects_;
+};
+
+}
@@ -0,0 +1,105 @@
+#include "Stamp.hpp"
+
+#include <algorithm>
+
+#include "Scene.hpp"
+#include "logging/Logger.hpp"
+#include "utils/utils.hpp"
+
+namespace Scene {
+
+namespace {
+  const std::vector<TilePlacement> EMPTY_TILES;
+  constexpr const char* STAMP_EXTENSION = ".stamp.csv";
+}
+
+Stamp Stamp::Capture(const Manager& manager, const Selection& selection, int layerIndex, std::string name) {
+  auto data = std::make_shared<StampData>();
+  const CellRect bounds = selection.bounds();
+  data->width = bounds.w;
+  data->height = bounds.h;
+  data->tiles = manager.copyRegion(selection, layerIndex);
+  data->tiles.shrink_to_fit();
+  return Stamp(std::move(data), std::move(name));
+}
+
+const std::vector<TilePlacement>& Stamp::tiles() const {
+  return data_ ? data_->tiles : EMPTY_TILES;
+}
+
+Stamp Stamp::renamed(std::string name) const {
+  return Stamp(data_, std::move(name));
+}
+
+bool Stamp::save(const std::filesystem::path& path) const {
+  // Samme CSV som scenerne: første række er størrelsen, derefter én række per tile
+  Utils::TileLayer rows;
+  rows.reserve(tiles().size() + 1);
+  rows.push_back({ width(), height() });
+  for (const TilePlacement& t : tiles()) {
+    rows.push_back({ t.x, t.y, static_cast<int>(t.type), t.index });
+  }
+  return WriteCSV(path, rows);
+}
+
+Stamp Stamp::Load(const std::filesystem::path& path) {
+  const Utils::TileLayer rows = Utils::LoadCSVFile(path.string());
+  if (rows.empty() || rows.front().size() != 2) {
+    Log::Warn(Log::Category::Scene, "Ugyldig stamp fil: {}", path.string());
+    return {};
+  }
+
+  auto data = std::make_shared<StampData>();
+  data->width = rows.front()[0];
+  data->height = rows.front()[1];
+  data->tiles.reserve(rows.size() - 1);
+  for (size_t i = 1; i < rows.size(); ++i) {
+    const auto& r = rows[i];
+    if (r.size() != 4) continue;
+    data->tiles.push_back({ r[0], r[1], static_cast<TileType>(r[2]), r[3] });
+  }
+
+  std::string name = path.filename().string();
+  name.resize(name.size() - std::min(name.size(), std::char_traits<char>::length(STAMP_EXTENSION)));
+  return Stamp(std::move(data), std::move(name));
+}
+
+void StampLibrary::load() {
+  stamps_.clear();
+  std::error_code ec;
+  if (!std::filesystem::is_directory(root_, ec)) return;
+
+  for (const auto& entry : std::filesystem::directory_iterator(root_, ec)) {
+    const std::string file = entry.path().filename().string();
+    if (!entry.is_regular_file() || !file.ends_with(STAMP_EXTENSION)) continue;
+
+    Stamp stamp = Stamp::Load(entry.path());
+    if (!stamp.empty()) stamps_.push_back(std::move(stamp));
+  }
+
+  std::sort(stamps_.begin(), stamps_.end(), [](const Stamp& a, const Stamp& b) { return a.name() < b.name(); });
+  Log::Info(Log::Category::Scene, "Indlæste {} stamps fra {}", stamps_.size(), root_.string());
+}
+
+bool StampLibrary::add(const Stamp& stamp) {
+  if (stamp.empty() || stamp.name().empty()) return false;
+  if (!stamp.save(pathFor(stamp.name()))) return false;
+
+  auto it = std::find_if(stamps_.begin(), stamps_.end(), [&](const Stamp& s) { return s.name() == stamp.name(); });
+  if (it != stamps_.end()) *it = stamp;
+  else                     stamps_.push_back(stamp);
+  return true;
+}
+
+std::string StampLibrary::nextName() const {
+  for (int i = static_cast<int>(stamps_.size()) + 1;; ++i) {
+    std::string name = std::format("stamp_{}", i);
+    if (std::none_of(stamps_.begin(), stamps_.end(), [&](const Stamp& s) { return s.name() == name; })) return name;
+  }
+}
+
+std::filesystem::path StampLibrary::pathFor(const std::string& name) const {
+  return root_ / (name + STAMP_EXTENSION);
+}
+
+}
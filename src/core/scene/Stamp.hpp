@@ -0,0 +1,76 @@
+#pragma once
+
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Scene.hpp"
+
+namespace Scene {
+
+/* Et stamps indhold - tiles med koordinater relativt til øverste venstre hjørne */
+struct StampData {
+  int width = 0;
+  int height = 0;
+  std::vector<TilePlacement> tiles;
+};
+
+/*
+ * Kopieret region på tværs af lag. Indholdet er uforanderligt og delt mellem clipboard og
+ * biblioteket. En indsættelse laver almindelige tiles i scenen (én per celle) - de deler ikke
+ * noget med stampet bagefter. Ændres et stamp (fx gemt igen under samme navn) laves der en
+ * ny StampData - de gamle holdere beholder deres.
+ */
+class Stamp {
+  public:
+    Stamp() = default;
+
+    /* Kopierer markeringen fra scenen (layerIndex -1 = alle lag) */
+    static Stamp Capture(const Manager& manager, const Selection& selection, int layerIndex, std::string name = {});
+
+    bool empty() const { return !data_ || data_->tiles.empty(); }
+    const std::string& name() const { return name_; }
+    int width() const { return data_ ? data_->width : 0; }
+    int height() const { return data_ ? data_->height : 0; }
+    const std::vector<TilePlacement>& tiles() const;
+
+    /* Samme indhold under et andet navn - deler data */
+    Stamp renamed(std::string name) const;
+    /* Hvor mange der deler indholdet (clipboard + bibliotek + ...) */
+    long shareCount() const { return data_.use_count(); }
+
+    bool save(const std::filesystem::path& path) const;
+    static Stamp Load(const std::filesystem::path& path);
+
+  private:
+    Stamp(std::shared_ptr<const StampData> data, std::string name)
+      : data_(std::move(data)), name_(std::move(name)) {}
+
+    std::shared_ptr<const StampData> data_;
+    std::string name_;
+};
+
+/* Stamps gemt på disk (én fil per stamp i root) - deles mellem alle scener */
+class StampLibrary {
+  public:
+    explicit StampLibrary(std::filesystem::path root = "stamps") : root_(std::move(root)) {}
+
+    /* Indlæser alle stamps i root (kaldes igen for at genindlæse) */
+    void load();
+    /* Gemmer stampet på disk og i biblioteket - et eksisterende med samme navn erstattes */
+    bool add(const Stamp& stamp);
+    /* Et ledigt navn som stamp_3 */
+    std::string nextName() const;
+
+    const std::vector<Stamp>& stamps() const { return stamps_; }
+    bool empty() const { return stamps_.empty(); }
+
+  private:
+    std::filesystem::path pathFor(const std::string& name) const;
+
+    std::filesystem::path root_;
+    std::vector<Stamp> stamps_;
+};
+
+}
@@ -61,15 +61,13 @@ void Tile::update(Vec2<float> offset) {
 }
 
 void Tile::draw(SDL_Renderer *renderer) const {
-  if (!texture) {
-      Log::Error("Kunne ikke tegne tile: passerede nullptr i texture");
-      return;
-    }
+  // Manglende texture er allerede logget da tilen blev indlæst - ikke én gang per frame her
+  if (!texture) return;
 
   if(staticTile) {
-    SDL_RenderTexture(renderer, texture, nullptr, &dstRect);
+    Render::Texture(renderer, texture, nullptr, &dstRect);
   } else {
-    SDL_RenderTexture(renderer, texture, &srcRect, &dstRect);
+    Render::Texture(renderer, texture, &srcRect, &dstRect);
   }
 }
 
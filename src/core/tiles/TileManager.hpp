@@ -5,6 +5,7 @@
 #include "math/vec.hpp"
 #include "resources/ResourceManager.hpp"
 #include "SDL3/SDL_render.h"
+#include "sdl/Render.hpp"
 
 enum TileType {
   TILE_TYPE_TERRAIN,
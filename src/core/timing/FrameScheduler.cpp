@@ -0,0 +1,125 @@
+#include "FrameScheduler.hpp"
+
+#include <array>
+#include <cmath>
+
+#include "SDL3/SDL.h"
+
+namespace Timing {
+
+namespace {
+  constexpr int HISTORY = 240;
+  constexpr double NS_PER_MS = 1'000'000.0;
+
+  FixedStepper s_stepper;
+
+  bool s_vsync = false;
+  int s_frameCap = 0;
+  Uint64 s_targetNs = 0;  // forventet frame interval (cap eller skærmens refresh)
+  Uint64 s_capNs = 0;     // kun når vi selv skal vente
+
+  Uint64 s_lastStart = 0;
+  Uint64 s_deadline = 0;
+
+  std::array<Uint64, HISTORY> s_intervals {};
+  int s_count = 0;
+  int s_next = 0;
+  std::uint64_t s_totalMissed = 0;
+
+  bool s_idle = false;  // forrige frame endte i waitIdle
+  bool s_resumed = false;
+  std::uint64_t s_idleWaits = 0;
+  Uint64 s_lastIdleNs = 0;
+
+  bool IsMiss(Uint64 interval) {
+    return s_targetNs > 0 && interval * 2 > s_targetNs * 3;
+  }
+}
+
+void FrameScheduler::configure(bool vsync, double refreshRate, int frameCap) {
+  s_vsync = vsync;
+  s_frameCap = vsync ? 0 : frameCap;
+  s_capNs = s_frameCap > 0 ? static_cast<Uint64>(1e9 / s_frameCap) : 0;
+
+  if (s_capNs > 0)                     s_targetNs = s_capNs;
+  else if (vsync && refreshRate > 0.0) s_targetNs = static_cast<Uint64>(1e9 / refreshRate);
+  else                                 s_targetNs = 0;
+
+  s_deadline = 0;
+}
+
+double FrameScheduler::beginFrame() {
+  const Uint64 now = SDL_GetTicksNS();
+  if (s_lastStart == 0) s_lastStart = now;
+  const Uint64 interval = now - s_lastStart;
+  s_lastStart = now;
+  s_resumed = s_idle;
+  s_idle = false;
+
+  if (interval > 0 && !s_resumed) {
+    s_intervals[s_next] = interval;
+    s_next = (s_next + 1) % HISTORY;
+    if (s_count < HISTORY) ++s_count;
+    if (IsMiss(interval)) ++s_totalMissed;
+  }
+  return interval / 1e9;
+}
+
+void FrameScheduler::endFrame() {
+  if (s_capNs == 0) return;
+
+  const Uint64 now = SDL_GetTicksNS();
+  s_deadline = s_deadline == 0 ? now + s_capNs : s_deadline + s_capNs;
+
+  if (now < s_deadline) {
+    SDL_DelayPrecise(s_deadline - now);
+  } else if (now - s_deadline > s_capNs) {
+    // Mere end en hel frame bagud - start forfra i stedet for at race for at indhente
+    s_deadline = now;
+  }
+}
+
+void FrameScheduler::waitIdle(int timeoutMs) {
+  const Uint64 start = SDL_GetTicksNS();
+  SDL_WaitEventTimeout(nullptr, timeoutMs);
+  s_lastIdleNs = SDL_GetTicksNS() - start;
+  s_idle = true;
+  s_deadline = 0;
+  ++s_idleWaits;
+}
+
+bool FrameScheduler::resumedFromIdle() {
+  return s_resumed;
+}
+
+FixedStepper& FrameScheduler::stepper() {
+  return s_stepper;
+}
+
+PacingStats FrameScheduler::stats() {
+  PacingStats stats;
+  stats.vsync = s_vsync;
+  stats.frameCap = s_frameCap;
+  stats.targetMs = s_targetNs / NS_PER_MS;
+  stats.totalMissed = s_totalMissed;
+  stats.stepsLastFrame = s_stepper.stepsLastFrame();
+  stats.droppedSteps = s_stepper.dropped();
+  stats.idleWaits = s_idleWaits;
+  stats.lastIdleMs = s_lastIdleNs / NS_PER_MS;
+  if (s_count == 0) return stats;
+
+  double sum = 0.0;
+  for (int i = 0; i < s_count; ++i) sum += s_intervals[i] / NS_PER_MS;
+  stats.avgMs = sum / s_count;
+
+  const double reference = s_targetNs > 0 ? stats.targetMs : stats.avgMs;
+  double deviation = 0.0;
+  for (int i = 0; i < s_count; ++i) {
+    deviation += std::abs(s_intervals[i] / NS_PER_MS - reference);
+    if (IsMiss(s_intervals[i])) ++stats.missed;
+  }
+  stats.jitterMs = deviation / s_count;
+  return stats;
+}
+
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <cstdint>
+
+/*
+ * Simulation (kamera, skyer) kører i faste skridt af FIXED_DT, uafhængigt af billedraten,
+ * og tegnes interpoleret mellem de to seneste skridt med alpha(). Så scroller kameraet
+ * lige jævnt ved 60 og 240 Hz.
+ *
+ * FrameScheduler ejer main loopets stepper, måler frames med nanosekund-tælleren og holder
+ * billedraten nede med en frame cap når vsync ikke er tilgængelig.
+ */
+namespace Timing {
+
+inline constexpr double FIXED_DT = 1.0 / 120.0;
+
+class FixedStepper {
+  public:
+    static constexpr int MAX_STEPS = 8;
+    static constexpr int MAX_IDLE_STEPS = 1200; // efter en idle ventetid skal timere indhente op til 10 s
+
+    /* Lægger tid til og kører step(dt) for hvert helt skridt - højst maxSteps per frame */
+    template<typename StepFn>
+    int advance(double seconds, StepFn&& step, int maxSteps = MAX_STEPS) {
+      accumulator += seconds;
+      int steps = 0;
+      while (accumulator >= FIXED_DT) {
+        if (steps == maxSteps) {
+          // Langt efter (breakpoint, load) - tiden kasseres hellere end at hænge i en spiral
+          ++droppedFrames;
+          accumulator = 0.0;
+          break;
+        }
+        step(static_cast<float>(FIXED_DT));
+        accumulator -= FIXED_DT;
+        ++steps;
+      }
+      lastSteps = steps;
+      return steps;
+    }
+
+    /* Hvor langt vi er mellem forrige og seneste skridt (0..1) */
+    float alpha() const { return static_cast<float>(accumulator / FIXED_DT); }
+    int stepsLastFrame() const { return lastSteps; }
+    std::uint64_t dropped() const { return droppedFrames; }
+
+  private:
+    double accumulator = 0.0;
+    int lastSteps = 0;
+    std::uint64_t droppedFrames = 0;
+};
+
+struct PacingStats {
+  double targetMs = 0.0;   // 0 = intet mål (ukappet)
+  double avgMs = 0.0;      // gennemsnitligt interval mellem frames
+  double jitterMs = 0.0;   // gennemsnitlig afvigelse fra målet (eller fra gennemsnittet uden mål)
+  int missed = 0;          // frames i vinduet der ramte over 1.5x målet
+  std::uint64_t totalMissed = 0;
+  int stepsLastFrame = 0;
+  std::uint64_t droppedSteps = 0;
+  bool vsync = false;
+  int frameCap = 0;
+  std::uint64_t idleWaits = 0;
+  double lastIdleMs = 0.0;
+};
+
+class FrameScheduler {
+  public:
+    /* vsync: rendereren venter selv på skærmen. Ellers holdes billedraten på frameCap (0 = ingen) */
+    static void configure(bool vsync, double refreshRate, int frameCap);
+
+    /* Sekunder siden forrige frame startede */
+    static double beginFrame();
+
+    /* Sover til næste deadline når der er en frame cap */
+    static void endFrame();
+
+    /* Venter på input i højst timeoutMs (-1 = uendeligt) i stedet for at tegne næste frame.
+       Intervallet tæller ikke med i pacing statistikken */
+    static void waitIdle(int timeoutMs);
+    static bool resumedFromIdle();
+
+    static FixedStepper& stepper();
+    static PacingStats stats();
+
+    FrameScheduler() = delete;
+};
+
+}
@@ -4,18 +4,61 @@ Editor::Editor()
   : scene_manager(0, "TempEmptyScene")
 {
   Log::Info("Initialiserer editor");
-  ui.openLoadMenu([&](const std::string& sceneName) {
-    scene_manager.loadSceneFromFolder(sceneName);
-    ui.showSave("Scene Loaded Successfully: " + sceneName);
-    sceneLoaded = true;
-  });
+
+  // Bygges én gang - std::function per event ville allokere for hver mus/tast
+  uiCallbacks.setSelectedIndex = [this](int idx){ selectedTileIndex = idx; };
+  uiCallbacks.nudgeIndex       = [this](int d){ clampOrWrapSelectedIndex(d); };
+  uiCallbacks.toggleLayerView  = [this]{ showLayers = !showLayers; };
+  uiCallbacks.nextLayer        = [this]{ if (showLayers) currentLayer = (currentLayer + 1) % maxLayers; };
+  uiCallbacks.prevLayer        = [this]{ if (showLayers) currentLayer = (currentLayer - 1 + maxLayers) % maxLayers; };
+  uiCallbacks.togglePalette    = [this]{ ui.setPaletteVisible(!ui.paletteVisible()); };
+
+  scene_manager.setHistory(&history);
+  ui.onThumbnailReady = [this] { requestRedraw(Redraw::LOAD); };
+  stamps.load();
+
+  ui.openLoadMenu([&](const std::string& sceneName) { loadScene(sceneName); });
+}
+
+void Editor::loadScene(const std::string& sceneName, const std::filesystem::path& root) {
+  scene_manager.loadSceneFromFolder(sceneName, root);
+  ui.closeLoadMenu();
+  ui.showSave("Scene Loaded Successfully: " + sceneName);
+  sceneLoaded = true;
+  requestRedraw(Redraw::LOAD);
+}
+
+void Editor::loadLevel(unsigned int level) {
+  scene_manager.loadLevel(level);
+  ui.closeLoadMenu();
+  ui.showSave("Level Loaded Successfully: " + scene_manager.getName());
+  sceneLoaded = true;
+  requestRedraw(Redraw::LOAD);
+}
+
+Redraw::Request Editor::redrawRequest(const SDL_State& state) {
+  Redraw::Request request;
+  request.now = pendingRedraw;
+  pendingRedraw = 0;
+
+  bool held = state.mouseButtons != 0;
+  for (int sc = 0; !held && state.keyState && sc < SDL_SCANCODE_COUNT; ++sc) held = state.keyState[sc];
+  if (held) request.now |= Redraw::HELD;
+
+  if (state.cameraPrevStepPos.x != state.cameraStepPos.x) request.now |= Redraw::CAMERA;
+
+  request.wakeIn(Redraw::CLOUDS, scene_manager.getBackground().idleWakeMs());
+  request.wakeIn(Redraw::POPUP, ui.popupRemainingMs());
+  if (saver.busy()) request.wakeIn(Redraw::POPUP, SAVE_POLL_MS);
+  return request;
 }
 
 void Editor::drawGridLines(SDL_State& state) {
-  auto mouseState = SDL_GetMouseState(&mouseX, &mouseY);
+  const SDL_MouseButtonFlags mouseState = state.mouseButtons;
+  mouseX = state.mouseX;
+  mouseY = state.mouseY;
 
   mapOffsetY = std::max(0.0f, state.windowHeight - mapHeight);
-  state.cameraPos.x += state.cameraX;
 
   const float worldMouseX = mouseX + state.cameraPos.x;
   const float worldMouseY = mouseY - mapOffsetY;
@@ -23,69 +66,43 @@ void Editor::drawGridLines(SDL_State& state) {
   const int tileX = static_cast<int>(std::floor(worldMouseX / TILE_SIZE));
   const int tileY = static_cast<int>(std::floor(worldMouseY / TILE_SIZE));
 
-  SDL_SetRenderDrawColor(state.renderer, gridColor.r, gridColor.g, gridColor.b, gridColor.a);
+  const bool dialogOpen = ui.saveDialogVisible() || ui.loadDialogVisible() || ui.newSceneDialogVisible();
+
+  // Tegning og sletning med knappen/tasten holdt nede bliver én undo kommando per strøg
+  const bool ctrl = state.keyState[SDL_SCANCODE_LCTRL];
+  const bool stroking = editMode && !dialogOpen && (
+    (paintTool == PaintTool::Brush && (mouseState & SDL_BUTTON_LMASK) && !ctrl) ||
+    state.keyState[SDL_SCANCODE_DELETE] || state.keyState[SDL_SCANCODE_BACKSPACE] || (mouseState & SDL_BUTTON_RMASK));
+  if (stroking != strokeOpen) {
+    if (stroking) history.beginStroke();
+    else          history.endStroke();
+    strokeOpen = stroking;
+  }
+
+  if(!editMode || dialogOpen) return;
 
-  const int startX = -64 * 8;
-  const int endX = state.windowWidth + 64 * 47;
-  if(!editMode || ui.saveDialogVisible() || ui.loadDialogVisible() || ui.newSceneDialogVisible()) return;
+  grid.draw(state.renderer, state.windowWidth, state.windowHeight, mapOffsetY, state.cameraPos.x, gridColor);
 
-  for (int x = startX; x <= endX; x += TILE_SIZE) {
-    SDL_RenderLine(state.renderer, x - state.cameraPos.x, TILE_SIZE + mapOffsetY, x - state.cameraPos.x, state.windowHeight);
-  }
+  // Hover, markeringsboks og markerede tiles samles og tegnes i ét geometry kald til sidst
+  OverlayBatch overlay;
 
-  for (int y = 64; y <= state.windowHeight; y += TILE_SIZE) {
-    SDL_RenderLine(state.renderer, 0, y + mapOffsetY, state.windowWidth, y + mapOffsetY);
-  }
+  applyPaintTool(state, tileX, tileY, overlay);
 
   if (worldMouseY >= 64.0f) {
-    SDL_SetRenderDrawColor(state.renderer, hoverColor.r, hoverColor.g, hoverColor.b, hoverColor.a);
     SDL_FRect rect{
       std::roundf(tileX * TILE_SIZE - state.cameraPos.x),
       tileY * TILE_SIZE + mapOffsetY,
       TILE_SIZE + 1.0f,
       TILE_SIZE + 1.0f
     };
-
-    SDL_RenderRect(state.renderer, &rect);
-
-    bool leftClick = mouseState & SDL_BUTTON_LMASK & !(state.keyState[SDL_SCANCODE_LCTRL]);
-    if(leftClick && !wasMouseDown) {
-      if(showLayers) {
-        Tile* existingTile = scene_manager.getTileAt(tileX, tileY);
-        if(!existingTile || existingTile->getType() != selectedTileType) {
-          Tile* newTile = TileFactory::createTile(
-              selectedTileType,
-              { float(tileX), float(tileY) },
-              selectedTileIndex
-          );
-          scene_manager.addTileToLayer(newTile, currentLayer);
-        }
-      } else {
-        Tile* existingTile = scene_manager.getTileAt(tileX, tileY);
-        if(!existingTile || existingTile->getType() != selectedTileType) {
-          Tile* newTile = TileFactory::createTile(
-              selectedTileType,
-              { float(tileX), float(tileY) },
-              selectedTileIndex
-            );
-          scene_manager.addTileToLayer(newTile, currentLayer);
-        }
-      }
-    }
+    overlay.outlineRect(rect, hoverColor);
 
     if (state.keyState[SDL_SCANCODE_DELETE] ||
         state.keyState[SDL_SCANCODE_BACKSPACE] ||
         (mouseState & SDL_BUTTON_RMASK)) {
-      for (auto [tx, ty] : selectedTiles) {
-        if (showLayers) {
-          // Slet kun currentLayer
-          scene_manager.removeLayerTiles(tx, ty, currentLayer);
-        } else {
-          // Slet alle layers
-          for (int layer = 0; layer < maxLayers; ++layer) {
-            scene_manager.removeLayerTiles(tx, ty, layer);
-          }
-        }
+      // Hele markeringen i én mutation - kun currentLayer i layer view, ellers alle layers
+      if (!selection.empty()) {
+        scene_manager.deleteRegion(selection, showLayers ? currentLayer : -1);
       }
 
       int tileX = static_cast<int>(std::floor((mouseX + state.cameraPos.x) / TILE_SIZE));
@@ -99,7 +116,7 @@ void Editor::drawGridLines(SDL_State& state) {
           }
       }
 
-      selectedTiles.clear();
+      selection.clear();
     }
 
     // --- PREVIEW TILE ---
@@ -140,25 +157,24 @@ void Editor::drawGridLines(SDL_State& state) {
       float y = std::min(selectionStart.y, selectionEnd.y);
       float w = std::abs(selectionEnd.x - selectionStart.x);
       float h = std::abs(selectionEnd.y - selectionStart.y);
+      overlay.outlineRect({ x, y, w, h }, selectionBoxColor);
+    }
 
-      SDL_SetRenderDrawColor(state.renderer, 0, 0, 255, 60);
-      SDL_FRect rect = { x, y, w, h };
-      SDL_RenderRect(state.renderer, &rect);
+    // Hvor et stamp ville lande med Ctrl+V
+    if (ctrl && !isSelecting && !clipboard.empty()) {
+      const Scene::CellRect footprint { tileX, std::max(1, tileY), clipboard.width(), clipboard.height() };
+      overlay.outlineRect(cellRectToScreen(footprint, state), hoverColor);
     }
 
-    // Tegn de færdigt markerede tiles
-    for (auto [tx, ty] : selectedTiles) {
-      SDL_FRect rect{
-        tx * TILE_SIZE - state.cameraPos.x,
-        ty * TILE_SIZE + mapOffsetY,
-        TILE_SIZE + 1.0f,
-        TILE_SIZE + 1.0f
-      };
-      SDL_SetRenderDrawBlendMode(state.renderer, SDL_BLENDMODE_BLEND);
-
-      SDL_SetRenderDrawColor(state.renderer, gridColor.r, gridColor.g, gridColor.b, 100);
-      SDL_RenderFillRect(state.renderer, &rect);
+    // Den færdige markering - én rect per markeret område, kun dem der er synlige
+    const SDL_Color selectedColor { gridColor.r, gridColor.g, gridColor.b, 100 };
+    for (const Scene::CellRect& r : selection.rects()) {
+      const SDL_FRect rect = cellRectToScreen(r, state);
+      if (rect.x + rect.w < 0.0f || rect.x > state.windowWidth) continue;
+      overlay.fillRect(rect, selectedColor);
     }
+
+    overlay.flush(state.renderer);
 }
 
 
@@ -237,9 +253,9 @@ void Editor::drawPreview(SDL_Renderer* renderer) {
 
   Uint8 oldAlpha = 255;
   SDL_GetTextureAlphaMod(previewTile->texture, &oldAlpha);
-  SDL_SetTextureAlphaMod(previewTile->texture, 150); // ghost-look
+  Render::SetTextureAlphaMod(previewTile->texture, 150); // ghost-look
   previewTile->draw(renderer);
-  SDL_SetTextureAlphaMod(previewTile->texture, oldAlpha);
+  Render::SetTextureAlphaMod(previewTile->texture, oldAlpha);
 }
 
 void Editor::clampOrWrapSelectedIndex(int delta) {
@@ -268,6 +284,10 @@ void Editor::clampOrWrapSelectedIndex(int delta) {
 
 
 void Editor::handleInput(SDL_Event& event, SDL_State& state) {
+  requestRedraw(Redraw::INPUT);
+  if(event.type == SDL_EVENT_RENDER_TARGETS_RESET || event.type == SDL_EVENT_RENDER_DEVICE_RESET) {
+    grid.invalidate();
+  }
   if(!sceneLoaded) {
     ui.handleEvent(event, state, scene_manager, {}, {});
     return;
@@ -288,6 +308,25 @@ void Editor::handleInput(SDL_Event& event, SDL_State& state) {
       if(event.key.key == SDLK_7) { selectedTileType = TILE_TYPE_FG_PALM; }
       if(event.key.key == SDLK_8) { selectedTileType = TILE_TYPE_BG_PALM; }
       if(event.key.key == SDLK_9) { selectedTileType = TILE_TYPE_CONSTRAINT; }
+
+      if(event.key.key == SDLK_B) { paintTool = PaintTool::Brush; }
+      if(event.key.key == SDLK_R) { paintTool = PaintTool::Rect; rectActive = false; }
+      if(event.key.key == SDLK_G) { paintTool = PaintTool::Flood; }
+
+      // Ctrl+Z fortryd, Ctrl+Y / Ctrl+Shift+Z gentag
+      if((event.key.mod & SDL_KMOD_CTRL) && (event.key.key == SDLK_Z || event.key.key == SDLK_Y)) {
+        const bool redo = event.key.key == SDLK_Y || (event.key.mod & SDL_KMOD_SHIFT);
+        if (history.inStroke()) {
+          Log::Debug(Log::Category::Scene, "{} ignoreret - et strøg er i gang", redo ? "Redo" : "Undo");
+          return;
+        }
+        const size_t cells = redo ? history.redo(scene_manager) : history.undo(scene_manager);
+        Log::Debug(Log::Category::Scene, "{}: {} celler ({} / {} kommandoer, {} KiB)", redo ? "Redo" : "Undo", cells,
+                   history.undoDepth(), history.redoDepth(), history.memoryUsed() / 1024);
+        return;
+      }
+
+      if(handleSelectionKey(event.key, state)) return;
     }
   }
   if (event.type == SDL_EVENT_MOUSE_WHEEL && (!ui.saveDialogVisible() && !ui.loadDialogVisible() && !ui.newSceneDialogVisible())) {
@@ -306,12 +345,157 @@ void Editor::handleInput(SDL_Event& event, SDL_State& state) {
   {
     if (event.key.repeat == 0) {
       ui.openSaveDialog(state.window, scene_manager.getName(), [&](const std::string& name){
-        scene_manager.saveScene(name);
-        ui.showSave("Scene Saved As: " + name);
+        // Kun de ændrede lag kopieres her - resten af gemningen sker i baggrunden
+        saver.start(scene_manager.snapshotForSave(name));
+        saveProgressShown = -1;
+        ui.showSave("Saving: " + name);
       });
     }
   }
 
+  ui.handleEvent(event, state, scene_manager, uiModel(), uiCallbacks);
+}
+
+SDL_FRect Editor::cellRectToScreen(const Scene::CellRect& r, const SDL_State& state) const {
+  return {
+    r.x * TILE_SIZE - state.cameraPos.x,
+    r.y * TILE_SIZE + mapOffsetY,
+    r.w * TILE_SIZE + 1.0f,
+    r.h * TILE_SIZE + 1.0f
+  };
+}
+
+void Editor::applyPaintTool(SDL_State& state, int tileX, int tileY, OverlayBatch& overlay) {
+  const bool down = (state.mouseButtons & SDL_BUTTON_LMASK) && !state.keyState[SDL_SCANCODE_LCTRL];
+  const bool pressed = down && !wasPaintDown;
+  const bool released = !down && wasPaintDown;
+  wasPaintDown = down;
+
+  const Scene::Tiles& tiles = scene_manager.getTiles();
+
+  switch (paintTool) {
+    case PaintTool::Brush: {
+      if (!down) return;
+
+      // Linje fra forrige frames celle, så et hurtigt træk ikke efterlader huller
+      const int fromX = pressed ? tileX : lastPaintX;
+      const int fromY = pressed ? tileY : lastPaintY;
+      lastPaintX = tileX;
+      lastPaintY = tileY;
+
+      paintChanges.clear();
+      PaintTools::ForEachLineCell(fromX, fromY, tileX, tileY, [&](int x, int y) {
+        if (y < 1 || tiles.IsPlaced(x, y, selectedTileType, selectedTileIndex)) return;
+        paintChanges.placements.push_back({ x, y, selectedTileType, selectedTileIndex });
+      });
+      if (!paintChanges.empty()) scene_manager.applyChanges(paintChanges);
+      break;
+    }
+
+    case PaintTool::Rect: {
+      if (pressed) {
+        rectActive = true;
+        rectStartX = tileX;
+        rectStartY = tileY;
+      }
+      if (!rectActive) return;
+
+      rectRegion.set(Scene::CellRect::FromCorners(rectStartX, rectStartY, tileX, tileY));
+      rectRegion.clipTop(1);
+
+      if (down) {
+        for (const Scene::CellRect& r : rectRegion.rects()) {
+          const SDL_FRect rect = cellRectToScreen(r, state);
+          overlay.fillRect(rect, { hoverColor.r, hoverColor.g, hoverColor.b, 50 });
+          overlay.outlineRect(rect, hoverColor);
+        }
+      } else if (released) {
+        rectActive = false;
+        const size_t filled = scene_manager.fillRegion(rectRegion, selectedTileType, selectedTileIndex);
+        Log::Debug(Log::Category::Scene, "Rect fill: {} celler", filled);
+      }
+      break;
+    }
+
+    case PaintTool::Flood:
+      if (pressed) {
+        const size_t filled = scene_manager.floodFill(tileX, tileY, selectedTileType, selectedTileIndex);
+        Log::Debug(Log::Category::Scene, "Flood fill: {} celler", filled);
+      }
+      break;
+  }
+}
+
+bool Editor::handleSelectionKey(const SDL_KeyboardEvent& key, SDL_State& state) {
+  const bool ctrl = key.mod & SDL_KMOD_CTRL;
+  const int layer = showLayers ? currentLayer : -1;
+
+  // Ctrl+V sætter stampet ind med øverste venstre hjørne på cellen under musen
+  if (ctrl && key.key == SDLK_V && !key.repeat && !clipboard.empty()) {
+    const int cellX = static_cast<int>(std::floor((state.mouseX + state.cameraPos.x) / TILE_SIZE));
+    const int cellY = static_cast<int>(std::floor((state.mouseY - mapOffsetY) / TILE_SIZE));
+    const size_t pasted = scene_manager.pasteRegion(clipboard.tiles(), cellX, std::max(1, cellY));
+    Log::Debug(Log::Category::Scene, "Indsatte {} tiles ved ({}, {})", pasted, cellX, cellY);
+    return true;
+  }
+
+  // , og . bladrer i stamp biblioteket - det valgte stamp lægges i clipboard
+  if (!ctrl && (key.key == SDLK_COMMA || key.key == SDLK_PERIOD) && !stamps.empty()) {
+    const int count = static_cast<int>(stamps.stamps().size());
+    const int step = key.key == SDLK_PERIOD ? 1 : count - 1;
+    stampIndex = stampIndex < 0 ? (step == 1 ? 0 : count - 1) : (stampIndex + step) % count;
+    clipboard = stamps.stamps()[stampIndex];
+    ui.showSave("Stamp: " + clipboard.name());
+    return true;
+  }
+
+  if (selection.empty()) return false;
+
+  // Ctrl+C kopierer, Ctrl+X klipper, Ctrl+Shift+C gemmer også kopien i stamp biblioteket
+  if (ctrl && (key.key == SDLK_C || key.key == SDLK_X) && !key.repeat) {
+    const bool toLibrary = key.key == SDLK_C && (key.mod & SDL_KMOD_SHIFT);
+    clipboard = Scene::Stamp::Capture(scene_manager, selection, layer, toLibrary ? stamps.nextName() : std::string{});
+    Log::Debug(Log::Category::Scene, "Kopierede {} tiles", clipboard.tiles().size());
+
+    if (toLibrary && stamps.add(clipboard)) {
+      ui.showSave("Stamp Saved: " + clipboard.name());
+    }
+    if (key.key == SDLK_X) {
+      scene_manager.deleteRegion(selection, layer);
+    }
+    return true;
+  }
+
+  if (ctrl && key.key == SDLK_D) {
+    selection.clear();
+    return true;
+  }
+
+  if (!ctrl && key.key == SDLK_F && !key.repeat) {
+    const size_t filled = scene_manager.fillRegion(selection, selectedTileType, selectedTileIndex);
+    Log::Debug(Log::Category::Scene, "Fyldte {} celler", filled);
+    return true;
+  }
+
+  // Alt + piletaster flytter indholdet af markeringen én celle (kameraet står stille imens)
+  if (key.mod & SDL_KMOD_ALT) {
+    int dx = 0, dy = 0;
+    if (key.key == SDLK_LEFT)  dx = -1;
+    if (key.key == SDLK_RIGHT) dx = 1;
+    if (key.key == SDLK_UP)    dy = -1;
+    if (key.key == SDLK_DOWN)  dy = 1;
+    if (dx == 0 && dy == 0) return false;
+    if (selection.bounds().y + dy < 1) return true;
+
+    scene_manager.moveRegion(selection, layer, dx, dy);
+    selection.offset(dx, dy);
+    return true;
+  }
+
+  return false;
+}
+
+UI::EditorUIModel Editor::uiModel() const {
   UI::EditorUIModel m;
   m.editMode          = editMode;
   m.showLayers        = showLayers;
@@ -321,53 +505,77 @@ void Editor::handleInput(SDL_Event& event, SDL_State& state) {
   m.selectedTexture   = (previewTile ? previewTile->texture : nullptr);
   m.maxIndex          = currentMaxIndex;
   m.tileSize          = TILE_SIZE;
-
-  UI::EditorUICallbacks cb;
-  cb.setSelectedIndex = [&](int idx){ selectedTileIndex = idx; };
-  cb.nudgeIndex       = [&](int d){ clampOrWrapSelectedIndex(d); };
-  cb.toggleLayerView  = [&]{ showLayers = !showLayers; };
-  cb.nextLayer        = [&]{ if (showLayers) currentLayer = (currentLayer + 1) % maxLayers; };
-  cb.prevLayer        = [&]{ if (showLayers) currentLayer = (currentLayer - 1 + maxLayers) % maxLayers; };
-  cb.togglePalette    = [&]{ ui.setPaletteVisible(!ui.paletteVisible()); };
-
-  ui.handleEvent(event, state, scene_manager, m, cb);
+  m.paintTool         = paintTool;
+  return m;
 }
 
 
 void Editor::updateSelectedTiles(SDL_State& state) {
-  selectedTiles.clear();
-
-  float x = std::min(selectionStart.x, selectionEnd.x) + state.cameraPos.x;
-  float y = std::min(selectionStart.y, selectionEnd.y) - mapOffsetY;
-  float w = std::abs(selectionEnd.x - selectionStart.x);
-  float h = std::abs(selectionEnd.y - selectionStart.y);
-
-  int startTileX = (int) std::floor(x / TILE_SIZE);
-  int startTileY = (int) std::floor(y / TILE_SIZE);
-  int endTileX   = (int) std::floor((x + w) / TILE_SIZE);
-  int endTileY   = (int) std::floor((y + h) / TILE_SIZE);
+  const float x0 = selectionStart.x + state.cameraPos.x;
+  const float y0 = selectionStart.y - mapOffsetY;
+  const float x1 = selectionEnd.x + state.cameraPos.x;
+  const float y1 = selectionEnd.y - mapOffsetY;
+
+  const Scene::CellRect rect = Scene::CellRect::FromCorners(
+    (int) std::floor(x0 / TILE_SIZE), (int) std::floor(y0 / TILE_SIZE),
+    (int) std::floor(x1 / TILE_SIZE), (int) std::floor(y1 / TILE_SIZE));
+
+  // Shift lægger til den eksisterende markering
+  if (state.keyState[SDL_SCANCODE_LSHIFT] || state.keyState[SDL_SCANCODE_RSHIFT]) {
+    selection.add(rect);
+  } else {
+    selection.set(rect);
+  }
 
-  for(int ty = startTileY; ty <= endTileY; ++ty) {
-    if((ty * TILE_SIZE + mapOffsetY) < 64.0f + mapOffsetY) continue;
+  // Øverste række er ikke en del af banen
+  selection.clipTop(1);
+}
 
-    for(int tx = startTileX; tx <= endTileX; ++tx) {
-      selectedTiles.emplace_back(tx, ty);
-    }
+void Editor::fixedUpdate(SDL_State& state, float dt) {
+  PROFILE_SCOPE("Editor::fixedUpdate");
+  if(!sceneLoaded) {
+    scene_manager.getBackground().fixedUpdate(state, dt);
+    return;
   }
+
+  // Alt bruges til at flytte markeringen med piletasterne
+  const bool altHeld = state.keyState && (state.keyState[SDL_SCANCODE_LALT] || state.keyState[SDL_SCANCODE_RALT]);
+  scene_manager.fixedUpdate(state, dt, (ui.saveDialogVisible() || ui.loadDialogVisible() || altHeld));
 }
 
 void Editor::update(SDL_State& state) {
+  PROFILE_SCOPE("Editor::update");
   ui.update(state, state.deltaTime);
+  pollSaver();
+
+  // Kameraet tegnes mellem de to seneste fixed steps - musen og grid bruger samme position
+  state.cameraPos = state.cameraPrevStepPos.lerp(state.cameraStepPos, state.stepAlpha);
+
   if(!sceneLoaded) {
     scene_manager.getBackground().update(state);
     return;
   }
 
-  scene_manager.update(state, (ui.saveDialogVisible() || ui.loadDialogVisible()));
+  scene_manager.update(state);
+}
+
+void Editor::pollSaver() {
+  if (std::optional<Scene::SaveResult> result = saver.poll()) {
+    scene_manager.saveFinished(*result);
+    ui.showSave((result->ok ? "Scene Saved As: " : "Save Failed: ") + result->sceneName);
+    requestRedraw(Redraw::POPUP);
+    return;
+  }
+
+  if (!saver.busy() || saver.filesDone() == saveProgressShown) return;
+  saveProgressShown = saver.filesDone();
+  ui.showSave(std::format("Saving {}: {}/{}", saver.currentScene(), saveProgressShown, saver.filesTotal()));
 }
 
 const std::string layers[] = {"{green}Background", "{green}Terrain", "{green}Foreground"};
 void Editor::draw(SDL_State& state) {
+  PROFILE_SCOPE("Editor::draw");
+  Render::SubsystemScope renderScope(Render::Subsystem::Editor);
   if (!sceneLoaded) {
     // Kun baggrund og menu
     scene_manager.getBackground().render(state.renderer);
@@ -381,19 +589,12 @@ void Editor::draw(SDL_State& state) {
     scene_manager.draw(state.renderer, -1);
   }
 
-  drawGridLines(state);
-
-  UI::EditorUIModel m;
-  m.editMode          = editMode;
-  m.showLayers        = showLayers;
-  m.currentLayer      = currentLayer;
-  m.selectedTileType  = selectedTileType;
-  m.selectedTileIndex = selectedTileIndex;
-  m.selectedTexture   = (previewTile ? previewTile->texture : nullptr);
-  m.maxIndex          = currentMaxIndex;
-  m.tileSize          = TILE_SIZE;
+  {
+    PROFILE_SCOPE("Editor::drawGridLines");
+    drawGridLines(state);
+  }
 
-  ui.draw(state, m);
+  ui.draw(state, uiModel());
 }
 
 
@@ -1,9 +1,11 @@
 #pragma once
 
+#include <filesystem>
 #include <string>
 #include <algorithm>
 #include <cstdlib>
 #include <format>
+#include <optional>
 
 #include "SDL3/SDL_events.h"
 #include "SDL3/SDL_pixels.h"
@@ -11,6 +13,7 @@
 #include "tiles/TileManager.hpp"
 #include "logging/Logger.hpp"
 #include "scene/Scene.hpp"
+#include "scene/Stamp.hpp"
 #include "sdl/SDL_Handler.hpp"
 #include "ui/TextHandler.hpp"
 #include "SDL3/SDL_keycode.h"
@@ -18,16 +21,39 @@
 #include "SDL3/SDL_scancode.h"
 #include "SDL3/SDL_stdinc.h"
 #include "EditorUI.hpp"
+#include "profiling/Profiler.hpp"
+#include "memory/FrameArena.hpp"
+#include "Redraw.hpp"
+#include "GridOverlay.hpp"
+#include "OverlayBatch.hpp"
+#include "PaintTools.hpp"
 
 class Editor {
   public:
     Editor();
     ~Editor() = default;
 
+    /* run = update + draw én gang per frame. fixedUpdate kaldes af Timing::FixedStepper før run */
     void run(SDL_State& state);
+    void fixedUpdate(SDL_State& state, float dt);
     void update(SDL_State& state);
     void draw(SDL_State& state);
     void handleInput(SDL_Event& event, SDL_State& state);
+    void loadScene(const std::string& sceneName, const std::filesystem::path& root = "scenes");
+    void loadLevel(unsigned int level);
+
+    /* Loft over undo historikkens hukommelse */
+    void setUndoMemoryCap(std::size_t bytes) { history.setMemoryCap(bytes); }
+
+    const UI::EditorUI& getUI() const { return ui; }
+
+    /* Crash-journal for scenerne - kun live, afspilning og bench må ikke røre scenes/ */
+    void enableJournal() { scene_manager.setJournal(&journal); }
+
+    /* Markerer at næste frame skal tegnes (fx når en asynkron load er færdig) */
+    void requestRedraw(Redraw::Reason reason) { pendingRedraw |= reason; }
+    /* Hvad der kræver en ny frame efter denne - nulstiller de ventende grunde */
+    Redraw::Request redrawRequest(const SDL_State& state);
 
   private:
     Tile* previewTile = nullptr;
@@ -49,12 +75,17 @@ class Editor {
     int selectedTileIndex = 0;
 
     void drawGridLines(SDL_State& state);
+    /* Det valgte værktøj for venstreklik uden Ctrl - preview lægges i overlay */
+    void applyPaintTool(SDL_State& state, int tileX, int tileY, OverlayBatch& overlay);
+    SDL_FRect cellRectToScreen(const Scene::CellRect& r, const SDL_State& state) const;
     void updateSelectedTiles(SDL_State& state);
 
     static constexpr float mapHeight = 704.0f;
     static constexpr SDL_Color gridColor = {120, 135, 150, 255};
     static constexpr SDL_Color hoverColor = {30, 150, 255, 255};
     static constexpr SDL_Color testColor = {255, 165, 0, 255};
+    static constexpr SDL_Color selectionBoxColor = {0, 0, 255, 60};
+    GridOverlay grid;
     float mouseX = 0.0f;
     float mouseY = 0.0f;
     float mapOffsetY = 0.0f;
@@ -68,9 +99,40 @@ class Editor {
     bool wasMouseDown = false;
     SDL_FPoint selectionStart{0.0f, 0.0f};
     SDL_FPoint selectionEnd{0.0f, 0.0f};
-    std::vector<std::pair<int, int>> selectedTiles;
+    PaintTool paintTool = PaintTool::Brush;
+    bool wasPaintDown = false;
+    int lastPaintX = 0;
+    int lastPaintY = 0;
+    bool rectActive = false;
+    int rectStartX = 0;
+    int rectStartY = 0;
+    Scene::Selection rectRegion;   // genbruges mens Rect værktøjet trækkes
+    Scene::ChangeSet paintChanges; // genbruges mellem frames mens der tegnes
+
+    Scene::History history;
+    bool strokeOpen = false;
+
+    Scene::Journal journal;
+
+    static constexpr int SAVE_POLL_MS = 33;
+    Scene::SceneSaver saver;
+    int saveProgressShown = -1;
+    /* Viser fremgang og resultat af en save der kører i baggrunden */
+    void pollSaver();
+
+    Scene::Selection selection;
+    Scene::Stamp clipboard;      // overlever scene skift, så der kan kopieres mellem scener
+    Scene::StampLibrary stamps;
+    int stampIndex = -1;
+
+    /* Region operationer på markeringen (kopiér, indsæt, fyld, flyt). true = tasten er brugt */
+    bool handleSelectionKey(const SDL_KeyboardEvent& key, SDL_State& state);
+
+    UI::EditorUIModel uiModel() const;
 
     Scene::Manager scene_manager;
     UI::EditorUI ui;
+    UI::EditorUICallbacks uiCallbacks;
     bool sceneLoaded = false;
+    std::uint32_t pendingRedraw = Redraw::INPUT; // første frame tegnes altid
 };
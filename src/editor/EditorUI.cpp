@@ -7,6 +7,8 @@
 
 namespace UI {
 
+using namespace UI::literals;
+
 void EditorUI::update(SDL_State& state, float dt) noexcept {
   if (showSavePopup) {
     savePopupTimer -= dt;
@@ -16,13 +18,23 @@ void EditorUI::update(SDL_State& state, float dt) noexcept {
   }
 }
 
+int EditorUI::popupRemainingMs() const {
+  if (!showSavePopup) return -1;
+  return static_cast<int>(std::ceil(std::max(0.f, savePopupTimer) * 1000.f));
+}
+
 void EditorUI::draw(SDL_State& state, const EditorUIModel& m) {
+  PROFILE_SCOPE("EditorUI::draw");
+  Render::SubsystemScope renderScope(Render::Subsystem::UI);
+  // Tekst samles per font - flush ved hvert lag (HUD, palette, popup/dialoger), så det
+  // næste lag dækker teksten bagved ligesom da teksten blev tegnet med det samme
   drawHUD(state, m);
-  if (showTilePalette)    drawTilePalette(state, m);
-  if (showSavePopup)      drawSavePopup(state);
-  if (showSaveDialog)     drawSaveDialog(state);
-  if (showLoadMenu)       drawLoadMenu(state);
-  if (showNewSceneDialog) drawNewSceneDialog(state);
+  UI::Text::flush();
+  if (showTilePalette)    { drawTilePalette(state, m); UI::Text::flush(); }
+  if (showSavePopup)      { drawSavePopup(state);      UI::Text::flush(); }
+  if (showSaveDialog)     { drawSaveDialog(state);     UI::Text::flush(); }
+  if (showLoadMenu)       { drawLoadMenu(state);       UI::Text::flush(); }
+  if (showNewSceneDialog) { drawNewSceneDialog(state); UI::Text::flush(); }
 }
 
 void EditorUI::handleEvent(const SDL_Event& ev, SDL_State& state, Scene::Manager& scene_manager, const EditorUIModel& m, const EditorUICallbacks& cb) {
@@ -52,8 +64,7 @@ void EditorUI::handleEvent(const SDL_Event& ev, SDL_State& state, Scene::Manager
 
   // Mouse wheel over paletten -> skift index
   if (ev.type == SDL_EVENT_MOUSE_WHEEL && showTilePalette && !saveDialogVisible()) {
-    float mx, my;
-    SDL_GetMouseState(&mx, &my);
+    const float mx = state.mouseX, my = state.mouseY;
     // paletten ligger i screen-space øverst højre hjørne
     if (mx >= paletteRect.x && mx <= (paletteRect.x + paletteRect.w) &&
         my >= paletteRect.y && my <= (paletteRect.y + paletteRect.h)) {
@@ -72,7 +83,8 @@ void EditorUI::handleEvent(const SDL_Event& ev, SDL_State& state, Scene::Manager
 }
 
 void EditorUI::showSave(const std::string& msg) {
-  savePopupText = msg;
+  savePopupLabel.compile(msg);
+  savePopupSize = UI::Text::measureText(savePopupLabel.view());
   savePopupTimer = SAVE_POPUP_DURATION;
   showSavePopup = true;
 }
@@ -80,8 +92,10 @@ void EditorUI::showSave(const std::string& msg) {
 void EditorUI::drawHUD(SDL_State& state, const EditorUIModel& m) {
   using UI::Text;
 
-  std::string editText  = std::format("Edit mode: {}", m.editMode ? "{green}ON" : "{red}OFF");
-  Text::displayText(editText, {10.f, 30.f});
+  // Faste labels er kompileret ved compile-time - ingen parsing eller allokering per frame
+  static constexpr auto editOn  = "Edit mode: {green}ON"_rich;
+  static constexpr auto editOff = "Edit mode: {red}OFF"_rich;
+  Text::displayText(m.editMode ? editOn.view() : editOff.view(), {10.f, 30.f});
 
   auto tileTypeName = [&](TileType t)->const char*{
     switch (t) {
@@ -100,23 +114,30 @@ void EditorUI::drawHUD(SDL_State& state, const EditorUIModel& m) {
     }
   };
 
-  std::string typeText = std::format("Selected type: {}{}", "{green}", tileTypeName(m.selectedTileType));
-  Text::displayText(typeText, {10.f, 50.f});
+  // Dynamiske linjer formateres i en buffer på stakken i stedet for std::format/to_string
+  char line[64];
+  Text::displayText(FormatTo(line, "Selected type: {{green}}{}", tileTypeName(m.selectedTileType)), {10.f, 50.f});
 
   int shownMax = (m.selectedTileType == TILE_TYPE_FG_PALM) ? 2 : (m.maxIndex + 1);
   int shownIdx = (m.selectedTileType == TILE_TYPE_FG_PALM) ? m.selectedTileIndex : (m.selectedTileIndex + 1);
-  std::string idxText = std::format("Tile index: {0}/{1}",
-      "{green}"+std::to_string(shownIdx)+"{white}",
-      "{green}"+std::to_string(shownMax));
-  Text::displayText(idxText, {10.f, 70.f});
+  Text::displayText(FormatTo(line, "Tile index: {{green}}{}{{white}}/{{green}}{}", shownIdx, shownMax), {10.f, 70.f});
+
+  static constexpr auto toolBrush = "Tool (B/R/G): {green}Brush"_rich;
+  static constexpr auto toolRect  = "Tool (B/R/G): {green}Rect fill"_rich;
+  static constexpr auto toolFlood = "Tool (B/R/G): {green}Flood fill"_rich;
+  static constexpr RichTextView tools[] = { toolBrush.view(), toolRect.view(), toolFlood.view() };
+  Text::displayText(tools[static_cast<int>(m.paintTool)], {10.f, 90.f});
 
-  std::string layerViewText = std::format("Layer View (TAB): {}", m.showLayers ? "{green}ON" : "{red}OFF");
-  Text::displayText(layerViewText, {10.f, 90.f});
+  static constexpr auto layerViewOn  = "Layer View (TAB): {green}ON"_rich;
+  static constexpr auto layerViewOff = "Layer View (TAB): {red}OFF"_rich;
+  Text::displayText(m.showLayers ? layerViewOn.view() : layerViewOff.view(), {10.f, 110.f});
 
   if (m.showLayers) {
-    static const std::string layers[] = {"{green}Background", "{green}Terrain", "{green}Foreground"};
-    std::string layerText = std::format("Layer: {}", layers[m.currentLayer]);
-    Text::displayText(layerText, {10.f, 110.f});
+    static constexpr auto layerBg = "Layer: {green}Background"_rich;
+    static constexpr auto layerTr = "Layer: {green}Terrain"_rich;
+    static constexpr auto layerFg = "Layer: {green}Foreground"_rich;
+    static constexpr RichTextView layers[] = { layerBg.view(), layerTr.view(), layerFg.view() };
+    Text::displayText(layers[m.currentLayer], {10.f, 130.f});
   }
 }
 
@@ -129,12 +150,13 @@ void EditorUI::drawTilePalette(SDL_State& state, const EditorUIModel& m) {
 
   // baggrund
   SDL_SetRenderDrawColor(state.renderer, 20, 20, 30, 180);
-  SDL_RenderFillRect(state.renderer, &paletteRect);
+  Render::FillRect(state.renderer, &paletteRect);
   SDL_SetRenderDrawColor(state.renderer, 255, 255, 255, 100);
-  SDL_RenderRect(state.renderer, &paletteRect);
+  Render::Rect(state.renderer, &paletteRect);
 
   // label
-  UI::Text::displayText(std::format("Toggle Palette: {}P", "{green}"), {paletteRect.x + 250.f, paletteRect.y + 15.f});
+  static constexpr auto paletteLabel = "Toggle Palette: {green}P"_rich;
+  UI::Text::displayText(paletteLabel, {paletteRect.x + 250.f, paletteRect.y + 15.f});
 
   float texW = 0, texH = 0;
   SDL_GetTextureSize(m.selectedTexture, &texW, &texH);
@@ -156,8 +178,7 @@ void EditorUI::drawTilePalette(SDL_State& state, const EditorUIModel& m) {
     hoveredTileIndex = -1;
 
     // highlight ved hover
-    float mx, my;
-    SDL_GetMouseState(&mx, &my);
+    const float mx = state.mouseX, my = state.mouseY;
 
     for (int ty = 0; ty < rows; ++ty) {
         for (int tx = 0; tx < cols; ++tx) {
@@ -177,21 +198,21 @@ void EditorUI::drawTilePalette(SDL_State& state, const EditorUIModel& m) {
                 (float)m.tileSize
             };
 
-            SDL_RenderTexture(state.renderer, m.selectedTexture, &src, &dst);
+            Render::Texture(state.renderer, m.selectedTexture, &src, &dst);
 
             // mark selected
             if (idx == m.selectedTileIndex) {
                 SDL_SetRenderDrawColor(state.renderer, 255, 220, 0, 90);
-                SDL_RenderFillRect(state.renderer, &dst);
+                Render::FillRect(state.renderer, &dst);
                 SDL_SetRenderDrawColor(state.renderer, 255, 220, 0, 200);
-                SDL_RenderRect(state.renderer, &dst);
+                Render::Rect(state.renderer, &dst);
             }
 
             if (mx >= dst.x && mx <= dst.x + dst.w &&
                 my >= dst.y && my <= dst.y + dst.h) {
                 hoveredTileIndex = idx;
                 SDL_SetRenderDrawColor(state.renderer, 0, 180, 255, 120);
-                SDL_RenderRect(state.renderer, &dst);
+                Render::Rect(state.renderer, &dst);
             }
         }
     }
@@ -210,20 +231,23 @@ void EditorUI::drawTilePalette(SDL_State& state, const EditorUIModel& m) {
 
   if (m.selectedTileType == TILE_TYPE_CRATE || m.selectedTileType == TILE_TYPE_BG_PALM || m.selectedTileType == TILE_TYPE_CONSTRAINT) {
     if (m.selectedTileType == TILE_TYPE_CRATE) {
-      SDL_RenderTexture(state.renderer, m.selectedTexture, &srcRect, &dstRect_crate);
+      Render::Texture(state.renderer, m.selectedTexture, &srcRect, &dstRect_crate);
       SDL_SetRenderDrawColor(state.renderer, 255, 220, 0, 120);
-      SDL_RenderRect(state.renderer, &dstRect_crate);
+      Render::Rect(state.renderer, &dstRect_crate);
     } else {
-      SDL_RenderTexture(state.renderer, m.selectedTexture, &srcRect, &dstRect_palm);
+      Render::Texture(state.renderer, m.selectedTexture, &srcRect, &dstRect_palm);
       SDL_SetRenderDrawColor(state.renderer, 255, 220, 0, 120);
-      SDL_RenderRect(state.renderer, &dstRect_palm);
+      Render::Rect(state.renderer, &dstRect_palm);
     }
     return;
   }
 
   if (m.selectedTileType == TILE_TYPE_FG_PALM) {
-    SDL_Texture* small = ResourceManager::loadTexture("resources/terrain/palm_small/small_1.png");
-    SDL_Texture* large = ResourceManager::loadTexture("resources/terrain/palm_large/large_1.png");
+    // Stierne er for lange til SSO - slå kun op første gang i stedet for en std::string per frame
+    if (!palmSmallTexture) palmSmallTexture = ResourceManager::loadTexture("resources/terrain/palm_small/small_1.png");
+    if (!palmLargeTexture) palmLargeTexture = ResourceManager::loadTexture("resources/terrain/palm_large/large_1.png");
+    SDL_Texture* small = palmSmallTexture;
+    SDL_Texture* large = palmLargeTexture;
 
     float smallW = 0, smallH = 0, largeW = 0, largeH = 0;
     SDL_GetTextureSize(small, &smallW, &smallH);
@@ -232,19 +256,19 @@ void EditorUI::drawTilePalette(SDL_State& state, const EditorUIModel& m) {
     SDL_FRect smallDst { baseX,          baseY,      64, 64 };
     SDL_FRect largeDst { baseX + 100.f,  baseY - 10, 64, 96 };
 
-    SDL_RenderTexture(state.renderer, small, nullptr, &smallDst);
-    SDL_RenderTexture(state.renderer, large, nullptr, &largeDst);
+    Render::Texture(state.renderer, small, nullptr, &smallDst);
+    Render::Texture(state.renderer, large, nullptr, &largeDst);
 
     SDL_SetRenderDrawColor(state.renderer, 255, 220, 0, 200);
-    if (m.selectedTileIndex == 1) SDL_RenderRect(state.renderer, &smallDst);
-    else                          SDL_RenderRect(state.renderer, &largeDst);
+    if (m.selectedTileIndex == 1) Render::Rect(state.renderer, &smallDst);
+    else                          Render::Rect(state.renderer, &largeDst);
     return;
   }
 }
 
 void EditorUI::drawSavePopup(SDL_State& state) {
-  int textW = 0, textH = 0;
-  TTF_GetTextSize(TTF_CreateText(nullptr, UI::Text::getFont(Text::FontType::Medium), savePopupText.c_str(), savePopupText.length()), &textW, &textH);
+  const float textW = savePopupSize.x;
+  const float textH = savePopupSize.y;
 
   const float paddingX = 40.f;
   const float paddingY = 20.f;
@@ -257,12 +281,12 @@ void EditorUI::drawSavePopup(SDL_State& state) {
   SDL_SetRenderDrawBlendMode(state.renderer, SDL_BLENDMODE_BLEND);
   SDL_SetRenderDrawColor(state.renderer, 0, 0, 0, 180);
   SDL_FRect rect{ popupX, popupY, popupW, popupH };
-  SDL_RenderFillRect(state.renderer, &rect);
+  Render::FillRect(state.renderer, &rect);
 
   SDL_SetRenderDrawColor(state.renderer, 255, 255, 255, 180);
-  SDL_RenderRect(state.renderer, &rect);
+  Render::Rect(state.renderer, &rect);
 
-  UI::Text::displayText(savePopupText, { popupX + paddingX, popupY + paddingY / 2.f });
+  UI::Text::displayText(savePopupLabel.view(), { popupX + paddingX, popupY + paddingY / 2.f });
 }
 
 
@@ -304,8 +328,20 @@ void EditorUI::handleSaveDialogEvent(SDL_Window* window, const SDL_Event& event)
   }
 }
 
-void EditorUI::drawSaveDialog(SDL_State& state) {
-  const float w = 450.f;
+void EditorUI::drawNameInputDialog(SDL_State& state, const RichTextView& title, const RichTextView& hint,
+                                   const std::string& input, UI::Text::FontType titleFont) {
+  const float labelX = 20.f;
+  const float inputX = 90.f;
+
+  // Dialogen vokser med navnet, så lange navne ikke løber ud over kanten
+  // Måles kun igen når navnet ændres eller en anden dialog åbnes
+  const float cursorW = nameDialogMeasure.cursor.get("_").x;
+  const float inputW  = nameDialogMeasure.input.get(input).x + cursorW;
+  const float hintW   = nameDialogMeasure.hint.get(hint).x;
+  const float titleW  = nameDialogMeasure.title.get(title, titleFont).x;
+  const float contentW = std::max({ inputX + inputW, labelX + hintW, labelX + titleW });
+
+  const float w = std::max(450.f, contentW + 2.f * labelX);
   const float h = 150.f;
   const float x = (state.windowWidth - w) / 2.f;
   const float y = (state.windowHeight - h) / 2.f;
@@ -313,16 +349,22 @@ void EditorUI::drawSaveDialog(SDL_State& state) {
   SDL_SetRenderDrawBlendMode(state.renderer, SDL_BLENDMODE_BLEND);
   SDL_SetRenderDrawColor(state.renderer, 20, 20, 30, 230);
   SDL_FRect rect { x, y, w, h };
-  SDL_RenderFillRect(state.renderer, &rect);
+  Render::FillRect(state.renderer, &rect);
 
   SDL_SetRenderDrawColor(state.renderer, 255, 255, 255, 180);
-  SDL_RenderRect(state.renderer, &rect);
+  Render::Rect(state.renderer, &rect);
+
+  UI::Text::displayText(title, { x + labelX, y + 20.f }, titleFont);
+  UI::Text::displayText("Name:"_rich, { x + labelX, y + 60.f });
+  UI::Text::displayText(input, { x + inputX, y + 60.f });
+  UI::Text::displayText("_", { x + inputX + inputW - cursorW, y + 60.f });
 
-  UI::Text::displayText("{green}Save Scene", { x + 20.f, y + 20.f }, UI::Text::FontType::Large);
-  UI::Text::displayText("Name:", { x + 20.f, y + 60.f });
-  UI::Text::displayText(sceneNameInput + "_", { x + 90.f, y + 60.f });
+  UI::Text::displayText(hint, { x + labelX, y + 100.f });
+}
 
-  UI::Text::displayText("{gray}(ENTER = save, ESC = cancel)", { x + 20.f, y + 100.f });
+void EditorUI::drawSaveDialog(SDL_State& state) {
+  drawNameInputDialog(state, "{green}Save Scene"_rich, "{gray}(ENTER = save, ESC = cancel)"_rich,
+                      sceneNameInput, UI::Text::FontType::Large);
 }
 
 void EditorUI::openLoadMenu(const std::function<void(const std::string&)>& onLoad) {
@@ -379,6 +421,16 @@ void EditorUI::refreshSceneList() {
   }
 
   std::sort(availableScenes.begin(), availableScenes.end());
+
+  // Scene navnene ændrer sig kun her, så markup kompileres én gang
+  sceneListLabels.clear();
+  sceneListLabels.reserve(availableScenes.size());
+  sceneListWidth = 0.f;
+  for(const auto& scene : availableScenes) {
+    SceneListLabel label { RichText(scene), RichText("{cyan}> " + scene + " <") };
+    sceneListWidth = std::max(sceneListWidth, UI::Text::measureText(label.selected.view()).x);
+    sceneListLabels.push_back(std::move(label));
+  }
 }
 
 void EditorUI::handleLoadMenuEvent(SDL_State& state, const SDL_Event& event) {
@@ -401,8 +453,7 @@ void EditorUI::handleLoadMenuEvent(SDL_State& state, const SDL_Event& event) {
   }
 
   if(event.type == SDL_EVENT_MOUSE_BUTTON_DOWN && event.button.button == SDL_BUTTON_LEFT) {
-    float mx, my;
-    SDL_GetMouseState(&mx, &my);
+    const float mx = state.mouseX, my = state.mouseY;
 
     const float startY = 200.f;
     const float lineHeight = 30.f;
@@ -436,33 +487,30 @@ void EditorUI::drawLoadMenu(SDL_State& state) {
   SDL_SetRenderDrawBlendMode(state.renderer, SDL_BLENDMODE_BLEND);
   SDL_SetRenderDrawColor(state.renderer, 20, 20, 30, 230);
   SDL_FRect rect { x, y, w, h };
-  SDL_RenderFillRect(state.renderer, &rect);
+  Render::FillRect(state.renderer, &rect);
   SDL_SetRenderDrawColor(state.renderer, 255, 255, 255, 180);
-  SDL_RenderRect(state.renderer, &rect);
+  Render::Rect(state.renderer, &rect);
 
-  UI::Text::displayText("{green}Choose Scene", { x + 30.f, y + 20.f }, UI::Text::FontType::Title);
+  UI::Text::displayText("{green}Choose Scene"_rich, { x + 30.f, y + 20.f }, UI::Text::FontType::Title);
 
   float listX = x + 20.f;
   float listY = y + 70.f;
-  float listW = 300.f;
+  float listW = std::clamp(sceneListWidth, 300.f, w - 240.f);
   float lineH = 28.f;
 
   if(availableScenes.empty()) {
-    UI::Text::displayText("{red} No scenes found in 'scenes/'", { x + 20.f, y + 80.f });
+    UI::Text::displayText("{red} No scenes found in 'scenes/'"_rich, { x + 20.f, y + 80.f });
 
     float newSceneY = listY + availableScenes.size() * lineH + 10.f;
-    UI::Text::displayText("{green}> Create a new scene! (press 'N')", { x + 20.f, y + 140.f });
+    UI::Text::displayText("{green}> Create a new scene! (press 'N')"_rich, { x + 20.f, y + 140.f });
     return;
   }
 
 
   for(size_t i = 0; i < availableScenes.size(); ++i) {
-    std::string text = availableScenes[i];
-    if((int) i == selectedSceneIndex) {
-      text = "{cyan}> " + text + " <";
-    }
-
-    UI::Text::displayText(text, { listX, listY + i * lineH });
+    const auto& labels = sceneListLabels[i];
+    const RichText& text = ((int) i == selectedSceneIndex) ? labels.selected : labels.normal;
+    UI::Text::displayText(text.view(), { listX, listY + i * lineH });
   }
 
   float thumbAreaX = x + listW + 40.f;
@@ -472,9 +520,16 @@ void EditorUI::drawLoadMenu(SDL_State& state) {
 
   SDL_FRect thRect { thumbAreaX, thumbAreaY, thumbAreaW, thumbAreaH };
   SDL_SetRenderDrawColor(state.renderer, 255, 255, 255, 50);
-  SDL_RenderRect(state.renderer, &thRect);
+  Render::Rect(state.renderer, &thRect);
+
+  const std::string& selectedScene = availableScenes[selectedSceneIndex];
+  SDL_Texture* th = getSceneThumbnail(state.renderer, selectedScene);
+  for (int d = 1; d <= THUMBNAIL_PREFETCH; ++d) {
+    for (int i : { selectedSceneIndex - d, selectedSceneIndex + d }) {
+      if (i >= 0 && i < (int)availableScenes.size()) requestThumbnail(state.renderer, availableScenes[i], Jobs::Priority::Prefetch);
+    }
+  }
 
-  SDL_Texture* th = getSceneThumbnail(state.renderer, availableScenes[selectedSceneIndex]);
   if(th) {
     float tw, thh;
     SDL_GetTextureSize(th, &tw, &thh);
@@ -487,19 +542,33 @@ void EditorUI::drawLoadMenu(SDL_State& state) {
       dw, dh
     };
 
-    SDL_RenderTexture(state.renderer, th, nullptr, &dst);
+    Render::Texture(state.renderer, th, nullptr, &dst);
+  } else if (thumbnailsPending.contains(selectedScene)) {
+    UI::Text::displayText("{gray}(Loading thumbnail...)"_rich, { thumbAreaX + 10.f, thumbAreaY + 10.f });
   } else {
-    UI::Text::displayText("{gray}(Couldn't build thumbnail)", { thumbAreaX + 10.f, thumbAreaY + 10.f });
+    UI::Text::displayText("{gray}(Couldn't build thumbnail)"_rich, { thumbAreaX + 10.f, thumbAreaY + 10.f });
   }
 
   float newSceneY = listY + availableScenes.size() * lineH + 10.f;
-  UI::Text::displayText("{yellow}> New Scene (press 'N')", { listX, newSceneY });
+  UI::Text::displayText("{yellow}> New Scene (press 'N')"_rich, { listX, newSceneY });
+
+  UI::Text::displayText("{gray}(ENTER = load, ESC = back)"_rich, { x + 20.f, y + h - 40.f });
+
+}
 
-  UI::Text::displayText("{gray}(ENTER = load, ESC = back)", { x + 20.f, y + h - 40.f });
+void EditorUI::closeLoadMenu() {
+  showLoadMenu = false;
+  cancelThumbnails();
+}
 
+void EditorUI::cancelThumbnails() {
+  if (thumbnailToken) thumbnailToken->cancel();
+  thumbnailToken = nullptr;
+  thumbnailsPending.clear();
 }
 
 void EditorUI::clearSceneThumbnails() {
+  cancelThumbnails();
   for(auto& [name, tex] : sceneThumbnails) {
     if(tex) SDL_DestroyTexture(tex);
   }
@@ -510,9 +579,29 @@ SDL_Texture* EditorUI::getSceneThumbnail(SDL_Renderer* renderer, const std::stri
   auto it = sceneThumbnails.find(sceneName);
   if(it != sceneThumbnails.end()) return it->second;
 
-  SDL_Texture* t = Scene::BuildSceneThumbnail(renderer, sceneName, thumbW, thumbH);
-  sceneThumbnails[sceneName] = t;
-  return t;
+  requestThumbnail(renderer, sceneName, Jobs::Priority::Visible);
+  return nullptr;
+}
+
+void EditorUI::requestThumbnail(SDL_Renderer* renderer, const std::string& sceneName, Jobs::Priority priority) {
+  if (sceneThumbnails.contains(sceneName)) return;
+  // En prefetch der bliver valgt bestilles igen som Visible - den der bliver færdig først vinder
+  auto pending = thumbnailsPending.find(sceneName);
+  if (pending != thumbnailsPending.end() && pending->second <= priority) return;
+  thumbnailsPending[sceneName] = priority;
+
+  if (!thumbnailToken) thumbnailToken = Jobs::CancelToken::Make();
+  Jobs::Submit("ThumbnailLayout", [this, renderer, sceneName, priority, token = thumbnailToken, w = thumbW, h = thumbH] {
+    if (token->cancelled()) return;
+    auto layout = std::make_shared<const Scene::Layout>(sceneName);
+
+    Jobs::RunOnMainThread([this, renderer, sceneName, layout, w, h] {
+      if (sceneThumbnails.contains(sceneName)) return;
+      sceneThumbnails[sceneName] = Scene::BuildSceneThumbnail(renderer, *layout, sceneName, w, h);
+      thumbnailsPending.erase(sceneName);
+      if (onThumbnailReady) onThumbnailReady();
+    }, priority, token);
+  });
 }
 
 void EditorUI::handleNewSceneDialogEvent(SDL_Window* window, const SDL_Event& event) {
@@ -547,22 +636,8 @@ void EditorUI::handleNewSceneDialogEvent(SDL_Window* window, const SDL_Event& ev
 }
 
 void EditorUI::drawNewSceneDialog(SDL_State& state) {
-  const float w = 450.f;
-  const float h = 150.f;
-  const float x = (state.windowWidth - w) / 2.f;
-  const float y = (state.windowHeight - h) / 2.f;
-
-  SDL_SetRenderDrawBlendMode(state.renderer, SDL_BLENDMODE_BLEND);
-  SDL_SetRenderDrawColor(state.renderer, 20, 20, 30, 230);
-  SDL_FRect rect { x, y, w, h };
-  SDL_RenderFillRect(state.renderer, &rect);
-  SDL_SetRenderDrawColor(state.renderer, 255, 255, 255, 180);
-  SDL_RenderRect(state.renderer, &rect);
-
-  UI::Text::displayText("{green}Create new scene", { x + 20.f, y + 20.f });
-  UI::Text::displayText("Name:", { x + 20.f, y + 60.f });
-  UI::Text::displayText(newSceneNameInput + "_", { x + 90.f, y + 60.f });
-  UI::Text::displayText("{gray}(ENTER = create, ESC = cancel)", { x + 20.f, y + 100.f });
+  drawNameInputDialog(state, "{green}Create new scene"_rich, "{gray}(ENTER = create, ESC = cancel)"_rich,
+                      newSceneNameInput, UI::Text::FontType::Medium);
 }
 
 
@@ -11,6 +11,8 @@
 #include "sdl/SDL_Handler.hpp"
 #include "logging/Logger.hpp"
 #include "scene/Scene.hpp"
+#include "jobs/JobSystem.hpp"
+#include "PaintTools.hpp"
 
 namespace UI {
 struct EditorUIModel {
@@ -22,6 +24,7 @@ struct EditorUIModel {
   SDL_Texture*selectedTexture = nullptr;
   int         maxIndex = 0;
   int         tileSize = TILE_SIZE;
+  PaintTool   paintTool = PaintTool::Brush;
 };
 
 struct EditorUICallbacks {
@@ -43,6 +46,8 @@ public:
                      const EditorUIModel& m, const EditorUICallbacks& cb);
 
   void showSave(const std::string& msg);
+  /* Tid til popup'en forsvinder (ms), -1 når den ikke vises */
+  int popupRemainingMs() const;
 
   bool paletteVisible() const { return showTilePalette; }
   void setPaletteVisible(bool v) { showTilePalette = v; }
@@ -52,10 +57,20 @@ public:
   bool newSceneDialogVisible() const { return showNewSceneDialog; }
   void openSaveDialog(SDL_Window* window, const std::string& defaultName, const std::function<void(const std::string&)>& onSave);
   void openLoadMenu(const std::function<void(const std::string&)>& onLoad);
+  /* Lukker menuen og dropper de thumbnails der stadig er undervejs */
+  void closeLoadMenu();
+
+  /* Til bench --dialog-check: thumbnail textures UI'en ejer, og om nogen stadig bygges */
+  size_t thumbnailCount() const { return sceneThumbnails.size(); }
+  bool thumbnailsLoading() const { return !thumbnailsPending.empty(); }
+
+  /* Kaldes på main tråden når en thumbnail er færdig (editoren tegner en frame mere) */
+  std::function<void()> onThumbnailReady = nullptr;
 
 private:
   bool  showSavePopup = false;
-  std::string savePopupText;
+  RichText    savePopupLabel;
+  Vec2<float> savePopupSize;   // måles én gang i showSave()
   float savePopupTimer = 0.0f;
   static constexpr float SAVE_POPUP_DURATION = 2.5f;
 
@@ -67,6 +82,8 @@ private:
   float paletteMargin   = 8.f;
   float palettePadding  = 4.f;
   int   hoveredTileIndex = -1;
+  SDL_Texture* palmSmallTexture = nullptr;
+  SDL_Texture* palmLargeTexture = nullptr;
 
   void drawHUD(SDL_State& state, const EditorUIModel& m);
   void drawTilePalette(SDL_State& state, const EditorUIModel& m);
@@ -75,11 +92,25 @@ private:
   std::string sceneNameInput;
   std::function<void(const std::string&)> onSaveScene = nullptr;
 
+  // Save og new-scene dialogerne deler én, kun én af dem er åben ad gangen
+  struct NameDialogMeasure {
+    UI::MeasureCache title, hint, input, cursor;
+  } nameDialogMeasure;
+
   void drawSaveDialog(SDL_State& state);
+  void drawNameInputDialog(SDL_State& state, const RichTextView& title, const RichTextView& hint,
+                           const std::string& input, UI::Text::FontType titleFont);
   void handleSaveDialogEvent(SDL_Window* window, const SDL_Event& event);
 
   bool showLoadMenu = false;
   std::vector<std::string> availableScenes;
+
+  struct SceneListLabel {
+    RichText normal;
+    RichText selected;
+  };
+  std::vector<SceneListLabel> sceneListLabels;
+  float sceneListWidth = 0.f;  // bredeste label, målt i refreshSceneList()
   int selectedSceneIndex = 0;
   std::function<void(const std::string&)> onLoadScene = nullptr;
 
@@ -87,10 +118,20 @@ private:
   void handleLoadMenuEvent(SDL_State& state, const SDL_Event& event);
   void refreshSceneList();
 
-  std::unordered_map<std::string, SDL_Texture*> sceneThumbnails;
+  /*
+   * Thumbnails bygges i to trin: CSV filerne parses som et job, og rendering sker som en
+   * main-thread task. Den valgte scene er Visible, naboerne i listen hentes som Prefetch
+   */
+  static constexpr int THUMBNAIL_PREFETCH = 2;
+  std::unordered_map<std::string, SDL_Texture*> sceneThumbnails;      // nullptr = kunne ikke bygges
+  std::unordered_map<std::string, Jobs::Priority> thumbnailsPending;
+  Jobs::CancelTokenPtr thumbnailToken;
   int thumbW = 240, thumbH = 135;
 
+  /* Færdig thumbnail eller nullptr - bestiller den hvis den mangler */
   SDL_Texture* getSceneThumbnail(SDL_Renderer* renderer, const std::string& sceneName);
+  void requestThumbnail(SDL_Renderer* renderer, const std::string& sceneName, Jobs::Priority priority);
+  void cancelThumbnails();
   void clearSceneThumbnails();
 
   bool showNewSceneDialog = false;
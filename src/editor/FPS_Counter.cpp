@@ -1,20 +1,26 @@
 #include "FPS_Counter.hpp"
 #include "ui/TextHandler.hpp"
+#include "jobs/JobSystem.hpp"
 
 FPS_Counter::FPS_Counter()
- : now(SDL_GetTicks())
- , last(0)
- , fpsTimer(0.0)
- , fps(0)
+ : fpsTimer(0.0)
  , frameCount(0)
+ , fps(0)
 {
   Log::Info("FPS_Counter oprettet");
 }
 
+void FPS_Counter::handleEvent(const SDL_Event& event) noexcept {
+  if (event.type == SDL_EVENT_KEY_DOWN && event.key.key == SDLK_F3 && !event.key.repeat) {
+    showOverlay = !showOverlay;
+    Memory::AllocTracker::resetPeak(); // peak gælder fra overlayet blev åbnet
+  }
+}
+
 void FPS_Counter::update(SDL_State& state) noexcept {
 
   frameCount++;
-  fpsTimer += state.deltaTime; // deltaTime = tid siden sidste frame i sekunder
+  fpsTimer += state.deltaTime; // hele intervallet mellem frames (nanosekund-tæller), inkl. ventetid fra frame cap
 
   if (fpsTimer >= 1.0) { // opdater FPS én gang per sekund
       fps = frameCount;   // antal frames på 1 sekund = FPS
@@ -22,6 +28,166 @@ void FPS_Counter::update(SDL_State& state) noexcept {
       fpsTimer -= 1.0;    // træk 1 sekund fra timeren (bevarer evt. overskydende tid)
   }
 
+  Render::SubsystemScope renderScope(Render::Subsystem::Overlay);
+
   // Vis FPS
-  UI::Text::displayText("FPS: {green}" + std::to_string(int(fps)), Vec2<float>(10, 10));
+  char line[32];
+  UI::Text::displayText(UI::FormatTo(line, "FPS: {{green}}{}", fps), Vec2<float>(10, 10));
+
+  if (showOverlay) drawOverlay(state);
+}
+
+void FPS_Counter::drawOverlay(SDL_State& state) {
+  using Profiling::Profiler;
+  using UI::Text;
+
+  const auto& report = Profiler::report();
+  const float lineH = 18.f;
+  const float graphH = 80.f;
+
+  // Render tal fra sidste hele frame - kun subsystemer der faktisk tegnede noget
+  const auto& renderStats = Render::LastFrame();
+  int renderRows = 0;
+  for (const auto& c : renderStats.subsystems) {
+    if (c.drawCalls > 0 || c.alphaModChanges > 0 || c.targetSwitches > 0) ++renderRows;
+  }
+
+  SDL_FRect box { 10.f, 140.f, 640.f, 0.f };
+  box.h = 60.f + (report.scopeCount + 7) * lineH + (renderRows + 2.5f) * lineH + graphH;
+
+  SDL_SetRenderDrawBlendMode(state.renderer, SDL_BLENDMODE_BLEND);
+  SDL_SetRenderDrawColor(state.renderer, 10, 10, 16, 200);
+  Render::FillRect(state.renderer, &box);
+  SDL_SetRenderDrawColor(state.renderer, 255, 255, 255, 80);
+  Render::Rect(state.renderer, &box);
+
+  // Tekst formateres i en buffer på stakken, så overlayet ikke allokerer hver frame
+  char line[128];
+  auto print = [&](float x, float y, std::string_view text) {
+    Text::displayText(text, {x, y}, Text::FontType::Small);
+  };
+
+  float y = box.y + 8.f;
+  if (!Profiler::enabled()) {
+    print(box.x + 8.f, y, "{yellow}Profiling disabled in this build");
+    y += lineH;
+  }
+
+  print(box.x + 8.f, y, UI::FormatTo(line, "{{white}}Frame  avg {:.2f}  p95 {:.2f}  p99 {:.2f}  max {:.2f} ms",
+        report.avgMs, report.p95Ms, report.p99Ms, report.maxMs));
+  y += lineH;
+
+  // Allokeringer på main tråden - steady-state frames skal ligge på 0
+  using Memory::AllocTracker;
+  if (AllocTracker::enabled()) {
+    const auto& allocs = AllocTracker::lastFrame();
+    print(box.x + 8.f, y, UI::FormatTo(line, "{}Allocs  last {}  ({} B)  avg {:.1f}  peak {}",
+          allocs.allocs > 0 ? "{yellow}" : "{white}", allocs.allocs, allocs.bytes, report.allocs,
+          AllocTracker::peakFrameAllocs()));
+  } else {
+    print(box.x + 8.f, y, "{gray}Allocation tracking disabled in this build");
+  }
+  y += lineH;
+
+  // Frame pacing: interval mod målet (vsync refresh eller frame cap), jitter og frames der missede
+  const auto pacing = Timing::FrameScheduler::stats();
+  if (pacing.targetMs > 0.0) {
+    print(box.x + 8.f, y, UI::FormatTo(line, "{}Pacing  {} {:.2f} ms  avg {:.2f}  jitter {:.2f}  missed {} ({})  steps {}",
+          pacing.missed > 0 ? "{yellow}" : "{white}", pacing.vsync ? "vsync" : "cap", pacing.targetMs,
+          pacing.avgMs, pacing.jitterMs, pacing.missed, pacing.totalMissed, pacing.stepsLastFrame));
+  } else {
+    print(box.x + 8.f, y, UI::FormatTo(line, "{{white}}Pacing  uncapped  avg {:.2f} ms  jitter {:.2f}  steps {}",
+          pacing.avgMs, pacing.jitterMs, pacing.stepsLastFrame));
+  }
+  y += lineH;
+
+  // Hvorfor der blev tegnet - uden grunde venter main loopet på input (overlayet selv er altid en grund)
+  if (redrawOnDemand) {
+    char now[64];
+    char timed[64];
+    print(box.x + 8.f, y, UI::FormatTo(line, "{{white}}Redraw  now {}  timed {} ({} ms)  idle waits {} ({:.0f} ms)",
+          Redraw::Describe(lastRedraw.now, now, sizeof(now)), Redraw::Describe(lastRedraw.timed, timed, sizeof(timed)),
+          lastRedraw.waitMs, pacing.idleWaits, pacing.lastIdleMs));
+  } else {
+    print(box.x + 8.f, y, "{gray}Redraw  every frame (on-demand disabled)");
+  }
+  y += lineH;
+
+  // Frame arena: brug i sidste frame og højeste nogensinde - overflow betyder at kapaciteten er for lille
+  using Memory::FrameArena;
+  print(box.x + 8.f, y, UI::FormatTo(line, "{}Arena  last {} KB  peak {} / {} KB  overflow {}",
+        FrameArena::overflows() > 0 ? "{yellow}" : "{white}", FrameArena::lastFrameUsed() / 1024,
+        FrameArena::peak() / 1024, FrameArena::capacity() / 1024, FrameArena::overflows()));
+  y += lineH;
+
+  // Job systemet: summen over workers (og main når den hjælper) - per worker tider står i tracen
+  const Jobs::Stats jobs = Jobs::GetStats();
+  print(box.x + 8.f, y, UI::FormatTo(line, "{{white}}Jobs  {} workers  queued {}  done {}  stolen {}  busy {:.0f} ms",
+        jobs.workers, jobs.queued, jobs.jobs, jobs.steals, jobs.busyMs));
+  y += lineH;
+
+  // Render-tråd tasks: kø per prioritet og frames hvor budgettet ikke holdt
+  const auto mainTasks = Jobs::MainThreadScheduler::stats();
+  print(box.x + 8.f, y, UI::FormatTo(line, "{}Main tasks  visible {}  prefetch {}  ran {} ({:.2f} ms)  overruns {} (worst {:.1f} ms)  cancelled {}",
+        mainTasks.usedMsLastFrame > Jobs::MainThreadScheduler::DEFAULT_BUDGET_MS ? "{yellow}" : "{white}",
+        mainTasks.queued[static_cast<int>(Jobs::Priority::Visible)], mainTasks.queued[static_cast<int>(Jobs::Priority::Prefetch)],
+        mainTasks.ranLastFrame, mainTasks.usedMsLastFrame, mainTasks.overruns, mainTasks.worstOverrunMs, mainTasks.cancelled));
+  y += lineH * 1.5f;
+
+  print(box.x + 8.f,   y, "{gray}Scope");
+  print(box.x + 300.f, y, "{gray}avg     p95     p99    alloc");
+  y += lineH;
+
+  for (int i = 0; i < report.scopeCount; ++i) {
+    const auto& s = report.scopes[i];
+    print(box.x + 8.f + s.depth * 14.f, y, s.name);
+    print(box.x + 300.f, y, UI::FormatTo(line, "{{green}}{:6.2f}  {:6.2f}  {:6.2f}  {}{:5.1f}", s.avgMs, s.p95Ms, s.p99Ms,
+          s.allocs > 0.0 ? "{yellow}" : "{gray}", s.allocs));
+    y += lineH;
+  }
+
+  y += lineH * 0.5f;
+  print(box.x + 8.f,   y, "{gray}Render");
+  print(box.x + 300.f, y, "{gray}draws  binds  alpha  target");
+  y += lineH;
+
+  auto printCounters = [&](const char* name, const Render::Counters& c) {
+    print(box.x + 8.f, y, name);
+    print(box.x + 300.f, y, UI::FormatTo(line, "{{cyan}}{:5}  {:5}  {:5}  {:6}",
+          c.drawCalls, c.textureBinds, c.alphaModChanges, c.targetSwitches));
+    y += lineH;
+  };
+
+  for (size_t i = 0; i < renderStats.subsystems.size(); ++i) {
+    const auto& c = renderStats.subsystems[i];
+    if (c.drawCalls == 0 && c.alphaModChanges == 0 && c.targetSwitches == 0) continue;
+    printCounters(Render::SubsystemName(static_cast<Render::Subsystem>(i)), c);
+  }
+  printCounters("{white}Total", renderStats.total());
+
+  // Frame tids-graf - skaleret så 33 ms fylder hele højden
+  const float graphX = box.x + 8.f;
+  const float graphW = box.w - 16.f;
+  const float graphY = box.y + box.h - graphH - 8.f;
+  const float scaleMs = 33.3f;
+
+  SDL_SetRenderDrawColor(state.renderer, 255, 255, 255, 40);
+  SDL_FRect graphRect { graphX, graphY, graphW, graphH };
+  Render::Rect(state.renderer, &graphRect);
+
+  // 16.6 ms (60 FPS) reference
+  const float refY = graphY + graphH - (16.6f / scaleMs) * graphH;
+  SDL_SetRenderDrawColor(state.renderer, 180, 180, 0, 120);
+  Render::Line(state.renderer, graphX, refY, graphX + graphW, refY);
+
+  const int count = Profiler::frameTimes(graphTimes);
+  if (count > 1) {
+    const float step = graphW / (Profiler::FRAME_HISTORY - 1);
+    for (int i = 0; i < count; ++i) {
+      const float t = std::min(graphTimes[i] / scaleMs, 1.0f);
+      graphPoints[i] = { graphX + i * step, graphY + graphH - t * graphH };
+    }
+    SDL_SetRenderDrawColor(state.renderer, 0, 200, 120, 220);
+    Render::Lines(state.renderer, graphPoints.data(), count);
+  }
 }
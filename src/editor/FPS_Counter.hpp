@@ -7,18 +7,36 @@
 #include <SDL3_ttf/SDL_ttf.h>
 #include "sdl/SDL_Handler.hpp"
 #include "logging/Logger.hpp"
+#include "profiling/Profiler.hpp"
+#include "memory/FrameArena.hpp"
+#include "timing/FrameScheduler.hpp"
+#include "Redraw.hpp"
+#include "sdl/Render.hpp"
+#include <array>
 #include <cstdint>
 
 class FPS_Counter {
 public:
     FPS_Counter();
     ~FPS_Counter() = default;
+    void handleEvent(const SDL_Event& event) noexcept;
     void update(SDL_State& state) noexcept;
+
+    bool overlayVisible() const { return showOverlay; }
+    /* Seneste frames redraw grunde til overlayet (on-demand tegning i main) */
+    void setRedraw(const Redraw::Request& request, bool onDemand) { lastRedraw = request; redrawOnDemand = onDemand; }
 private:
+    void drawOverlay(SDL_State& state);
+
     SDL_FRect rect;
-    std::uint64_t now;
-    std::uint64_t last;
     double fpsTimer;
     int frameCount;
     int fps;
+
+    // Profiler overlay (F3)
+    bool showOverlay = false;
+    Redraw::Request lastRedraw;
+    bool redrawOnDemand = false;
+    std::array<float, Profiling::Profiler::FRAME_HISTORY> graphTimes {};
+    std::array<SDL_FPoint, Profiling::Profiler::FRAME_HISTORY> graphPoints {};
 };
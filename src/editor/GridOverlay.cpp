@@ -0,0 +1,80 @@
+#include "GridOverlay.hpp"
+
+#include <cmath>
+
+#include "logging/Logger.hpp"
+#include "resources/ResourceManager.hpp"
+#include "sdl/Render.hpp"
+
+GridOverlay::~GridOverlay() {
+  if (texture) SDL_DestroyTexture(texture);
+}
+
+void GridOverlay::invalidate() {
+  if (texture) SDL_DestroyTexture(texture);
+  texture = nullptr;
+  cachedWidth = 0;
+  cachedHeight = 0;
+  failed = false;
+}
+
+bool GridOverlay::rebuild(SDL_Renderer* renderer, int width, int height, SDL_Color color) {
+  if (texture) SDL_DestroyTexture(texture);
+  texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, width, height);
+  if (!texture) {
+    Log::Warn(Log::Category::Render, "Kunne ikke oprette grid texture ({}x{}) - tegner linjerne direkte", width, height);
+    failed = true;
+    return false;
+  }
+
+  SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+  Render::SetTarget(renderer, texture);
+  SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0);
+  Render::Clear(renderer);
+
+  // Samme linjer som før: lodrette fra første række og ned, vandrette for hver række
+  SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a);
+  for (int x = 0; x < width; x += TILE_SIZE) {
+    Render::Line(renderer, x, TILE_SIZE, x, height);
+  }
+  for (int y = TILE_SIZE; y < height; y += TILE_SIZE) {
+    Render::Line(renderer, 0, y, width, y);
+  }
+
+  Render::SetTarget(renderer, nullptr);
+  cachedWidth = width;
+  cachedHeight = height;
+  return true;
+}
+
+void GridOverlay::drawLines(SDL_Renderer* renderer, float windowWidth, float windowHeight, float mapOffsetY, float cameraX, SDL_Color color) const {
+  const float phase = cameraX - std::floor(cameraX / TILE_SIZE) * TILE_SIZE;
+  SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a);
+  for (float x = -phase; x <= windowWidth; x += TILE_SIZE) {
+    Render::Line(renderer, x, TILE_SIZE + mapOffsetY, x, windowHeight);
+  }
+  for (float y = TILE_SIZE; y + mapOffsetY <= windowHeight; y += TILE_SIZE) {
+    Render::Line(renderer, 0, y + mapOffsetY, windowWidth, y + mapOffsetY);
+  }
+}
+
+void GridOverlay::draw(SDL_Renderer* renderer, float windowWidth, float windowHeight, float mapOffsetY, float cameraX, SDL_Color color) {
+  const int width = static_cast<int>(std::ceil(windowWidth)) + TILE_SIZE;
+  const int height = static_cast<int>(std::ceil(windowHeight - mapOffsetY)) + 1;
+  if (width <= TILE_SIZE || height <= 1) return;
+
+  if (failed) {
+    drawLines(renderer, windowWidth, windowHeight, mapOffsetY, cameraX, color);
+    return;
+  }
+  if ((!texture || width != cachedWidth || height != cachedHeight) && !rebuild(renderer, width, height, color)) {
+    drawLines(renderer, windowWidth, windowHeight, mapOffsetY, cameraX, color);
+    return;
+  }
+
+  // Kameraets position inden for én tile - resten af forskydningen er bare en hel tile mere
+  const float phase = cameraX - std::floor(cameraX / TILE_SIZE) * TILE_SIZE;
+  const SDL_FRect src { phase, 0.f, windowWidth, static_cast<float>(height) };
+  const SDL_FRect dst { 0.f, mapOffsetY, windowWidth, static_cast<float>(height) };
+  Render::Texture(renderer, texture, &src, &dst);
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "SDL3/SDL_pixels.h"
+#include "SDL3/SDL_render.h"
+
+/*
+ * Editorens grid tegnet én gang i en render target texture (én tile bredere end vinduet)
+ * og vist med kameraets forskydning inden for en tile som src offset. Bygges kun om når
+ * vinduet skifter størrelse eller rendereren har mistet sine targets.
+ */
+class GridOverlay {
+  public:
+    GridOverlay() = default;
+    ~GridOverlay();
+
+    GridOverlay(const GridOverlay&) = delete;
+    GridOverlay& operator=(const GridOverlay&) = delete;
+
+    /* Tegner grid'et fra mapOffsetY og ned til bunden af vinduet */
+    void draw(SDL_Renderer* renderer, float windowWidth, float windowHeight, float mapOffsetY, float cameraX, SDL_Color color);
+
+    /* Næste draw bygger texturen igen (SDL_EVENT_RENDER_TARGETS_RESET) */
+    void invalidate();
+
+  private:
+    bool rebuild(SDL_Renderer* renderer, int width, int height, SDL_Color color);
+    void drawLines(SDL_Renderer* renderer, float windowWidth, float windowHeight, float mapOffsetY, float cameraX, SDL_Color color) const;
+
+    SDL_Texture* texture = nullptr;
+    int cachedWidth = 0;
+    int cachedHeight = 0;
+    bool failed = false;  // ingen render targets - tegn linjerne direkte
+};
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "SDL3/SDL_pixels.h"
+#include "SDL3/SDL_rect.h"
+#include "SDL3/SDL_render.h"
+#include "memory/FrameArena.hpp"
+#include "sdl/Render.hpp"
+
+/*
+ * Farvede rects og outlines (hover, markering, værktøjs-preview) samlet til ét
+ * SDL_RenderGeometry kald. Vertices ligger i frame arenaen, så en batch lever kun i én frame.
+ * Blend mode er rendererens draw blend mode - flush sætter BLEND.
+ */
+class OverlayBatch {
+  public:
+    OverlayBatch()
+      : vertices(Memory::FrameArena::vector<SDL_Vertex>())
+      , indices(Memory::FrameArena::vector<int>())
+    {
+      vertices.reserve(64);
+      indices.reserve(96);
+    }
+
+    void fillRect(const SDL_FRect& r, SDL_Color color) {
+      const SDL_FColor c { color.r / 255.f, color.g / 255.f, color.b / 255.f, color.a / 255.f };
+      const int base = static_cast<int>(vertices.size());
+      vertices.push_back({ { r.x,       r.y       }, c, { 0.f, 0.f } });
+      vertices.push_back({ { r.x + r.w, r.y       }, c, { 0.f, 0.f } });
+      vertices.push_back({ { r.x + r.w, r.y + r.h }, c, { 0.f, 0.f } });
+      vertices.push_back({ { r.x,       r.y + r.h }, c, { 0.f, 0.f } });
+      for (int i : { 0, 1, 2, 0, 2, 3 }) indices.push_back(base + i);
+    }
+
+    /* 1 px kant inden for rect'en, ligesom SDL_RenderRect */
+    void outlineRect(const SDL_FRect& r, SDL_Color color) {
+      if (r.w <= 0.f || r.h <= 0.f) return;
+      fillRect({ r.x, r.y, r.w, 1.f }, color);
+      if (r.h > 1.f) fillRect({ r.x, r.y + r.h - 1.f, r.w, 1.f }, color);
+      if (r.h > 2.f) {
+        fillRect({ r.x, r.y + 1.f, 1.f, r.h - 2.f }, color);
+        if (r.w > 1.f) fillRect({ r.x + r.w - 1.f, r.y + 1.f, 1.f, r.h - 2.f }, color);
+      }
+    }
+
+    bool empty() const { return indices.empty(); }
+
+    void flush(SDL_Renderer* renderer) {
+      if (indices.empty()) return;
+      SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+      Render::Geometry(renderer, nullptr, vertices.data(), static_cast<int>(vertices.size()),
+                       indices.data(), static_cast<int>(indices.size()));
+      vertices.clear();
+      indices.clear();
+    }
+
+  private:
+    Memory::FrameVector<SDL_Vertex> vertices;
+    Memory::FrameVector<int> indices;
+};
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstdlib>
+
+/*
+ * Editorens tegneværktøjer. Alle samler deres celler i én Scene::ChangeSet, så en
+ * operation giver én opdatering af lookup og ét autotile pass uanset antal celler.
+ *
+ *   Brush - tegner mens knappen holdes, med en linje mellem cellerne fra frame til frame
+ *   Rect  - træk en rect og slip for at fylde den
+ *   Flood - fylder det sammenhængende område uden den valgte type
+ */
+enum class PaintTool { Brush, Rect, Flood };
+
+namespace PaintTools {
+
+/* Bresenham fra (x0, y0) til (x1, y1), begge endepunkter med */
+template<typename Fn>
+void ForEachLineCell(int x0, int y0, int x1, int y1, Fn&& fn) {
+  const int dx = std::abs(x1 - x0);
+  const int dy = -std::abs(y1 - y0);
+  const int sx = x0 < x1 ? 1 : -1;
+  const int sy = y0 < y1 ? 1 : -1;
+  int err = dx + dy;
+
+  while (true) {
+    fn(x0, y0);
+    if (x0 == x1 && y0 == y1) break;
+    const int e2 = 2 * err;
+    if (e2 >= dy) { err += dy; x0 += sx; }
+    if (e2 <= dx) { err += dx; y0 += sy; }
+  }
+}
+
+}
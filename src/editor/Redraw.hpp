@@ -0,0 +1,55 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <string_view>
+
+/*
+ * Grunde til at main loopet skal tegne igen. Er der ingen, venter loopet på input
+ * (SDL_WaitEventTimeout) i stedet for at tegne samme billede med skærmens refresh rate.
+ * "now" tegnes med det samme, "timed" vækker loopet efter waitMs (skyer, popup timer).
+ */
+namespace Redraw {
+
+enum Reason : std::uint32_t {
+  INPUT   = 1u << 0,  // event i denne frame - klik placerer tiles under draw, så én frame mere
+  HELD    = 1u << 1,  // tast eller museknap holdt nede (scroll, tegning, markering)
+  CAMERA  = 1u << 2,  // kameraet er stadig mellem to fixed steps
+  CLOUDS  = 1u << 3,
+  POPUP   = 1u << 4,
+  LOAD    = 1u << 5,  // scene eller thumbnail er indlæst
+  OVERLAY = 1u << 6,  // F3 overlayet viser live tal
+};
+
+inline constexpr const char* NAMES[] = { "input", "held", "camera", "clouds", "popup", "load", "overlay" };
+
+struct Request {
+  std::uint32_t now = 0;
+  std::uint32_t timed = 0;
+  int waitMs = -1; // -1 = vent til der kommer input
+
+  void wakeIn(Reason reason, int ms) {
+    if (ms < 0) return;
+    timed |= reason;
+    waitMs = waitMs < 0 ? ms : std::min(waitMs, ms);
+  }
+};
+
+/* "input held" - skrevet i en buffer, så overlayet ikke allokerer */
+inline std::string_view Describe(std::uint32_t reasons, char* out, std::size_t size) {
+  std::size_t len = 0;
+  for (std::size_t i = 0; i < std::size(NAMES); ++i) {
+    if (!(reasons & (1u << i))) continue;
+    auto r = std::format_to_n(out + len, size - len, "{}{}", len ? " " : "", NAMES[i]);
+    len += std::min<std::size_t>(r.size, size - len);
+  }
+  if (len == 0) {
+    auto r = std::format_to_n(out, size, "-");
+    len = std::min<std::size_t>(r.size, size);
+  }
+  return { out, len };
+}
+
+}
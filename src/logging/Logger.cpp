@@ -1,7 +1,290 @@
 #include "Logger.hpp"
 
+#include <array>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+
+#include "Trace.hpp"
+
 namespace Log {
-  void Init() {
-    SDL_SetLogPriorities(SDL_LOG_PRIORITY_DEBUG);
+
+namespace detail {
+  std::atomic<Level> g_categoryLevels[static_cast<int>(Category::Count)] {};
+}
+
+namespace {
+  constexpr const char* CATEGORY_NAMES[] = { "general", "render", "scene", "resources", "audio", "ui", "input" };
+  static_assert(std::size(CATEGORY_NAMES) == static_cast<std::size_t>(Category::Count));
+
+  // MPSC ring (Vyukov): producenter reserverer en plads med CAS på enqueue, log tråden
+  // er eneste forbruger. Er ringen fuld droppes beskeden hellere end at spillet venter.
+  constexpr std::size_t RING_SIZE = 1024; // potens af 2
+  constexpr std::size_t RING_MASK = RING_SIZE - 1;
+
+  struct Slot {
+    std::atomic<std::size_t> sequence;
+    Level level;
+    Category category;
+    std::uint16_t length;
+    char text[MAX_MESSAGE];
+  };
+
+  struct Ring {
+    Slot slots[RING_SIZE];
+    alignas(64) std::atomic<std::size_t> enqueue { 0 };
+    alignas(64) std::size_t dequeue = 0;                 // kun forbrugeren
+    std::atomic<std::size_t> written { 0 };              // til Flush
+
+    Ring() {
+      for (std::size_t i = 0; i < RING_SIZE; ++i) slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  };
+
+  Ring s_ring;
+  std::atomic<std::uint32_t> s_wake { 0 };
+  std::atomic<bool> s_running { false };
+  std::atomic<std::uint64_t> s_dropped { 0 };
+  std::thread s_thread;
+
+  // Rate limiting: samme besked højst RATE_LIMIT gange per vindue, resten tælles
+  constexpr std::uint64_t RATE_WINDOW_MS = 1000;
+  constexpr std::uint32_t RATE_LIMIT = 5;
+
+  struct RateEntry {
+    std::uint64_t hash = 0;
+    std::uint64_t windowStart = 0;
+    std::uint32_t count = 0;
+    std::uint32_t suppressed = 0;
+    Level level = Level::Info;
+    Category category = Category::General;
+  };
+  std::array<RateEntry, 64> s_rate {}; // kun forbrugeren (eller direkte skrivning før Init)
+  std::uint64_t s_reportedDropped = 0;
+
+  SDL_LogPriority ToPriority(Level level) {
+    switch (level) {
+      case Level::Debug:    return SDL_LOG_PRIORITY_DEBUG;
+      case Level::Info:     return SDL_LOG_PRIORITY_INFO;
+      case Level::Warn:     return SDL_LOG_PRIORITY_WARN;
+      case Level::Error:    return SDL_LOG_PRIORITY_ERROR;
+      case Level::Critical: return SDL_LOG_PRIORITY_CRITICAL;
+    }
+    return SDL_LOG_PRIORITY_INFO;
   }
+
+  void Output(Level level, Category category, std::string_view text) {
+    const int n = static_cast<int>(text.size());
+    if (category == Category::General)
+      SDL_LogMessage(SDL_LOG_CATEGORY_APPLICATION, ToPriority(level), "%.*s", n, text.data());
+    else
+      SDL_LogMessage(SDL_LOG_CATEGORY_APPLICATION, ToPriority(level), "[%s] %.*s", CategoryName(category), n, text.data());
+  }
+
+  std::uint64_t Hash(Level level, Category category, std::string_view text) {
+    std::uint64_t h = 1469598103934665603ull; // FNV-1a
+    auto mix = [&](unsigned char c) { h = (h ^ c) * 1099511628211ull; };
+    mix(static_cast<unsigned char>(level));
+    mix(static_cast<unsigned char>(category));
+    for (char c : text) mix(static_cast<unsigned char>(c));
+    return h;
+  }
+
+  void ReportSuppressed(const RateEntry& e) {
+    if (e.suppressed == 0) return;
+    char line[96];
+    auto r = std::format_to_n(line, sizeof(line), "(forrige besked gentaget {} gange mere)", e.suppressed);
+    Output(e.level, e.category, std::string_view(line, std::min<std::size_t>(r.size, sizeof(line))));
+  }
+
+  void Write(Level level, Category category, std::string_view text) {
+    const std::uint64_t dropped = s_dropped.load(std::memory_order_relaxed);
+    if (dropped != s_reportedDropped) {
+      char line[96];
+      auto r = std::format_to_n(line, sizeof(line), "Log køen var fuld - {} beskeder droppet", dropped - s_reportedDropped);
+      Output(Level::Warn, Category::General, std::string_view(line, std::min<std::size_t>(r.size, sizeof(line))));
+      s_reportedDropped = dropped;
+    }
+
+    if (level == Level::Critical) {
+      Output(level, category, text);
+      return;
+    }
+
+    const std::uint64_t hash = Hash(level, category, text);
+    const std::uint64_t now = SDL_GetTicks();
+    RateEntry& e = s_rate[hash & (s_rate.size() - 1)];
+
+    if (e.hash != hash) {
+      ReportSuppressed(e);
+      e = { hash, now, 0, 0, level, category };
+    } else if (now - e.windowStart >= RATE_WINDOW_MS) {
+      ReportSuppressed(e);
+      e.windowStart = now;
+      e.count = 0;
+      e.suppressed = 0;
+    }
+
+    if (++e.count > RATE_LIMIT) {
+      ++e.suppressed;
+      return;
+    }
+    Output(level, category, text);
+  }
+
+  bool TryPush(Level level, Category category, std::string_view text) {
+    std::size_t pos = s_ring.enqueue.load(std::memory_order_relaxed);
+    Slot* slot = nullptr;
+    for (;;) {
+      slot = &s_ring.slots[pos & RING_MASK];
+      const std::size_t seq = slot->sequence.load(std::memory_order_acquire);
+      const auto diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos);
+      if (diff == 0) {
+        if (s_ring.enqueue.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+      } else if (diff < 0) {
+        return false; // fuld
+      } else {
+        pos = s_ring.enqueue.load(std::memory_order_relaxed);
+      }
+    }
+
+    slot->level = level;
+    slot->category = category;
+    slot->length = static_cast<std::uint16_t>(text.size());
+    std::memcpy(slot->text, text.data(), text.size());
+    slot->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+  }
+
+  bool TryPopAndWrite() {
+    Slot& slot = s_ring.slots[s_ring.dequeue & RING_MASK];
+    if (slot.sequence.load(std::memory_order_acquire) != s_ring.dequeue + 1) return false;
+
+    Write(slot.level, slot.category, std::string_view(slot.text, slot.length));
+    slot.sequence.store(s_ring.dequeue + RING_SIZE, std::memory_order_release);
+    ++s_ring.dequeue;
+    s_ring.written.fetch_add(1, std::memory_order_release);
+    return true;
+  }
+
+  void Wake() {
+    s_wake.fetch_add(1, std::memory_order_release);
+    s_wake.notify_one();
+  }
+
+  void WorkerLoop() {
+    Trace::SetThreadName("log");
+    for (;;) {
+      const std::uint32_t wake = s_wake.load(std::memory_order_acquire);
+      bool any = false;
+      while (TryPopAndWrite()) any = true;
+
+      if (!s_running.load(std::memory_order_acquire)) break;
+      if (!any) s_wake.wait(wake, std::memory_order_acquire);
+    }
+    while (TryPopAndWrite()) {}
+  }
+
+  // Stopper tråden selv hvis Shutdown aldrig blev kaldt (fx tidlig return fra main)
+  struct ShutdownOnExit {
+    ~ShutdownOnExit() { Shutdown(); }
+  } s_shutdownOnExit;
+}
+
+void Init() {
+  SDL_SetLogPriorities(SDL_LOG_PRIORITY_DEBUG);
+  if (const char* filters = std::getenv("PIRATE_LOG")) SetFiltersFromString(filters);
+
+  if (s_running.exchange(true)) return;
+  s_thread = std::thread(WorkerLoop);
+}
+
+void Shutdown() {
+  if (!s_running.exchange(false)) return;
+  Wake();
+  if (s_thread.joinable()) s_thread.join();
+
+  // Beskeder der nåede i køen mens tråden stoppede
+  while (TryPopAndWrite()) {}
+  for (auto& e : s_rate) {
+    ReportSuppressed(e);
+    e = {};
+  }
+}
+
+void Flush() {
+  if (!s_running.load(std::memory_order_acquire)) return;
+  const std::size_t target = s_ring.enqueue.load(std::memory_order_acquire);
+  while (s_ring.written.load(std::memory_order_acquire) < target && s_running.load(std::memory_order_acquire)) {
+    Wake();
+    std::this_thread::yield();
+  }
+}
+
+void SetCategoryLevel(Category category, Level level) {
+  detail::g_categoryLevels[static_cast<int>(category)].store(level, std::memory_order_relaxed);
+}
+
+void SetFiltersFromString(std::string_view filters) {
+  // "scene=warn,render=debug" - "*" rammer alle kategorier
+  constexpr const char* LEVEL_NAMES[] = { "debug", "info", "warn", "error", "critical" };
+
+  while (!filters.empty()) {
+    const std::size_t comma = filters.find(',');
+    std::string_view item = filters.substr(0, comma);
+    filters = comma == std::string_view::npos ? std::string_view{} : filters.substr(comma + 1);
+
+    const std::size_t eq = item.find('=');
+    if (eq == std::string_view::npos) continue;
+    const std::string_view name = item.substr(0, eq);
+    const std::string_view levelName = item.substr(eq + 1);
+
+    int level = -1;
+    for (int i = 0; i < static_cast<int>(std::size(LEVEL_NAMES)); ++i)
+      if (levelName == LEVEL_NAMES[i]) level = i;
+    if (level < 0) {
+      Warn("Ukendt log niveau '{}' i PIRATE_LOG", levelName);
+      continue;
+    }
+
+    bool found = false;
+    for (int c = 0; c < static_cast<int>(Category::Count); ++c) {
+      if (name == "*" || name == CATEGORY_NAMES[c]) {
+        SetCategoryLevel(static_cast<Category>(c), static_cast<Level>(level));
+        found = true;
+      }
+    }
+    if (!found) Warn("Ukendt log kategori '{}' i PIRATE_LOG", name);
+  }
+}
+
+const char* CategoryName(Category category) {
+  const auto i = static_cast<std::size_t>(category);
+  return i < std::size(CATEGORY_NAMES) ? CATEGORY_NAMES[i] : "?";
+}
+
+std::uint64_t DroppedMessages() {
+  return s_dropped.load(std::memory_order_relaxed);
+}
+
+void detail::Submit(Level level, Category category, std::string_view text) {
+  if (!s_running.load(std::memory_order_acquire)) {
+    Write(level, category, text);
+    return;
+  }
+
+  if (level == Level::Critical) {
+    // Programmet er måske ved at dø - alt før skal ud først, og beskeden selv med det samme
+    Flush();
+    Output(level, category, text);
+    return;
+  }
+
+  if (!TryPush(level, category, text)) {
+    s_dropped.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+  Wake();
+}
+
 }
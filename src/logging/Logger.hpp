@@ -1,8 +1,29 @@
 #pragma once
-#include <string>
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
 #include <format>
+#include <string_view>
 #include "SDL3/SDL.h"
 
+/*
+ * Formatstrengen tjekkes ved compile time (std::format_string), og niveauer under
+ * PIRATE_LOG_MIN_LEVEL (0=Debug .. 4=Critical) bygges slet ikke ind. Resten filtreres per
+ * kategori ved runtime (SetCategoryLevel eller PIRATE_LOG="scene=warn,render=debug").
+ *
+ * Beskeden formateres ind i en buffer på stakken og lægges i en lock-free kø - skrivningen
+ * til SDL_Log sker på log tråden (efter Init). Ens beskeder der gentages hurtigt droppes
+ * og tælles. Critical tømmer køen og skrives med det samme.
+ */
+#ifndef PIRATE_LOG_MIN_LEVEL
+  #if defined(NDEBUG)
+    #define PIRATE_LOG_MIN_LEVEL 1
+  #else
+    #define PIRATE_LOG_MIN_LEVEL 0
+  #endif
+#endif
+
 namespace Log {
   enum class Level {
     Debug,
@@ -12,48 +33,108 @@ namespace Log {
     Critical
   };
 
+  enum class Category {
+    General,
+    Render,
+    Scene,
+    Resources,
+    Audio,
+    UI,
+    Input,
+    Count
+  };
+
+  inline constexpr Level MIN_LEVEL = static_cast<Level>(PIRATE_LOG_MIN_LEVEL);
+  inline constexpr std::size_t MAX_MESSAGE = 480; // længere beskeder klippes
+
+  /* Starter log tråden - beskeder før Init (og efter Shutdown) skrives direkte */
   void Init();
+  void Shutdown();
+
+  /* Venter til alt der er lagt i køen er skrevet */
+  void Flush();
+
+  void SetCategoryLevel(Category category, Level level);
+  void SetFiltersFromString(std::string_view filters);
+  const char* CategoryName(Category category);
+  std::uint64_t DroppedMessages();
+
+  namespace detail {
+    extern std::atomic<Level> g_categoryLevels[static_cast<int>(Category::Count)];
+
+    void Submit(Level level, Category category, std::string_view text);
+  }
+
+  inline bool Enabled(Level level, Category category) {
+    return level >= detail::g_categoryLevels[static_cast<int>(category)].load(std::memory_order_relaxed);
+  }
 
   template<typename... Args>
-  void Message(Level level, std::string_view fmt, Args&&... args) {
-      std::string msg = std::vformat(fmt, std::make_format_args(args...));
-      if (level == Level::Critical) {
-          msg += " (";
-          msg += SDL_GetError();
-          msg += ")";
-      }
+  void Message(Level level, Category category, std::format_string<Args...> fmt, Args&&... args) {
+      if (level < MIN_LEVEL || !Enabled(level, category)) return;
 
-      switch(level) {
-          case Level::Debug:    SDL_LogDebug(SDL_LOG_CATEGORY_APPLICATION, "%s", msg.c_str()); break;
-          case Level::Info:     SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "%s", msg.c_str()); break;
-          case Level::Warn:     SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "%s", msg.c_str()); break;
-          case Level::Error:    SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s", msg.c_str()); break;
-          case Level::Critical: SDL_LogCritical(SDL_LOG_CATEGORY_APPLICATION, "%s", msg.c_str()); break;
+      char buffer[MAX_MESSAGE];
+      auto result = std::format_to_n(buffer, MAX_MESSAGE, fmt, std::forward<Args>(args)...);
+      std::size_t length = std::min<std::size_t>(result.size, MAX_MESSAGE);
+      if (level == Level::Critical && length < MAX_MESSAGE) {
+          result = std::format_to_n(buffer + length, MAX_MESSAGE - length, " ({})", SDL_GetError());
+          length += std::min<std::size_t>(result.size, MAX_MESSAGE - length);
       }
+      detail::Submit(level, category, std::string_view(buffer, length));
+  }
+
+  template<typename... Args>
+  void Message(Level level, std::format_string<Args...> fmt, Args&&... args) {
+    Message(level, Category::General, fmt, std::forward<Args>(args)...);
+  }
+
+  template<typename... Args>
+  void Error(std::format_string<Args...> fmt, Args&&... args) {
+    if constexpr (Level::Error >= MIN_LEVEL) Message(Level::Error, Category::General, fmt, std::forward<Args>(args)...);
+  }
+
+  template<typename... Args>
+  void Error(Category category, std::format_string<Args...> fmt, Args&&... args) {
+    if constexpr (Level::Error >= MIN_LEVEL) Message(Level::Error, category, fmt, std::forward<Args>(args)...);
+  }
+
+  template<typename... Args>
+  void Debug(std::format_string<Args...> fmt, Args&&... args) {
+    if constexpr (Level::Debug >= MIN_LEVEL) Message(Level::Debug, Category::General, fmt, std::forward<Args>(args)...);
+  }
+
+  template<typename... Args>
+  void Debug(Category category, std::format_string<Args...> fmt, Args&&... args) {
+    if constexpr (Level::Debug >= MIN_LEVEL) Message(Level::Debug, category, fmt, std::forward<Args>(args)...);
+  }
+
+  template<typename... Args>
+  void Info(std::format_string<Args...> fmt, Args&&... args) {
+    if constexpr (Level::Info >= MIN_LEVEL) Message(Level::Info, Category::General, fmt, std::forward<Args>(args)...);
   }
 
   template<typename... Args>
-  void Error(std::string_view fmt, Args&&... args) {
-    Message(Level::Error, fmt, std::forward<Args>(args)...);
+  void Info(Category category, std::format_string<Args...> fmt, Args&&... args) {
+    if constexpr (Level::Info >= MIN_LEVEL) Message(Level::Info, category, fmt, std::forward<Args>(args)...);
   }
 
   template<typename... Args>
-  void Debug(std::string_view fmt, Args&&... args) {
-    Message(Level::Debug, fmt, std::forward<Args>(args)...);
+  void Warn(std::format_string<Args...> fmt, Args&&... args) {
+    if constexpr (Level::Warn >= MIN_LEVEL) Message(Level::Warn, Category::General, fmt, std::forward<Args>(args)...);
   }
 
   template<typename... Args>
-  void Info(std::string_view fmt, Args&&... args) {
-    Message(Level::Info, fmt, std::forward<Args>(args)...);
+  void Warn(Category category, std::format_string<Args...> fmt, Args&&... args) {
+    if constexpr (Level::Warn >= MIN_LEVEL) Message(Level::Warn, category, fmt, std::forward<Args>(args)...);
   }
 
   template<typename... Args>
-  void Warn(std::string_view fmt, Args&&... args) {
-    Message(Level::Warn, fmt, std::forward<Args>(args)...);
+  void Critical(std::format_string<Args...> fmt, Args&&... args) {
+    Message(Level::Critical, Category::General, fmt, std::forward<Args>(args)...);
   }
 
   template<typename... Args>
-  void Critical(std::string_view fmt, Args&&... args) {
-    Message(Level::Critical, fmt, std::forward<Args>(args)...);
+  void Critical(Category category, std::format_string<Args...> fmt, Args&&... args) {
+    Message(Level::Critical, category, fmt, std::forward<Args>(args)...);
   }
 }
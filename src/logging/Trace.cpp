@@ -0,0 +1,287 @@
+#include "Trace.hpp"
+#include "Logger.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <ctime>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Log {
+namespace Trace {
+
+namespace detail {
+  std::atomic<bool> g_recording { false };
+}
+
+namespace {
+  constexpr size_t DETAIL_SIZE       = 56;
+  constexpr size_t RING_SIZE         = 8192; // events per tråd, potens af 2
+  constexpr size_t RING_MASK         = RING_SIZE - 1;
+  constexpr int    WRITE_INTERVAL_MS = 50;   // hvor tit skrivetråden tømmer ringene
+
+  struct Event {
+    const char* name;
+    const char* category;
+    Uint64 start;
+    Uint64 end;
+    char phase;           // 'X' = complete, 'i' = instant
+    std::uint8_t detailLength;
+    char detail[DETAIL_SIZE];
+  };
+
+  // SPSC ring: kun ejertråden skriver head, kun skrivetråden skriver tail. Er ringen fuld
+  // droppes eventet hellere end at tråden venter på disken
+  struct ThreadBuffer {
+    std::unique_ptr<Event[]> events = std::make_unique<Event[]>(RING_SIZE);
+    alignas(64) std::atomic<size_t> head { 0 };
+    alignas(64) std::atomic<size_t> tail { 0 };
+    std::atomic<size_t> dropped { 0 };
+    std::uint32_t tid = 0;
+    std::string name;     // under s_registryLock
+  };
+
+  // Bufferne lever resten af programmet, så tråde der stopper ikke efterlader dangling pointers
+  std::mutex s_registryLock;
+  std::vector<std::unique_ptr<ThreadBuffer>> s_buffers;
+  std::uint32_t s_nextTid = 1;
+
+  // Kun skrivetråden mens der optages (og Start/Stop før/efter den kører)
+  std::FILE* s_file = nullptr;
+  std::string s_path;
+  bool s_firstEvent = true;
+  Uint64 s_origin = 0;
+  double s_ticksToUs = 1.0;
+  size_t s_eventsWritten = 0;
+  size_t s_eventsDropped = 0;
+
+  std::thread s_writer;
+  std::mutex s_writerLock;
+  std::condition_variable s_writerWake;
+  bool s_stopWriter = false;
+
+  Uint64 s_lastFrame = 0; // kun main tråden
+
+  // Skrivetråden skal joines og filen lukkes, selv hvis Stop aldrig blev kaldt
+  struct StopOnExit {
+    ~StopOnExit() { Stop(); }
+  } s_stopOnExit;
+
+  thread_local ThreadBuffer* t_buffer = nullptr;
+
+  ThreadBuffer& threadBuffer() {
+    if (!t_buffer) {
+      std::lock_guard<std::mutex> guard(s_registryLock);
+      auto buffer = std::make_unique<ThreadBuffer>();
+      buffer->tid = s_nextTid++;
+      t_buffer = buffer.get();
+      s_buffers.push_back(std::move(buffer));
+    }
+    return *t_buffer;
+  }
+
+  void push(const char* name, const char* category, Uint64 start, Uint64 end, char phase, std::string_view detail) {
+    ThreadBuffer& buffer = threadBuffer();
+    const size_t head = buffer.head.load(std::memory_order_relaxed);
+    if (head - buffer.tail.load(std::memory_order_acquire) >= RING_SIZE) {
+      buffer.dropped.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+
+    Event& e = buffer.events[head & RING_MASK];
+    e.name = name;
+    e.category = category;
+    e.start = start;
+    e.end = end;
+    e.phase = phase;
+    e.detailLength = static_cast<std::uint8_t>(std::min(detail.size(), DETAIL_SIZE));
+    std::copy_n(detail.data(), e.detailLength, e.detail);
+    buffer.head.store(head + 1, std::memory_order_release);
+  }
+
+  void writeEscaped(std::FILE* f, std::string_view s) {
+    for (char c : s) {
+      switch (c) {
+        case '"':  std::fputs("\\\"", f); break;
+        case '\\': std::fputs("\\\\", f); break;
+        case '\n': std::fputs("\\n", f);  break;
+        default:
+          if (static_cast<unsigned char>(c) < 0x20) std::fprintf(f, "\\u%04x", c);
+          else std::fputc(c, f);
+      }
+    }
+  }
+
+  void writeEvent(std::FILE* f, const Event& e, std::uint32_t tid) {
+    if (!s_firstEvent) std::fputs(",\n", f);
+    s_firstEvent = false;
+
+    const double ts = (e.start - s_origin) * s_ticksToUs;
+    std::fputs("{\"name\":\"", f);
+    writeEscaped(f, e.name);
+    std::fputs("\",\"cat\":\"", f);
+    writeEscaped(f, e.category);
+    std::fprintf(f, "\",\"ph\":\"%c\",\"ts\":%.3f,\"pid\":1,\"tid\":%u", e.phase, ts, tid);
+
+    if (e.phase == 'X') std::fprintf(f, ",\"dur\":%.3f", (e.end - e.start) * s_ticksToUs);
+    else                std::fputs(",\"s\":\"t\"", f);
+
+    if (e.detailLength > 0) {
+      std::fputs(",\"args\":{\"detail\":\"", f);
+      writeEscaped(f, std::string_view(e.detail, e.detailLength));
+      std::fputs("\"}", f);
+    }
+    std::fputc('}', f);
+  }
+
+  /* Skrivetråden: tømmer alle trådringe ned i filen */
+  void drain(std::vector<ThreadBuffer*>& buffers) {
+    // Registret holdes kun mens listen kopieres, så en ny tråd aldrig venter på disken
+    {
+      std::lock_guard<std::mutex> guard(s_registryLock);
+      buffers.clear();
+      for (auto& buffer : s_buffers) buffers.push_back(buffer.get());
+    }
+
+    for (ThreadBuffer* buffer : buffers) {
+      const size_t head = buffer->head.load(std::memory_order_acquire);
+      size_t tail = buffer->tail.load(std::memory_order_relaxed);
+      for (; tail != head; ++tail) {
+        const Event& e = buffer->events[tail & RING_MASK];
+        if (e.start < s_origin) continue; // fra før optagelsen startede
+        writeEvent(s_file, e, buffer->tid);
+        ++s_eventsWritten;
+      }
+      buffer->tail.store(tail, std::memory_order_release);
+      s_eventsDropped += buffer->dropped.exchange(0, std::memory_order_relaxed);
+    }
+  }
+
+  void writeThreadNames() {
+    std::lock_guard<std::mutex> guard(s_registryLock);
+    for (auto& buffer : s_buffers) {
+      if (buffer->name.empty()) continue;
+      if (!s_firstEvent) std::fputs(",\n", s_file);
+      s_firstEvent = false;
+      std::fprintf(s_file, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"", buffer->tid);
+      writeEscaped(s_file, buffer->name);
+      std::fputs("\"}}", s_file);
+    }
+  }
+
+  void WriterLoop() {
+    SetThreadName("trace");
+    std::vector<ThreadBuffer*> buffers;
+    for (;;) {
+      bool stop;
+      {
+        std::unique_lock<std::mutex> lock(s_writerLock);
+        s_writerWake.wait_for(lock, std::chrono::milliseconds(WRITE_INTERVAL_MS), [] { return s_stopWriter; });
+        stop = s_stopWriter;
+      }
+      drain(buffers);
+      if (stop) break;
+    }
+
+    writeThreadNames();
+    std::fputs("\n]}\n", s_file);
+    std::fclose(s_file);
+    s_file = nullptr;
+  }
+}
+
+bool Start(const std::string& path) {
+  if (IsRecording()) return false;
+
+  s_file = std::fopen(path.c_str(), "wb");
+  if (!s_file) {
+    Log::Error("Kunne ikke åbne trace fil: {}", path);
+    return false;
+  }
+
+  s_path = path;
+  s_firstEvent = true;
+  s_eventsWritten = 0;
+  s_eventsDropped = 0;
+  s_ticksToUs = 1'000'000.0 / static_cast<double>(SDL_GetPerformanceFrequency());
+  s_origin = SDL_GetPerformanceCounter();
+  s_lastFrame = s_origin;
+  std::fputs("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n", s_file);
+
+  s_stopWriter = false;
+  s_writer = std::thread(WriterLoop);
+
+  detail::g_recording.store(true, std::memory_order_release);
+  Log::Info("Trace optagelse startet: {}", path);
+  return true;
+}
+
+void Stop() {
+  if (!detail::g_recording.exchange(false, std::memory_order_acq_rel)) return;
+
+  {
+    std::lock_guard<std::mutex> guard(s_writerLock);
+    s_stopWriter = true;
+  }
+  s_writerWake.notify_one();
+  s_writer.join();
+
+  if (s_eventsDropped > 0) Log::Warn("Trace: {} events droppet fordi en tråds ring var fuld", s_eventsDropped);
+  Log::Info("Trace gemt til {} ({} events)", s_path, s_eventsWritten);
+}
+
+void Toggle() {
+  if (IsRecording()) {
+    Stop();
+    return;
+  }
+
+  char name[64];
+  std::time_t now = std::time(nullptr);
+  std::strftime(name, sizeof(name), "trace_%Y%m%d_%H%M%S.json", std::localtime(&now));
+  Start(name);
+}
+
+bool IsRecording() {
+  return detail::g_recording.load(std::memory_order_relaxed);
+}
+
+void InitFromEnvironment() {
+  const char* env = SDL_getenv("PIRATE_TRACE");
+  if (!env || !*env || std::string_view(env) == "0") return;
+
+  if (std::string_view(env) == "1") Toggle();
+  else Start(env);
+}
+
+void FrameBoundary() {
+  if (!IsRecording()) return;
+
+  const Uint64 now = SDL_GetPerformanceCounter();
+  push("Frame", "frame", s_lastFrame, now, 'X', {});
+  s_lastFrame = now;
+}
+
+void SetThreadName(const char* name) {
+  ThreadBuffer& buffer = threadBuffer();
+  std::lock_guard<std::mutex> guard(s_registryLock);
+  buffer.name = name;
+}
+
+void Complete(const char* name, const char* category, Uint64 start, Uint64 end, std::string_view detail) {
+  if (!IsRecording()) return;
+  push(name, category, start, end, 'X', detail);
+}
+
+void Instant(const char* name, const char* category, std::string_view detail) {
+  if (!IsRecording()) return;
+  const Uint64 now = SDL_GetPerformanceCounter();
+  push(name, category, now, now, 'i', detail);
+}
+
+}
+}
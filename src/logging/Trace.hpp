@@ -0,0 +1,70 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include "SDL3/SDL.h"
+
+/*
+ * Trace optagelse i Chrome trace-event / Perfetto JSON format (åbnes i
+ * chrome://tracing eller ui.perfetto.dev). Hver tråd skriver til sin egen ring uden
+ * låse, så et TRACE_SCOPE koster et atomic load når der ikke optages. En skrivetråd
+ * tømmer ringene og laver JSON og fil I/O, så ingen frame venter på disken.
+ *
+ * Slås til med miljøvariablen PIRATE_TRACE=<fil.json> eller F9 i editoren.
+ */
+namespace Log {
+namespace Trace {
+
+  bool Start(const std::string& path);
+  void Stop();
+  void Toggle();
+  bool IsRecording();
+
+  /* Læser PIRATE_TRACE - "1" giver et automatisk filnavn */
+  void InitFromEnvironment();
+
+  /* Kaldes én gang per frame - markerer frame grænsen */
+  void FrameBoundary();
+
+  /* Navn på den kaldende tråd i tracen */
+  void SetThreadName(const char* name);
+
+  /* start/end er SDL_GetPerformanceCounter værdier. name/category skal leve hele programmet */
+  void Complete(const char* name, const char* category, Uint64 start, Uint64 end, std::string_view detail = {});
+  void Instant(const char* name, const char* category, std::string_view detail = {});
+
+  namespace detail {
+    extern std::atomic<bool> g_recording;
+  }
+
+  class Scope {
+    public:
+      Scope(const char* name, const char* category, std::string_view detail = {})
+        : name(name)
+        , category(category)
+        , detail(detail)
+        , start(detail::g_recording.load(std::memory_order_relaxed) ? SDL_GetPerformanceCounter() : 0) {}
+
+      ~Scope() {
+        if (start != 0) Complete(name, category, start, SDL_GetPerformanceCounter(), detail);
+      }
+
+      Scope(const Scope&) = delete;
+      Scope& operator=(const Scope&) = delete;
+    private:
+      const char* name;
+      const char* category;
+      std::string_view detail;
+      Uint64 start;
+  };
+
+}
+}
+
+#define PIRATE_TRACE_CONCAT_(a, b) a##b
+#define PIRATE_TRACE_CONCAT(a, b) PIRATE_TRACE_CONCAT_(a, b)
+
+#define TRACE_SCOPE(name, category) ::Log::Trace::Scope PIRATE_TRACE_CONCAT(traceScope_, __LINE__)(name, category)
+#define TRACE_SCOPE_DETAIL(name, category, detail) ::Log::Trace::Scope PIRATE_TRACE_CONCAT(traceScope_, __LINE__)(name, category, detail)
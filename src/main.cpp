@@ -1,66 +1,189 @@
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+#include <vector>
+
 #include "SDL3/SDL_events.h"
 #include "logging/Logger.hpp"
+#include "logging/Trace.hpp"
 #include "sdl/SDL_Handler.hpp"
+#include "sdl/InputTrace.hpp"
 #include "editor/Editor.hpp"
 #include "editor/FPS_Counter.hpp"
+#include "profiling/Profiler.hpp"
+#include "memory/FrameArena.hpp"
+#include "timing/FrameScheduler.hpp"
+#include "jobs/JobSystem.hpp"
+
+namespace {
+  struct LaunchOptions {
+    std::string record;
+    std::string replay;
+    std::string report = "-";
+    int fpsCap = -1; // -1 = skærmens refresh rate når vsync mangler
+    int undoMb = -1; // -1 = Scene::History::DEFAULT_MEMORY_CAP
+    bool onDemand = true;
+  };
 
-int main(void) {
+  bool ParseArgs(int argc, char** argv, LaunchOptions& opt) {
+    for (int i = 1; i < argc; ++i) {
+      const std::string arg = argv[i];
+      if (arg == "--no-idle") { opt.onDemand = false; continue; }
+      if (i + 1 >= argc) return false;
+      if      (arg == "--record") opt.record = argv[++i];
+      else if (arg == "--replay") opt.replay = argv[++i];
+      else if (arg == "--report") opt.report = argv[++i];
+      else if (arg == "--fps-cap") opt.fpsCap = std::atoi(argv[++i]);
+      else if (arg == "--undo-mb") opt.undoMb = std::atoi(argv[++i]);
+      else return false;
+    }
+    return opt.record.empty() || opt.replay.empty();
+  }
+}
+
+int main(int argc, char** argv) {
   Log::Init();
+  Profiling::Profiler::init();
+  Log::Trace::SetThreadName("main");
+  Log::Trace::InitFromEnvironment();
+
+  LaunchOptions opt;
+  if (!ParseArgs(argc, argv, opt)) {
+    std::fputs("Brug: PirateEditor [--fps-cap <n>] [--undo-mb <n>] [--no-idle] [--record <fil>] | [--replay <fil> [--report <fil.json>]]\n", stderr);
+    return 2;
+  }
+
+  const bool replaying = !opt.replay.empty();
+  if (replaying && !Input::Trace::openReplay(opt.replay)) return 2;
+
+  Jobs::Init();
 
   const int WINDOW_WIDTH = 1920;
   const int WINDOW_HEIGHT = 1080;
   SDL_Handler sdl({
     .title = "PirateEditor",
-    .width = WINDOW_WIDTH,
-    .height = WINDOW_HEIGHT
+    .width = replaying ? static_cast<int>(Input::Trace::info().windowWidth) : WINDOW_WIDTH,
+    .height = replaying ? static_cast<int>(Input::Trace::info().windowHeight) : WINDOW_HEIGHT,
+    .headless = replaying
   });
 
+  // Skyerne bruger rand() allerede i Editor's constructor, så frøet skal sættes før
+  if (!opt.record.empty()) {
+    const auto seed = static_cast<std::uint32_t>(SDL_GetPerformanceCounter());
+    if (Input::Trace::startRecording(opt.record, sdl.getState(), seed)) std::srand(seed);
+  } else if (replaying) {
+    std::srand(Input::Trace::info().seed);
+  }
+
+  // Frame pacing: vsync hvis rendereren har det, ellers cap på skærmens refresh rate (eller --fps-cap).
+  // Afspilning kører så hurtigt som muligt
+  if (replaying) {
+    Timing::FrameScheduler::configure(false, 0.0, 0);
+  } else {
+    int vsync = 0;
+    const bool hasVsync = SDL_GetRenderVSync(sdl.getRenderer(), &vsync) && vsync != 0;
+    const SDL_DisplayMode* mode = SDL_GetCurrentDisplayMode(SDL_GetDisplayForWindow(sdl.getState().window));
+    const double refreshRate = (mode && mode->refresh_rate > 0.0f) ? mode->refresh_rate : 60.0;
+    const int fpsCap = opt.fpsCap >= 0 ? opt.fpsCap : static_cast<int>(refreshRate + 0.5);
+    Timing::FrameScheduler::configure(hasVsync, refreshRate, fpsCap);
+  }
+
+  const bool onDemand = opt.onDemand && Input::Trace::mode() == Input::TraceMode::Live;
+
+  Memory::FrameArena::init();
   Editor editor;
+  if (opt.undoMb >= 0) editor.setUndoMemoryCap(static_cast<std::size_t>(opt.undoMb) * 1024 * 1024);
+  // En optaget session afspilles uden journal, så den må heller ikke have en når den optages
+  if (Input::Trace::mode() == Input::TraceMode::Live) editor.enableJournal();
   FPS_Counter fpsCounter;
 
-  // Tid målt i millisekunder
-  uint64_t lastTime = SDL_GetTicks();
-  double deltaTime = 0.0;
-  float fps = 0.0f;
+  std::vector<double> replayFrameMs;
+  bool quit = false;
+
+  while (sdl.isRunning() && !quit) {
+    Profiling::Profiler::beginFrame();
+    Render::BeginFrame();
+    Memory::FrameArena::reset();
+    const Uint64 frameStart = SDL_GetPerformanceCounter();
+
+    // --- deltaTime fra nanosekund-tælleren (ved afspilning overskrevet med den optagede) ---
+    sdl.getState().deltaTime = static_cast<float>(Timing::FrameScheduler::beginFrame());
 
-  while (sdl.isRunning()) {
-    // --- Opdater deltaTime ---
-    uint64_t now = SDL_GetTicks();
-    deltaTime = (now - lastTime) / 1000.0; // sekunder
-    sdl.getState().tickDeltaTime(now, lastTime);
-    lastTime = now;
+    // Input (og ved afspilning deltaTime) for denne frame
+    if (!Input::Trace::beginFrame(sdl.getState())) break;
 
     // --- Event håndtering ---
     SDL_Event event;
-    while (SDL_PollEvent(&event)) {
-      if (event.type == SDL_EVENT_QUIT)
-        return 0;
+    while (Input::Trace::pollEvent(event)) {
+      if (event.type == SDL_EVENT_QUIT) {
+        quit = true;
+        break;
+      }
+      if (event.type == SDL_EVENT_KEY_DOWN && event.key.key == SDLK_F9 && !event.key.repeat)
+        Log::Trace::Toggle();
       if (event.type == SDL_EVENT_WINDOW_RESIZED) {
         sdl.getState().windowWidth = event.window.data1;
         sdl.getState().windowHeight = event.window.data2;
       }
 
       // Håndterer input i editor
+      fpsCounter.handleEvent(event);
       editor.handleInput(event, sdl.getState());
     }
+    if (quit) break;
+
+    // --- Simulation i faste skridt (efter en idle ventetid skal skyernes timer indhente hele pausen) ---
+    auto& stepper = Timing::FrameScheduler::stepper();
+    stepper.advance(sdl.getState().deltaTime, [&](float dt) { editor.fixedUpdate(sdl.getState(), dt); },
+                    Timing::FrameScheduler::resumedFromIdle() ? Timing::FixedStepper::MAX_IDLE_STEPS
+                                                              : Timing::FixedStepper::MAX_STEPS);
+    sdl.getState().stepAlpha = stepper.alpha();
 
     // --- Rendering ---
     sdl.clear();
 
     editor.run(sdl.getState());
 
-    // FPS beregnet ud fra deltaTime
-    if (deltaTime > 0.0)
-      fps = 1.0f / static_cast<float>(deltaTime);
+    // Arbejde der skal bruge rendereren (thumbnails) - højst et budget per frame, så der ikke kommer hak
+    Jobs::MainThreadScheduler::run();
 
     fpsCounter.update(sdl.getState());
 
-    sdl.present();
+    {
+      PROFILE_SCOPE("present");
+      sdl.present();
+    }
+
+    Profiling::Profiler::endFrame();
+    Log::Trace::FrameBoundary();
+
+    if (replaying)
+      replayFrameMs.push_back(Profiling::Profiler::ticksToMs(SDL_GetPerformanceCounter() - frameStart));
+
+    // Ventetid til næste frame (frame cap) ligger uden for profileren
+    Timing::FrameScheduler::endFrame();
+
+    // On-demand: er der intet der ændrer sig, ventes der på input (eller til skyer/popup skal videre).
+    // Kun live - optagelser og afspilning skal have en frame for hver deltaTime
+    Redraw::Request redraw = editor.redrawRequest(sdl.getState());
+    if (fpsCounter.overlayVisible()) redraw.now |= Redraw::OVERLAY;
+    fpsCounter.setRedraw(redraw, onDemand);
+    if (onDemand && redraw.now == 0 && !Jobs::MainThreadScheduler::hasWork()) Timing::FrameScheduler::waitIdle(redraw.waitMs);
 
     #if defined(_WIN32) || defined(__linux__)
       //sdl.getAudioHandler().playTrack();
     #endif
   }
 
+  Input::Trace::stop();
+  Jobs::Shutdown();
+  Log::Trace::Stop();
+  Log::Shutdown();
+
+  if (replaying) {
+    const std::string name = "replay/" + std::filesystem::path(opt.replay).stem().string();
+    if (!Input::Trace::writeReport(opt.report, name, std::move(replayFrameMs))) return 1;
+  }
   return 0;
 }
@@ -0,0 +1,341 @@
+#include "InputTrace.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <numeric>
+
+#include "SDL_Handler.hpp"
+#include "logging/Logger.hpp"
+
+namespace Input {
+
+namespace {
+  constexpr char MAGIC[4] = { 'P', 'I', 'T', 'R' };
+  constexpr std::uint32_t VERSION = 1;
+  constexpr std::uint8_t FRAME_MARKER = 'F';
+
+  TraceMode s_mode = TraceMode::Live;
+  TraceInfo s_info;
+  std::FILE* s_file = nullptr;
+
+  // Optagelse: events samles per frame og skrives når næste frame starter
+  std::vector<std::uint8_t> s_events;
+  std::uint16_t s_eventCount = 0;
+  bool s_frameOpen = false;
+
+  // Afspilning: events for den aktuelle frame. Tekst ligger i en deque, så text.text pegerne holder
+  std::vector<SDL_Event> s_replayEvents;
+  std::deque<std::string> s_replayText;
+  size_t s_replayNext = 0;
+  std::array<bool, SDL_SCANCODE_COUNT> s_replayKeys {};
+
+  template<typename T>
+  void put(std::vector<std::uint8_t>& out, const T& value) {
+    const auto* bytes = reinterpret_cast<const std::uint8_t*>(&value);
+    out.insert(out.end(), bytes, bytes + sizeof(T));
+  }
+
+  template<typename T>
+  bool get(T& value) {
+    return std::fread(&value, sizeof(T), 1, s_file) == 1;
+  }
+
+  /* Kun de events editoren bruger gemmes - resten (og pegere) giver ingen mening at afspille */
+  bool encodeEvent(const SDL_Event& e, std::vector<std::uint8_t>& out) {
+    switch (e.type) {
+      case SDL_EVENT_QUIT:
+        put(out, e.type);
+        return true;
+      case SDL_EVENT_KEY_DOWN:
+      case SDL_EVENT_KEY_UP:
+        put(out, e.type);
+        put(out, static_cast<std::uint32_t>(e.key.key));
+        put(out, static_cast<std::uint16_t>(e.key.scancode));
+        put(out, static_cast<std::uint16_t>(e.key.mod));
+        put(out, static_cast<std::uint8_t>(e.key.down));
+        put(out, static_cast<std::uint8_t>(e.key.repeat));
+        return true;
+      case SDL_EVENT_TEXT_INPUT: {
+        const size_t len = std::min<size_t>(e.text.text ? std::strlen(e.text.text) : 0, 255);
+        put(out, e.type);
+        put(out, static_cast<std::uint8_t>(len));
+        out.insert(out.end(), e.text.text, e.text.text + len);
+        return true;
+      }
+      case SDL_EVENT_MOUSE_MOTION:
+        put(out, e.type);
+        put(out, e.motion.x);
+        put(out, e.motion.y);
+        put(out, static_cast<std::uint32_t>(e.motion.state));
+        return true;
+      case SDL_EVENT_MOUSE_BUTTON_DOWN:
+      case SDL_EVENT_MOUSE_BUTTON_UP:
+        put(out, e.type);
+        put(out, e.button.button);
+        put(out, e.button.clicks);
+        put(out, e.button.x);
+        put(out, e.button.y);
+        return true;
+      case SDL_EVENT_MOUSE_WHEEL:
+        put(out, e.type);
+        put(out, e.wheel.x);
+        put(out, e.wheel.y);
+        put(out, e.wheel.mouse_x);
+        put(out, e.wheel.mouse_y);
+        return true;
+      case SDL_EVENT_WINDOW_RESIZED:
+        put(out, e.type);
+        put(out, e.window.data1);
+        put(out, e.window.data2);
+        return true;
+      default:
+        return false;
+    }
+  }
+
+  bool decodeEvent(SDL_Event& e) {
+    std::memset(&e, 0, sizeof(e));
+    if (!get(e.type)) return false;
+
+    switch (e.type) {
+      case SDL_EVENT_QUIT:
+        return true;
+      case SDL_EVENT_KEY_DOWN:
+      case SDL_EVENT_KEY_UP: {
+        std::uint32_t key; std::uint16_t scancode, mod; std::uint8_t down, repeat;
+        if (!get(key) || !get(scancode) || !get(mod) || !get(down) || !get(repeat)) return false;
+        e.key.key = key;
+        e.key.scancode = static_cast<SDL_Scancode>(scancode);
+        e.key.mod = mod;
+        e.key.down = down != 0;
+        e.key.repeat = repeat != 0;
+        return true;
+      }
+      case SDL_EVENT_TEXT_INPUT: {
+        std::uint8_t len;
+        if (!get(len)) return false;
+        std::string& text = s_replayText.emplace_back(len, '\0');
+        if (len > 0 && std::fread(text.data(), 1, len, s_file) != len) return false;
+        e.text.text = text.c_str();
+        return true;
+      }
+      case SDL_EVENT_MOUSE_MOTION: {
+        std::uint32_t buttons;
+        if (!get(e.motion.x) || !get(e.motion.y) || !get(buttons)) return false;
+        e.motion.state = buttons;
+        return true;
+      }
+      case SDL_EVENT_MOUSE_BUTTON_DOWN:
+      case SDL_EVENT_MOUSE_BUTTON_UP:
+        e.button.down = e.type == SDL_EVENT_MOUSE_BUTTON_DOWN;
+        return get(e.button.button) && get(e.button.clicks) && get(e.button.x) && get(e.button.y);
+      case SDL_EVENT_MOUSE_WHEEL:
+        return get(e.wheel.x) && get(e.wheel.y) && get(e.wheel.mouse_x) && get(e.wheel.mouse_y);
+      case SDL_EVENT_WINDOW_RESIZED:
+        return get(e.window.data1) && get(e.window.data2);
+      default:
+        Log::Error(Log::Category::Input, "Ukendt event type {} i input trace", e.type);
+        return false;
+    }
+  }
+
+  void flushFrame() {
+    if (!s_frameOpen) return;
+    std::fwrite(&s_eventCount, sizeof(s_eventCount), 1, s_file);
+    if (!s_events.empty()) std::fwrite(s_events.data(), 1, s_events.size(), s_file);
+    s_events.clear();
+    s_eventCount = 0;
+    s_frameOpen = false;
+  }
+
+  /* Live input ind i state - samme sted i frame'en ved optagelse og afspilning */
+  void snapshotLive(SDL_State& state) {
+    SDL_PumpEvents();
+    state.keyState = SDL_GetKeyboardState(nullptr);
+    state.mouseButtons = SDL_GetMouseState(&state.mouseX, &state.mouseY);
+  }
+
+  double percentile(const std::vector<double>& sorted, double p) {
+    if (sorted.empty()) return 0.0;
+    const size_t idx = std::min(sorted.size() - 1, static_cast<size_t>(p * (sorted.size() - 1) + 0.5));
+    return sorted[idx];
+  }
+}
+
+bool Trace::startRecording(const std::string& path, const SDL_State& state, std::uint32_t seed) {
+  stop();
+  s_file = std::fopen(path.c_str(), "wb");
+  if (!s_file) {
+    Log::Error(Log::Category::Input, "Kunne ikke oprette input trace {}", path);
+    return false;
+  }
+
+  s_info = { seed, state.windowWidth, state.windowHeight, 0 };
+  std::fwrite(MAGIC, 1, sizeof(MAGIC), s_file);
+  std::fwrite(&VERSION, sizeof(VERSION), 1, s_file);
+  std::fwrite(&s_info.seed, sizeof(s_info.seed), 1, s_file);
+  std::fwrite(&s_info.windowWidth, sizeof(float), 1, s_file);
+  std::fwrite(&s_info.windowHeight, sizeof(float), 1, s_file);
+
+  s_mode = TraceMode::Record;
+  Log::Info(Log::Category::Input, "Optager input til {} (seed {})", path, seed);
+  return true;
+}
+
+bool Trace::openReplay(const std::string& path) {
+  stop();
+  s_file = std::fopen(path.c_str(), "rb");
+  if (!s_file) {
+    Log::Error(Log::Category::Input, "Kunne ikke åbne input trace {}", path);
+    return false;
+  }
+
+  char magic[4];
+  std::uint32_t version = 0;
+  s_info = {};
+  if (std::fread(magic, 1, sizeof(magic), s_file) != sizeof(magic) || std::memcmp(magic, MAGIC, sizeof(MAGIC)) != 0 ||
+      !get(version) || version != VERSION ||
+      !get(s_info.seed) || !get(s_info.windowWidth) || !get(s_info.windowHeight)) {
+    Log::Error(Log::Category::Input, "{} er ikke en input trace (version {})", path, VERSION);
+    std::fclose(s_file);
+    s_file = nullptr;
+    return false;
+  }
+
+  s_mode = TraceMode::Replay;
+  Log::Info(Log::Category::Input, "Afspiller input fra {} (seed {}, {}x{})", path, s_info.seed, s_info.windowWidth, s_info.windowHeight);
+  return true;
+}
+
+void Trace::stop() {
+  if (s_mode == TraceMode::Record) {
+    flushFrame();
+    Log::Info(Log::Category::Input, "Input trace gemt ({} frames)", s_info.frames);
+  }
+  if (s_file) std::fclose(s_file);
+  s_file = nullptr;
+  s_mode = TraceMode::Live;
+  s_replayEvents.clear();
+  s_replayText.clear();
+  s_replayNext = 0;
+}
+
+TraceMode Trace::mode() {
+  return s_mode;
+}
+
+const TraceInfo& Trace::info() {
+  return s_info;
+}
+
+bool Trace::beginFrame(SDL_State& state) {
+  if (s_mode == TraceMode::Live) {
+    snapshotLive(state);
+    return true;
+  }
+
+  if (s_mode == TraceMode::Record) {
+    flushFrame();
+    snapshotLive(state);
+
+    std::array<std::uint16_t, SDL_SCANCODE_COUNT> pressed;
+    std::uint8_t keyCount = 0;
+    for (int sc = 0; sc < SDL_SCANCODE_COUNT && keyCount < 255; ++sc) {
+      if (state.keyState[sc]) pressed[keyCount++] = static_cast<std::uint16_t>(sc);
+    }
+    const std::uint32_t buttons = state.mouseButtons;
+
+    std::fputc(FRAME_MARKER, s_file);
+    std::fwrite(&state.deltaTime, sizeof(float), 1, s_file);
+    std::fwrite(&keyCount, sizeof(keyCount), 1, s_file);
+    std::fwrite(pressed.data(), sizeof(std::uint16_t), keyCount, s_file);
+    std::fwrite(&state.mouseX, sizeof(float), 1, s_file);
+    std::fwrite(&state.mouseY, sizeof(float), 1, s_file);
+    std::fwrite(&buttons, sizeof(buttons), 1, s_file);
+
+    s_frameOpen = true;
+    ++s_info.frames;
+    return true;
+  }
+
+  // Afspilning - ægte events (fx fra offscreen vinduet) smides væk
+  SDL_Event discard;
+  while (SDL_PollEvent(&discard)) {}
+
+  s_replayEvents.clear();
+  s_replayText.clear();
+  s_replayNext = 0;
+
+  std::uint8_t keyCount = 0;
+  std::uint32_t buttons = 0;
+  std::uint16_t eventCount = 0;
+  if (std::fgetc(s_file) != FRAME_MARKER) return false;
+  if (!get(state.deltaTime) || !get(keyCount)) return false;
+
+  s_replayKeys.fill(false);
+  for (int i = 0; i < keyCount; ++i) {
+    std::uint16_t sc;
+    if (!get(sc)) return false;
+    if (sc < SDL_SCANCODE_COUNT) s_replayKeys[sc] = true;
+  }
+  if (!get(state.mouseX) || !get(state.mouseY) || !get(buttons) || !get(eventCount)) return false;
+
+  state.keyState = s_replayKeys.data();
+  state.mouseButtons = buttons;
+
+  s_replayEvents.resize(eventCount);
+  for (SDL_Event& e : s_replayEvents) {
+    if (!decodeEvent(e)) return false;
+  }
+
+  ++s_info.frames;
+  return true;
+}
+
+bool Trace::pollEvent(SDL_Event& event) {
+  if (s_mode == TraceMode::Replay) {
+    if (s_replayNext >= s_replayEvents.size()) return false;
+    event = s_replayEvents[s_replayNext++];
+    return true;
+  }
+
+  if (!SDL_PollEvent(&event)) return false;
+  if (s_mode == TraceMode::Record && s_eventCount < UINT16_MAX && encodeEvent(event, s_events)) ++s_eventCount;
+  return true;
+}
+
+bool Trace::writeReport(const std::string& path, const std::string& name, std::vector<double> frameMs) {
+  if (frameMs.empty()) {
+    Log::Warn(Log::Category::Input, "Ingen frames at rapportere");
+    return false;
+  }
+
+  const double totalMs = std::accumulate(frameMs.begin(), frameMs.end(), 0.0);
+  std::sort(frameMs.begin(), frameMs.end());
+  const double mean = totalMs / frameMs.size();
+  const double median = percentile(frameMs, 0.5);
+  const double p95 = percentile(frameMs, 0.95);
+  const double p99 = percentile(frameMs, 0.99);
+
+  Log::Info(Log::Category::Input, "Afspilning: {} frames på {:.1f} ms - median {:.3f} ms, p95 {:.3f} ms, p99 {:.3f} ms, max {:.3f} ms",
+            frameMs.size(), totalMs, median, p95, p99, frameMs.back());
+
+  std::FILE* f = path == "-" ? stdout : std::fopen(path.c_str(), "wb");
+  if (!f) {
+    Log::Error(Log::Category::Input, "Kunne ikke skrive frame rapport til {}", path);
+    return false;
+  }
+
+  std::fputs("{\n  \"benchmark\": \"PirateEditor replay\",\n  \"renderer\": \"software\",\n  \"results\": [\n", f);
+  std::fprintf(f, "    {\"name\": \"%s\", \"samples\": %zu, \"min_ms\": %.4f, \"median_ms\": %.4f, \"p95_ms\": %.4f, \"mean_ms\": %.4f, \"p99_ms\": %.4f, \"max_ms\": %.4f}\n",
+               name.c_str(), frameMs.size(), frameMs.front(), median, p95, mean, p99, frameMs.back());
+  std::fputs("  ]\n}\n", f);
+
+  if (f != stdout) std::fclose(f);
+  return true;
+}
+
+}
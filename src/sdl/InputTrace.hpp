@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <SDL3/SDL.h>
+
+struct SDL_State;
+
+/*
+ * Optagelse og afspilning af input, så en brugers session kan køres igen som benchmark.
+ *
+ * Per frame gemmes deltaTime, de nedtrykkede taster, musens position/knapper og de
+ * SDL events editoren reagerer på (binært, little-endian). Frøet til rand() gemmes i
+ * headeren, så skyerne i baggrunden også bliver ens.
+ *
+ *   PirateEditor --record session.pitr
+ *   PirateEditor --replay session.pitr [--report frames.json]
+ *
+ * Afspilning kører headless og så hurtigt som muligt med de optagede deltaTimes.
+ */
+namespace Input {
+
+enum class TraceMode { Live, Record, Replay };
+
+struct TraceInfo {
+  std::uint32_t seed = 0;
+  float windowWidth = 0.0f;
+  float windowHeight = 0.0f;
+  std::uint64_t frames = 0;
+};
+
+class Trace {
+  public:
+    static bool startRecording(const std::string& path, const SDL_State& state, std::uint32_t seed);
+    static bool openReplay(const std::string& path);
+    static void stop();
+
+    static TraceMode mode();
+    static const TraceInfo& info();
+
+    /*
+     * Kaldes i starten af hver frame efter deltaTime er sat. Sætter keyState og musen i state
+     * (og deltaTime ved afspilning). Returnerer false når afspilningen er færdig.
+     */
+    static bool beginFrame(SDL_State& state);
+
+    /* Erstatter SDL_PollEvent i main loopet */
+    static bool pollEvent(SDL_Event& event);
+
+    /*
+     * Skriver frame tider fra en afspilning som JSON i samme format som PirateEditorBench,
+     * så filen kan bruges direkte som --baseline. "-" skriver til stdout.
+     */
+    static bool writeReport(const std::string& path, const std::string& name, std::vector<double> frameMs);
+
+    Trace() = delete;
+};
+
+}
@@ -0,0 +1,38 @@
+#include "Render.hpp"
+
+namespace Render {
+
+namespace detail {
+  State g_state;
+}
+
+const char* SubsystemName(Subsystem s) {
+  switch (s) {
+    case Subsystem::Other:      return "Other";
+    case Subsystem::Background: return "Background";
+    case Subsystem::Tiles:      return "Tiles";
+    case Subsystem::Editor:     return "Editor";
+    case Subsystem::UI:         return "UI";
+    case Subsystem::Text:       return "Text";
+    case Subsystem::Thumbnail:  return "Thumbnail";
+    case Subsystem::Overlay:    return "Overlay";
+    default:                    return "Unknown";
+  }
+}
+
+void BeginFrame() {
+  detail::g_state.last = detail::g_state.current;
+  detail::g_state.current = {};
+  detail::g_state.subsystem = Subsystem::Other;
+  detail::g_state.boundTexture = nullptr;
+}
+
+const FrameStats& LastFrame() {
+  return detail::g_state.last;
+}
+
+const FrameStats& CurrentFrame() {
+  return detail::g_state.current;
+}
+
+}
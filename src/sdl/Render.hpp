@@ -0,0 +1,151 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <SDL3/SDL.h>
+
+#include "SDL3/SDL_render.h"
+
+/*
+ * Tynd facade over de SDL render kald editoren bruger. Alt der tegnes går
+ * igennem her, så vi per frame kan tælle draw calls, texture skift, alpha-mod
+ * ændringer og render-target skift per subsystem - og se om en langsom frame
+ * skyldes CPU'en eller det vi sender til rendereren.
+ */
+namespace Render {
+
+enum class Subsystem : std::uint8_t {
+  Other,
+  Background,
+  Tiles,
+  Editor,
+  UI,
+  Text,
+  Thumbnail,
+  Overlay,
+  Count
+};
+
+const char* SubsystemName(Subsystem s);
+
+struct Counters {
+  std::uint32_t drawCalls = 0;
+  std::uint32_t textureBinds = 0;
+  std::uint32_t alphaModChanges = 0;
+  std::uint32_t targetSwitches = 0;
+
+  Counters& operator+=(const Counters& o) {
+    drawCalls += o.drawCalls;
+    textureBinds += o.textureBinds;
+    alphaModChanges += o.alphaModChanges;
+    targetSwitches += o.targetSwitches;
+    return *this;
+  }
+};
+
+struct FrameStats {
+  std::array<Counters, static_cast<size_t>(Subsystem::Count)> subsystems {};
+
+  const Counters& operator[](Subsystem s) const { return subsystems[static_cast<size_t>(s)]; }
+  Counters total() const {
+    Counters t;
+    for (const auto& c : subsystems) t += c;
+    return t;
+  }
+};
+
+namespace detail {
+  struct State {
+    FrameStats current;
+    FrameStats last;
+    Subsystem subsystem = Subsystem::Other;
+    SDL_Texture* boundTexture = nullptr;
+  };
+  extern State g_state;
+
+  inline Counters& counters() {
+    return g_state.current.subsystems[static_cast<size_t>(g_state.subsystem)];
+  }
+
+  inline void countDraw(SDL_Texture* texture) {
+    Counters& c = counters();
+    c.drawCalls++;
+    if (texture != g_state.boundTexture) {
+      c.textureBinds++;
+      g_state.boundTexture = texture;
+    }
+  }
+}
+
+/* Kaldes i toppen af hver frame - gemmer sidste frames tal og nulstiller */
+void BeginFrame();
+
+/* Tal for den seneste færdige frame (til HUD og tests) */
+const FrameStats& LastFrame();
+const FrameStats& CurrentFrame();
+
+/* Alt der tegnes mens scopet lever tælles under subsystemet */
+class SubsystemScope {
+  public:
+    explicit SubsystemScope(Subsystem s) : previous(detail::g_state.subsystem) { detail::g_state.subsystem = s; }
+    ~SubsystemScope() { detail::g_state.subsystem = previous; }
+
+    SubsystemScope(const SubsystemScope&) = delete;
+    SubsystemScope& operator=(const SubsystemScope&) = delete;
+  private:
+    Subsystem previous;
+};
+
+inline bool Texture(SDL_Renderer* renderer, SDL_Texture* texture, const SDL_FRect* src, const SDL_FRect* dst) {
+  detail::countDraw(texture);
+  return SDL_RenderTexture(renderer, texture, src, dst);
+}
+
+inline bool Geometry(SDL_Renderer* renderer, SDL_Texture* texture, const SDL_Vertex* vertices, int numVertices, const int* indices, int numIndices) {
+  detail::countDraw(texture);
+  return SDL_RenderGeometry(renderer, texture, vertices, numVertices, indices, numIndices);
+}
+
+inline bool Line(SDL_Renderer* renderer, float x1, float y1, float x2, float y2) {
+  detail::countDraw(nullptr);
+  return SDL_RenderLine(renderer, x1, y1, x2, y2);
+}
+
+inline bool Lines(SDL_Renderer* renderer, const SDL_FPoint* points, int count) {
+  detail::countDraw(nullptr);
+  return SDL_RenderLines(renderer, points, count);
+}
+
+inline bool Rect(SDL_Renderer* renderer, const SDL_FRect* rect) {
+  detail::countDraw(nullptr);
+  return SDL_RenderRect(renderer, rect);
+}
+
+inline bool FillRect(SDL_Renderer* renderer, const SDL_FRect* rect) {
+  detail::countDraw(nullptr);
+  return SDL_RenderFillRect(renderer, rect);
+}
+
+inline bool FillRects(SDL_Renderer* renderer, const SDL_FRect* rects, int count) {
+  if (count <= 0) return true;
+  detail::countDraw(nullptr);
+  return SDL_RenderFillRects(renderer, rects, count);
+}
+
+inline bool Clear(SDL_Renderer* renderer) {
+  detail::countDraw(nullptr);
+  return SDL_RenderClear(renderer);
+}
+
+inline bool SetTextureAlphaMod(SDL_Texture* texture, Uint8 alpha) {
+  detail::counters().alphaModChanges++;
+  return SDL_SetTextureAlphaMod(texture, alpha);
+}
+
+inline bool SetTarget(SDL_Renderer* renderer, SDL_Texture* target) {
+  detail::counters().targetSwitches++;
+  detail::g_state.boundTexture = nullptr; // nyt target betyder nyt batch
+  return SDL_SetRenderTarget(renderer, target);
+}
+
+}
@@ -6,26 +6,31 @@ SDL_Handler::SDL_Handler(WindowConfig winConfig) {
   const char* version = "1.0.0";
   SDL_SetAppMetadata(winConfig.title.c_str(), version, winConfig.title.c_str());
 
-  if(!initSDL()) return;
-
-  SDL_DisplayID display = SDL_GetPrimaryDisplay();
-  const SDL_DisplayMode* mode = SDL_GetCurrentDisplayMode(display);
-  const int WINDOW_WIDTH = mode->w;
-  const int WINDOW_HEIGHT = mode->h;
-
+  if(!initSDL(winConfig.headless)) return;
+
+  int WINDOW_WIDTH = winConfig.width;
+  int WINDOW_HEIGHT = winConfig.height;
+  if(!winConfig.headless) {
+    SDL_DisplayID display = SDL_GetPrimaryDisplay();
+    const SDL_DisplayMode* mode = SDL_GetCurrentDisplayMode(display);
+    WINDOW_WIDTH = mode->w;
+    WINDOW_HEIGHT = mode->h;
+  }
 
-  state.window = SDL_CreateWindow(winConfig.title.c_str(), WINDOW_WIDTH, WINDOW_HEIGHT, SDL_WINDOW_RESIZABLE);
+  const SDL_WindowFlags windowFlags = winConfig.headless ? SDL_WINDOW_HIDDEN : SDL_WINDOW_RESIZABLE;
+  state.window = SDL_CreateWindow(winConfig.title.c_str(), WINDOW_WIDTH, WINDOW_HEIGHT, windowFlags);
   if(!state.window) {
     Log::Critical("Kunne ikke oprette vindue");
     return;
   }
 
-  state.renderer = SDL_CreateRenderer(state.window, nullptr);
-  SDL_SetRenderVSync(state.renderer, -1);
+  // Headless bruger altid software rendereren, så målinger er ens på alle maskiner
+  state.renderer = SDL_CreateRenderer(state.window, winConfig.headless ? SDL_SOFTWARE_RENDERER : nullptr);
   if(!state.renderer) {
     Log::Critical("Kunne ikke oprette renderer");
     return;
   }
+  if(!winConfig.headless) SDL_SetRenderVSync(state.renderer, -1);
 
   if(!ResourceManager::init(state.renderer)) {
     Log::Critical("Fejl ved initialiseringen af ResourceManager");
@@ -44,8 +49,11 @@ SDL_Handler::SDL_Handler(WindowConfig winConfig) {
 
   #if defined(_WIN32) || defined(__linux__)
   if(!state.audioHandler.isInitialized()) {
-    Log::Critical("Kunne ikke oprette lyd");
-    return;
+    if(!winConfig.headless) {
+      Log::Critical("Kunne ikke oprette lyd");
+      return;
+    }
+    Log::Warn("Ingen lyd i headless mode");
   }
   #endif
 
@@ -57,20 +65,21 @@ SDL_Handler::SDL_Handler(WindowConfig winConfig) {
   state.running = true;
   state.keyState = SDL_GetKeyboardState(nullptr);
 
-  SDL_SetWindowFullscreen(state.window, SDL_WINDOW_FULLSCREEN);
+  if(!winConfig.headless) SDL_SetWindowFullscreen(state.window, SDL_WINDOW_FULLSCREEN);
 
   Log::Info("SDL_Handler er korrekt initialiseret");
 }
 
-void SDL_State::tickDeltaTime(uint64_t now, uint64_t last) {
-  deltaTime = (float)(now - last) / 1000.0f;
-}
-
 SDL_Handler::~SDL_Handler() {
   cleanup();
 }
 
-bool SDL_Handler::initSDL() {
+bool SDL_Handler::initSDL(bool headless) {
+  if(headless) {
+    SDL_SetHint(SDL_HINT_VIDEO_DRIVER, "offscreen");
+    SDL_SetHint(SDL_HINT_AUDIO_DRIVER, "dummy");
+  }
+
   if(!SDL_Init(SDL_INIT_VIDEO | SDL_INIT_AUDIO)) {
     Log::Critical("SDL_Init fejl");
     return false;
@@ -92,9 +101,10 @@ void SDL_Handler::cleanup() {
   getAudioHandler().destroy();
   #endif
 
+  // Glyph atlasserne ejer textures, så de skal væk før rendereren
+  UI::Text::cleanup();
   if(state.renderer) SDL_DestroyRenderer(state.renderer);
   if(state.window)   SDL_DestroyWindow(state.window);
-  UI::Text::cleanup();
 
   TTF_Quit();
   SDL_Quit();
@@ -106,10 +116,11 @@ bool SDL_Handler::isRunning() const {
 
 void SDL_Handler::clear() {
   SDL_SetRenderDrawColor(state.renderer, 0, 0, 0, 255);
-  SDL_RenderClear(state.renderer);
+  Render::Clear(state.renderer);
 }
 
 void SDL_Handler::present() {
+  UI::Text::flush();
   SDL_RenderPresent(state.renderer);
 }
 
@@ -13,11 +13,16 @@
 #include "SDL3/SDL_render.h"
 #include "SDL3/SDL_video.h"
 #include "ui/TextHandler.hpp"
+#include "Render.hpp"
 
 struct WindowConfig {
   std::string title;
   int width;
   int height;
+
+  // Uden skærm/GPU (CI og benchmarks): offscreen video driver, skjult vindue,
+  // software renderer og lyd er valgfri
+  bool headless = false;
 };
 
 struct SDL_State {
@@ -32,11 +37,16 @@ struct SDL_State {
   float         deltaTime = 0.0f;
   float         windowHeight = 0.0f;
   float         windowWidth = 0.0f;
-  float         cameraX = 0.0f;
-  Vec2<float>   cameraPos = {0.0f, 0.0f};
-  const bool* keyState;
+  Vec2<float>   cameraPos = {0.0f, 0.0f};        // tegnet position - interpoleret mellem de to seneste fixed steps
+  Vec2<float>   cameraStepPos = {0.0f, 0.0f};    // kameraet efter seneste fixed step
+  Vec2<float>   cameraPrevStepPos = {0.0f, 0.0f};
+  float         stepAlpha = 1.0f;                // Timing::FixedStepper::alpha() for denne frame
 
-  void tickDeltaTime(uint64_t now, uint64_t last);
+  // Input for den aktuelle frame - sættes af Input::Trace::beginFrame (live eller afspillet)
+  const bool*   keyState = nullptr;
+  float         mouseX = 0.0f;
+  float         mouseY = 0.0f;
+  SDL_MouseButtonFlags mouseButtons = 0;
 };
 
 class SDL_Handler {
@@ -59,7 +69,7 @@ class SDL_Handler {
     SDL_Handler& operator=(const SDL_Handler&) = delete;
 
   private:
-    bool initSDL();
+    bool initSDL(bool headless);
     void cleanup();
 
     static SDL_State state;
@@ -0,0 +1,203 @@
+#include "GlyphAtlas.hpp"
+#include "SDL3/SDL_surface.h"
+
+namespace UI {
+
+static constexpr int ATLAS_WIDTH   = 512;
+static constexpr int GLYPH_PADDING = 1;
+
+GlyphAtlas::~GlyphAtlas() {
+  destroy();
+}
+
+GlyphAtlas::GlyphAtlas(GlyphAtlas&& other) noexcept
+  : texture(other.texture)
+  , glyphs(other.glyphs)
+  , kerningTable(std::move(other.kerningTable))
+  , height(other.height)
+  , vertices(std::move(other.vertices))
+  , indices(std::move(other.indices))
+{
+  other.texture = nullptr;
+}
+
+GlyphAtlas& GlyphAtlas::operator=(GlyphAtlas&& other) noexcept {
+  if (this != &other) {
+    destroy();
+    texture      = other.texture;
+    glyphs       = other.glyphs;
+    kerningTable = std::move(other.kerningTable);
+    height       = other.height;
+    vertices     = std::move(other.vertices);
+    indices      = std::move(other.indices);
+    other.texture = nullptr;
+  }
+  return *this;
+}
+
+void GlyphAtlas::destroy() {
+  if (texture) SDL_DestroyTexture(texture);
+  texture = nullptr;
+  vertices.clear();
+  indices.clear();
+}
+
+bool GlyphAtlas::build(SDL_Renderer* renderer, TTF_Font* font) {
+  if (!renderer || !font) return false;
+  destroy();
+
+  height = static_cast<float>(TTF_GetFontHeight(font));
+
+  // Rasteriser alle glyphs og find deres plads i atlasset (simple rækker)
+  std::array<SDL_Surface*, GLYPH_COUNT> surfaces {};
+  int penX = GLYPH_PADDING, penY = GLYPH_PADDING, rowH = 0;
+
+  const SDL_Color white { 255, 255, 255, 255 };
+  for (size_t i = 0; i < GLYPH_COUNT; ++i) {
+    const Uint32 cp = static_cast<Uint32>(FIRST_GLYPH + i);
+    Glyph& g = glyphs[i];
+
+    int minx = 0, maxx = 0, miny = 0, maxy = 0, advance = 0;
+    if (!TTF_GetGlyphMetrics(font, cp, &minx, &maxx, &miny, &maxy, &advance)) continue;
+    g.advance = static_cast<float>(advance);
+
+    SDL_Surface* surf = TTF_RenderGlyph_Blended(font, cp, white);
+    if (!surf) continue; // fx mellemrum - kun advance betyder noget
+
+    if (penX + surf->w + GLYPH_PADDING > ATLAS_WIDTH) {
+      penX = GLYPH_PADDING;
+      penY += rowH + GLYPH_PADDING;
+      rowH = 0;
+    }
+
+    g.src = { (float)penX, (float)penY, (float)surf->w, (float)surf->h };
+    penX += surf->w + GLYPH_PADDING;
+    rowH = std::max(rowH, surf->h);
+    surfaces[i] = surf;
+  }
+
+  const int atlasH = penY + rowH + GLYPH_PADDING;
+  SDL_Surface* atlas = SDL_CreateSurface(ATLAS_WIDTH, atlasH, SDL_PIXELFORMAT_RGBA32);
+  if (!atlas) {
+    Log::Error(Log::Category::UI, "Kunne ikke oprette glyph atlas surface ({}x{})", ATLAS_WIDTH, atlasH);
+    for (auto* s : surfaces) if (s) SDL_DestroySurface(s);
+    return false;
+  }
+
+  for (size_t i = 0; i < GLYPH_COUNT; ++i) {
+    SDL_Surface* surf = surfaces[i];
+    if (!surf) continue;
+
+    // Kopier alpha direkte i stedet for at blende ind i den tomme surface
+    SDL_SetSurfaceBlendMode(surf, SDL_BLENDMODE_NONE);
+    SDL_Rect dst { (int)glyphs[i].src.x, (int)glyphs[i].src.y, surf->w, surf->h };
+    SDL_BlitSurface(surf, nullptr, atlas, &dst);
+    SDL_DestroySurface(surf);
+  }
+
+  texture = SDL_CreateTextureFromSurface(renderer, atlas);
+  SDL_DestroySurface(atlas);
+  if (!texture) {
+    Log::Error(Log::Category::UI, "Kunne ikke oprette glyph atlas texture");
+    return false;
+  }
+
+  SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+  SDL_SetTextureScaleMode(texture, SDL_SCALEMODE_NEAREST);
+
+  // Kerning tabel - bygges kun hvis fonten rent faktisk har kerning
+  std::vector<signed char> table(GLYPH_COUNT * GLYPH_COUNT, 0);
+  bool anyKerning = false;
+  for (size_t a = 0; a < GLYPH_COUNT; ++a) {
+    for (size_t b = 0; b < GLYPH_COUNT; ++b) {
+      int k = 0;
+      if (TTF_GetGlyphKerning(font, (Uint32)(FIRST_GLYPH + a), (Uint32)(FIRST_GLYPH + b), &k) && k != 0) {
+        table[a * GLYPH_COUNT + b] = static_cast<signed char>(std::clamp(k, -128, 127));
+        anyKerning = true;
+      }
+    }
+  }
+  if (anyKerning) kerningTable = std::move(table);
+
+  Log::Info(Log::Category::UI, "Glyph atlas bygget ({}x{}, {} glyphs)", ATLAS_WIDTH, atlasH, GLYPH_COUNT);
+  return true;
+}
+
+const Glyph& GlyphAtlas::glyph(char c) const {
+  unsigned char uc = static_cast<unsigned char>(c);
+  if (uc < FIRST_GLYPH || uc > LAST_GLYPH) uc = '?';
+  return glyphs[uc - FIRST_GLYPH];
+}
+
+int GlyphAtlas::kerning(char prev, char c) const {
+  if (kerningTable.empty()) return 0;
+  unsigned char a = static_cast<unsigned char>(prev);
+  unsigned char b = static_cast<unsigned char>(c);
+  if (a < FIRST_GLYPH || a > LAST_GLYPH || b < FIRST_GLYPH || b > LAST_GLYPH) return 0;
+  return kerningTable[(a - FIRST_GLYPH) * GLYPH_COUNT + (b - FIRST_GLYPH)];
+}
+
+float GlyphAtlas::measure(std::string_view text) const {
+  float w = 0.f;
+  char prev = 0;
+  for (char c : text) {
+    w += kerning(prev, c) + glyph(c).advance;
+    prev = c;
+  }
+  return w;
+}
+
+float GlyphAtlas::appendText(std::string_view text, float x, float y, SDL_Color color) {
+  if (!texture) return 0.f;
+
+  float texW = 0.f, texH = 0.f;
+  SDL_GetTextureSize(texture, &texW, &texH);
+
+  const SDL_FColor fc {
+    color.r / 255.f, color.g / 255.f, color.b / 255.f, color.a / 255.f
+  };
+
+  float penX = x;
+  char prev = 0;
+  for (char c : text) {
+    const Glyph& g = glyph(c);
+    penX += kerning(prev, c);
+    prev = c;
+
+    if (g.src.w > 0.f && g.src.h > 0.f) {
+      const float x0 = penX,          y0 = y;
+      const float x1 = penX + g.src.w, y1 = y + g.src.h;
+      const float u0 = g.src.x / texW, v0 = g.src.y / texH;
+      const float u1 = (g.src.x + g.src.w) / texW, v1 = (g.src.y + g.src.h) / texH;
+
+      const int base = static_cast<int>(vertices.size());
+      vertices.push_back({ { x0, y0 }, fc, { u0, v0 } });
+      vertices.push_back({ { x1, y0 }, fc, { u1, v0 } });
+      vertices.push_back({ { x1, y1 }, fc, { u1, v1 } });
+      vertices.push_back({ { x0, y1 }, fc, { u0, v1 } });
+
+      indices.push_back(base + 0);
+      indices.push_back(base + 1);
+      indices.push_back(base + 2);
+      indices.push_back(base + 0);
+      indices.push_back(base + 2);
+      indices.push_back(base + 3);
+    }
+
+    penX += g.advance;
+  }
+
+  return penX - x;
+}
+
+void GlyphAtlas::flush(SDL_Renderer* renderer) {
+  if (indices.empty()) return;
+
+  Render::Geometry(renderer, texture, vertices.data(), (int)vertices.size(), indices.data(), (int)indices.size());
+
+  // clear() beholder kapaciteten til næste frame
+  vertices.clear();
+  indices.clear();
+}
+
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <string_view>
+#include <vector>
+#include <SDL3/SDL.h>
+#include <SDL3_ttf/SDL_ttf.h>
+
+#include "logging/Logger.hpp"
+#include "SDL3/SDL_render.h"
+#include "sdl/Render.hpp"
+
+namespace UI {
+
+/* Et enkelt glyph i atlasset (kildeområde + hvor langt pennen flytter sig) */
+struct Glyph {
+  SDL_FRect src { 0.f, 0.f, 0.f, 0.f };
+  float advance = 0.f;
+};
+
+/*
+ * Alle printbare ASCII glyphs for én font rasteriseres én gang i hvid ind i
+ * én texture. Farve sættes per vertex, så samme atlas kan bruges til al tekst
+ * i den font, og tekst samles til ét SDL_RenderGeometry kald per font.
+ */
+class GlyphAtlas {
+  public:
+    static constexpr char32_t FIRST_GLYPH = 32;  // ' '
+    static constexpr char32_t LAST_GLYPH  = 126; // '~'
+    static constexpr size_t   GLYPH_COUNT = LAST_GLYPH - FIRST_GLYPH + 1;
+
+    GlyphAtlas() = default;
+    ~GlyphAtlas();
+
+    GlyphAtlas(const GlyphAtlas&) = delete;
+    GlyphAtlas& operator=(const GlyphAtlas&) = delete;
+    GlyphAtlas(GlyphAtlas&& other) noexcept;
+    GlyphAtlas& operator=(GlyphAtlas&& other) noexcept;
+
+    bool build(SDL_Renderer* renderer, TTF_Font* font);
+    void destroy();
+
+    /* Tegn-funktioner bygger bare vertices - flush() sender dem til rendereren */
+    float appendText(std::string_view text, float x, float y, SDL_Color color);
+    void flush(SDL_Renderer* renderer);
+
+    /* Bredde af tekst uden farvetags (ingen texture eller TTF_Text oprettes) */
+    float measure(std::string_view text) const;
+    float lineHeight() const { return height; }
+
+    const Glyph& glyph(char c) const;
+    SDL_Texture* getTexture() const { return texture; }
+  private:
+    int kerning(char prev, char c) const;
+
+    SDL_Texture* texture = nullptr;
+    std::array<Glyph, GLYPH_COUNT> glyphs {};
+    std::vector<signed char> kerningTable; // GLYPH_COUNT x GLYPH_COUNT, tom hvis fonten ikke har kerning
+    float height = 0.f;
+
+    // Genbruges frame efter frame, så der ikke allokeres når kapaciteten er nået
+    std::vector<SDL_Vertex> vertices;
+    std::vector<int> indices;
+};
+
+}
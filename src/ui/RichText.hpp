@@ -0,0 +1,194 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <SDL3/SDL.h>
+
+namespace UI {
+
+/*
+ * Farver i markup som "{green}Tekst" er interned til et lille index, så en
+ * færdig-parset tekst kun består af spans (start, længde, farve-index) ind i
+ * én streng uden tags. Default betyder "brug farven displayText blev kaldt med".
+ */
+enum class TextColor : std::uint8_t {
+  Default,
+  White,
+  Red,
+  Green,
+  Blue,
+  Yellow,
+  Cyan,
+  Magenta,
+  Gray,
+  Black
+};
+
+struct NamedColor {
+  std::string_view name;
+  TextColor id;
+  SDL_Color color;
+};
+
+inline constexpr std::array<NamedColor, 9> TEXT_COLORS {{
+  { "white",   TextColor::White,   {200, 200, 200, 255} },
+  { "red",     TextColor::Red,     {180, 0, 0, 255} },
+  { "green",   TextColor::Green,   {0, 150, 0, 255} },
+  { "blue",    TextColor::Blue,    {0, 0, 180, 255} },
+  { "yellow",  TextColor::Yellow,  {180, 180, 0, 255} },
+  { "cyan",    TextColor::Cyan,    {0, 150, 150, 255} },
+  { "magenta", TextColor::Magenta, {150, 0, 150, 255} },
+  { "gray",    TextColor::Gray,    {80, 80, 80, 255} },
+  { "black",   TextColor::Black,   {0, 0, 0, 255} }
+}};
+
+/* Slår et farvenavn op - false hvis navnet ikke er en kendt farve */
+constexpr bool LookupTextColor(std::string_view name, TextColor& out) {
+  for (const auto& c : TEXT_COLORS) {
+    if (c.name == name) { out = c.id; return true; }
+  }
+  return false;
+}
+
+constexpr SDL_Color ResolveTextColor(TextColor id, SDL_Color defaultColor) {
+  for (const auto& c : TEXT_COLORS) {
+    if (c.id == id) return c.color;
+  }
+  return defaultColor;
+}
+
+struct RichSpan {
+  std::uint16_t begin = 0;
+  std::uint16_t length = 0;
+  TextColor color = TextColor::Default;
+};
+
+/* Ikke-ejende view over en kompileret tekst */
+struct RichTextView {
+  std::string_view text;
+  std::span<const RichSpan> spans;
+};
+
+/*
+ * Går markup igennem uden at allokere og kalder fn(segment, farve) for hvert
+ * sammenhængende stykke tekst. Ukendte tags som "{foo}" vises som almindelig tekst.
+ */
+template<typename Fn>
+constexpr void ForEachRichSegment(std::string_view markup, Fn&& fn) {
+  TextColor current = TextColor::Default;
+  size_t segStart = 0;
+  size_t pos = 0;
+
+  while (pos < markup.size()) {
+    if (markup[pos] == '{') {
+      size_t end = markup.find('}', pos);
+      TextColor next;
+      if (end != std::string_view::npos && LookupTextColor(markup.substr(pos + 1, end - pos - 1), next)) {
+        if (pos > segStart) fn(markup.substr(segStart, pos - segStart), current);
+        current = next;
+        pos = end + 1;
+        segStart = pos;
+        continue;
+      }
+    }
+    ++pos;
+  }
+
+  if (segStart < markup.size()) fn(markup.substr(segStart), current);
+}
+
+/* Tekst uden tags (til måling) */
+template<typename Fn>
+constexpr void ForEachPlainSegment(std::string_view markup, Fn&& fn) {
+  ForEachRichSegment(markup, [&](std::string_view seg, TextColor) { fn(seg); });
+}
+
+/*
+ * Kompileret tekst til strenge der først kendes ved runtime (fx scene navne).
+ * Bygges én gang og kan derefter tegnes hver frame uden at parse eller allokere.
+ */
+class RichText {
+  public:
+    RichText() = default;
+    explicit RichText(std::string_view markup) { compile(markup); }
+
+    void compile(std::string_view markup) {
+      text.clear();
+      spans.clear();
+      ForEachRichSegment(markup, [&](std::string_view seg, TextColor color) {
+        spans.push_back({ static_cast<std::uint16_t>(text.size()), static_cast<std::uint16_t>(seg.size()), color });
+        text += seg;
+      });
+    }
+
+    RichTextView view() const { return { text, spans }; }
+    operator RichTextView() const { return view(); }
+    bool empty() const { return text.empty(); }
+  private:
+    std::string text;
+    std::vector<RichSpan> spans;
+};
+
+/* Compile-time kompileret tekst - resultat af "..."_rich */
+template<size_t TextN, size_t SpanN>
+struct StaticRichText {
+  std::array<char, TextN> text {};
+  std::array<RichSpan, SpanN> spans {};
+  size_t textLength = 0;
+  size_t spanCount = 0;
+
+  constexpr RichTextView view() const {
+    return { std::string_view(text.data(), textLength), std::span<const RichSpan>(spans.data(), spanCount) };
+  }
+  constexpr operator RichTextView() const { return view(); }
+};
+
+template<size_t N>
+struct FixedString {
+  char data[N] {};
+  constexpr FixedString(const char (&s)[N]) {
+    for (size_t i = 0; i < N; ++i) data[i] = s[i];
+  }
+  constexpr std::string_view view() const { return { data, N - 1 }; }
+};
+
+struct RichTextCounts {
+  size_t text = 0;
+  size_t spans = 0;
+};
+
+constexpr RichTextCounts CountRichText(std::string_view markup) {
+  RichTextCounts c;
+  ForEachRichSegment(markup, [&](std::string_view seg, TextColor) {
+    c.text += seg.size();
+    c.spans++;
+  });
+  return c;
+}
+
+template<FixedString S>
+consteval auto CompileRichText() {
+  constexpr RichTextCounts counts = CountRichText(S.view());
+  StaticRichText<counts.text + 1, counts.spans + 1> out;
+
+  ForEachRichSegment(S.view(), [&](std::string_view seg, TextColor color) {
+    out.spans[out.spanCount++] = { static_cast<std::uint16_t>(out.textLength), static_cast<std::uint16_t>(seg.size()), color };
+    for (char c : seg) out.text[out.textLength++] = c;
+  });
+
+  return out;
+}
+
+namespace literals {
+  /* "{green}Save Scene"_rich - tags fjernes og farver slås op ved compile-time */
+  template<FixedString S>
+  consteval auto operator""_rich() {
+    return CompileRichText<S>();
+  }
+}
+
+}
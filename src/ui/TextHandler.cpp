@@ -5,49 +5,12 @@ namespace UI {
 
   SDL_Renderer* Text::s_renderer = nullptr;
   std::unordered_map<Text::FontType, TTF_Font*> Text::s_fonts;
-  std::unordered_map<TextKey, CachedText, TextKeyHash> Text::s_cache;
-  std::unordered_map<std::string, SDL_Color> Text::s_colorMap = {
-      {"white",   {200, 200, 200, 255}},
-      {"red",     {180, 0, 0, 255}},
-      {"green",   {0, 150, 0, 255}},
-      {"blue",    {0, 0, 180, 255}},
-      {"yellow",  {180, 180, 0, 255}},
-      {"cyan",    {0, 150, 150, 255}},
-      {"magenta", {150, 0, 150, 255}},
-      {"gray",    {80, 80, 80, 255}},
-      {"black",   {0, 0, 0, 255}}
-  };
-
-
-  std::vector<ColoredSegment> Text::parseColoredText(const std::string& input, SDL_Color defaultColor) {
-    std::vector<ColoredSegment> segments;
-    SDL_Color currentColor = defaultColor;
-
-    size_t pos = 0;
-    while (pos < input.size()) {
-      if (input[pos] == '{') {
-        size_t end = input.find('}', pos);
-        if (end != std::string::npos) {
-          std::string colorName = input.substr(pos + 1, end - pos - 1);
-          auto it = Text::s_colorMap.find(colorName);
-          if (it != Text::s_colorMap.end()) {
-            // Skift farve
-            currentColor = it->second;
-            pos = end + 1;
-            continue;
-          }
-        }
-      }
-
-      // Find næste farvetag eller slutning
-      size_t next = input.find('{', pos);
-      std::string segmentText = input.substr(pos, next - pos);
-      segments.push_back({segmentText, currentColor});
-      if (next == std::string::npos) break;
-      pos = next;
-    }
+  std::unordered_map<Text::FontType, GlyphAtlas> Text::s_atlases;
 
-    return segments;
+  GlyphAtlas* Text::getAtlas(FontType type) {
+    if (!s_renderer) return nullptr;
+    auto it = s_atlases.find(type);
+    return it != s_atlases.end() ? &it->second : nullptr;
   }
 
   bool Text::init(SDL_Renderer* renderer, const std::string& fontPath, const std::unordered_map<FontType, int>& fontSizes) {
@@ -57,19 +20,23 @@ namespace UI {
     for(auto& [type, size] : fontSizes) {
       TTF_Font* font = TTF_OpenFont(fontPath.c_str(), size);
       if(!font) {
-        Log::Error("Kunne ikke åbne font {} med størrelse {}", fontPath, size);
+        Log::Error(Log::Category::UI, "Kunne ikke åbne font {} med størrelse {}", fontPath, size);
         return false;
       }
       s_fonts[type] = font;
+
+      // Alle glyphs rasteriseres én gang per font - ny tekst koster ingen textures
+      if(!s_atlases[type].build(renderer, font)) {
+        Log::Error(Log::Category::UI, "Kunne ikke bygge glyph atlas for font {} med størrelse {}", fontPath, size);
+        return false;
+      }
     }
 
     return true;
   }
 
   void Text::cleanup() {
-    for (auto& pair : s_cache)
-      SDL_DestroyTexture(pair.second.texture);
-    s_cache.clear();
+    s_atlases.clear();
 
     for (auto& [type, font] : s_fonts)
       TTF_CloseFont(font);
@@ -79,66 +46,79 @@ namespace UI {
   }
 
 
-  void Text::displayText(const std::string& text, Vec2<float> position, FontType type, SDL_Color color) {
-    if (!s_renderer || s_fonts.empty()) return;
-
-    TTF_Font* font = s_fonts[type];
-    if (!font) return;
+  void Text::displayText(std::string_view text, Vec2<float> position, FontType type, SDL_Color color) {
+    GlyphAtlas* atlas = getAtlas(type);
+    if (!atlas) return;
 
-    auto segments = parseColoredText(text, color);
+    // Markup parses direkte fra strengen - ingen segment vector eller substr kopier
     float xOffset = 0.0f;
+    ForEachRichSegment(text, [&](std::string_view seg, TextColor c) {
+      xOffset += atlas->appendText(seg, position.x + xOffset, position.y, ResolveTextColor(c, color));
+    });
+  }
 
-    for (const auto& seg : segments) {
-        if (seg.text.empty()) continue;
+  void Text::displayText(const RichTextView& text, Vec2<float> position, FontType type, SDL_Color color) {
+    GlyphAtlas* atlas = getAtlas(type);
+    if (!atlas) return;
+
+    float xOffset = 0.0f;
+    for (const RichSpan& span : text.spans) {
+      std::string_view seg = text.text.substr(span.begin, span.length);
+      xOffset += atlas->appendText(seg, position.x + xOffset, position.y, ResolveTextColor(span.color, color));
+    }
+  }
 
-        TextKey key{ seg.text, seg.color };
-        SDL_Texture* texture = nullptr;
-        auto now = Clock::now();
+  Vec2<float> Text::measureText(std::string_view text, FontType type) {
+    GlyphAtlas* atlas = getAtlas(type);
+    if (!atlas) return {0.f, 0.f};
 
-        auto it = s_cache.find(key);
-        if (it != s_cache.end()) {
-            texture = it->second.texture;
-            it->second.lastUsed = now;
-        } else {
-            SDL_Surface* surface = TTF_RenderText_Blended(font, seg.text.c_str(), seg.text.length(), seg.color);
-            if (!surface) continue;
+    float w = 0.f;
+    ForEachPlainSegment(text, [&](std::string_view seg) { w += atlas->measure(seg); });
+    return {w, atlas->lineHeight()};
+  }
 
-            texture = SDL_CreateTextureFromSurface(s_renderer, surface);
-            SDL_DestroySurface(surface);
-            if (!texture) continue;
+  Vec2<float> Text::measureText(const RichTextView& text, FontType type) {
+    GlyphAtlas* atlas = getAtlas(type);
+    if (!atlas) return {0.f, 0.f};
 
-            s_cache[key] = { texture, now };
-        }
+    // Per span ligesom displayText, så kerning over farveskift måles ens
+    float w = 0.f;
+    for (const RichSpan& span : text.spans) w += atlas->measure(text.text.substr(span.begin, span.length));
+    return {w, atlas->lineHeight()};
+  }
 
-        float w, h;
-        SDL_GetTextureSize(texture, &w, &h);
-        SDL_FRect destRect = { position.x + xOffset, position.y, w, h };
-        SDL_RenderTexture(s_renderer, texture, nullptr, &destRect);
+  bool MeasureCache::matches(std::string_view text, Text::FontType type) const {
+    return valid_ && type_ == type && text_ == text;
+  }
 
-        xOffset += w;
-    }
+  void MeasureCache::store(std::string_view text, Text::FontType type, Vec2<float> size) {
+    text_.assign(text);   // genbruger kapaciteten, så skrivning i et input felt sjældent allokerer
+    type_ = type;
+    size_ = size;
+    valid_ = true;
+  }
 
-    if (s_cache.size() > 30) trimUnusedCache(10.0);
+  Vec2<float> MeasureCache::get(std::string_view text, Text::FontType type) {
+    if (!matches(text, type)) store(text, type, Text::measureText(text, type));
+    return size_;
   }
 
+  Vec2<float> MeasureCache::get(const RichTextView& text, Text::FontType type) {
+    // Spans er afledt af teksten, så den rå tekst er nok som nøgle
+    if (!matches(text.text, type)) store(text.text, type, Text::measureText(text, type));
+    return size_;
+  }
 
-  void Text::trimUnusedCache(double maxAgeSeconds) {
-    auto now = Clock::now();
-    size_t removed = 0;
+  void Text::flush() {
+    if (!s_renderer) return;
 
-    for(auto it = s_cache.begin(); it != s_cache.end();) {
-      double age = std::chrono::duration<double>(now - it->second.lastUsed).count();
-      if(age > maxAgeSeconds) {
-        SDL_DestroyTexture(it->second.texture);
-        it = s_cache.erase(it);
-        ++removed;
-      } else {
-        ++it;
-      }
-    }
+    Render::SubsystemScope renderScope(Render::Subsystem::Text);
 
-    if(removed > 0) {
-      Log::Info("Ryddede cache op: {} gamle textures fjernet", removed);
+    // Fast rækkefølge, så overlappende tekst i forskellige fonts altid tegnes ens
+    static constexpr FontType order[] = { FontType::Small, FontType::Medium, FontType::Large, FontType::Title };
+    for (FontType type : order) {
+      auto it = s_atlases.find(type);
+      if (it != s_atlases.end()) it->second.flush(s_renderer);
     }
   }
 
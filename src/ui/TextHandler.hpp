@@ -4,47 +4,22 @@
 #include <SDL3/SDL.h>
 #include <SDL3_ttf/SDL_ttf.h>
 #include <unordered_map>
-#include <chrono>
 
 #include "logging/Logger.hpp"
 #include "math/vec.hpp"
+#include "GlyphAtlas.hpp"
+#include "RichText.hpp"
 #include "SDL3/SDL_oldnames.h"
 #include "SDL3/SDL_render.h"
 
 namespace UI {
 
-using Clock = std::chrono::steady_clock;
-
-struct ColoredSegment {
-    std::string text;
-    SDL_Color color;
-};
-
-struct CachedText {
-  SDL_Texture* texture;
-  Clock::time_point lastUsed;
-};
-
-struct TextKey {
-  std::string text;
-  SDL_Color color;
-
-  bool operator==(const TextKey& other) const {
-      return text == other.text &&
-        color.r == other.color.r &&
-        color.g == other.color.g &&
-        color.b == other.color.b &&
-        color.a == other.color.a;
-    };
-};
-
-struct TextKeyHash {
-  std::size_t operator()(const TextKey& k) const {
-    std::size_t h1 = std::hash<std::string>()(k.text);
-    std::size_t h2 = (k.color.r << 24) | (k.color.g << 16) | (k.color.b << 8) | k.color.a;
-    return h1 ^ (h2 * 0x9e3779b9);
-  }
-};
+/* Formaterer ind i en fast buffer på stakken (afkortes hvis den er for lille) - allokerer ikke */
+template<size_t N, typename... Args>
+std::string_view FormatTo(char (&buffer)[N], std::format_string<Args...> fmt, Args&&... args) {
+  auto res = std::format_to_n(buffer, N, fmt, std::forward<Args>(args)...);
+  return std::string_view(buffer, res.out - buffer);
+}
 
 class Text {
   public:
@@ -58,19 +33,41 @@ class Text {
     static bool init(SDL_Renderer* renderer, const std::string& fontPath, const std::unordered_map<FontType, int>& fontSizes);
     static void cleanup();
 
-    static void displayText(const std::string& text, Vec2<float> position, FontType type = FontType::Medium, SDL_Color color = {255,255,255,255});
-    static void trimUnusedCache(double maxAgeSeconds = 5.0);
+    /* Lægger teksten i fontens batch - den tegnes først ved flush() */
+    static void displayText(std::string_view text, Vec2<float> position, FontType type = FontType::Medium, SDL_Color color = {255,255,255,255});
+    static void displayText(const RichTextView& text, Vec2<float> position, FontType type = FontType::Medium, SDL_Color color = {255,255,255,255});
+
+    /* Størrelse af tekst uden farvetags - beregnes ud fra atlassets glyph metrics */
+    static Vec2<float> measureText(std::string_view text, FontType type = FontType::Medium);
+    static Vec2<float> measureText(const RichTextView& text, FontType type = FontType::Medium);
+
+    /* Sender én SDL_RenderGeometry per font. Kald før noget skal tegnes ovenpå teksten */
+    static void flush();
     static TTF_Font* getFont(FontType type) { return s_fonts[type]; }
   private:
     Text() = default;
 
-    static std::vector<ColoredSegment> parseColoredText(const std::string& input, SDL_Color defaultColor = {128, 128, 128, 255});
+    static GlyphAtlas* getAtlas(FontType type);
 
     static SDL_Renderer* s_renderer;
     static std::unordered_map<FontType, TTF_Font*> s_fonts;
 
-    static std::unordered_map<TextKey, CachedText, TextKeyHash> s_cache;
-    static std::unordered_map<std::string, SDL_Color> s_colorMap;
+    static std::unordered_map<FontType, GlyphAtlas> s_atlases;
+};
+
+/* Husker størrelsen af den sidst målte tekst - måler kun igen når teksten eller fonten skifter */
+class MeasureCache {
+  public:
+    Vec2<float> get(std::string_view text, Text::FontType type = Text::FontType::Medium);
+    Vec2<float> get(const RichTextView& text, Text::FontType type = Text::FontType::Medium);
+  private:
+    bool matches(std::string_view text, Text::FontType type) const;
+    void store(std::string_view text, Text::FontType type, Vec2<float> size);
+
+    std::string text_;
+    Text::FontType type_ = Text::FontType::Medium;
+    Vec2<float> size_;
+    bool valid_ = false;
 };
 
 };
@@ -2,9 +2,10 @@
 
 namespace Utils {
   std::vector<std::vector<int>> LoadCSVFile(const std::string& path) {
+    TRACE_SCOPE_DETAIL("LoadCSVFile", "io", path);
     std::ifstream file(path);
     if(!file.is_open()) {
-      Log::Error("Kunne ikke åbne filen: {}", path);
+      Log::Error(Log::Category::Scene, "Kunne ikke åbne filen: {}", path);
       return {};
     }
 
@@ -25,7 +26,7 @@ namespace Utils {
 
     file.close();
 
-    Log::Info("Indlæste indhold fra csv fil: {}", path);
+    Log::Debug(Log::Category::Scene, "Indlæste indhold fra csv fil: {}", path);
     return map;
   }
 
@@ -40,7 +41,7 @@ namespace Utils {
 
   std::vector<std::filesystem::path> getAnimationFiles(const std::filesystem::path &folderPath) {
     if(!std::filesystem::is_directory(folderPath)) {
-      Log::Error("Kunne ikke finde en mappe på filstien: {}", folderPath.string());
+      Log::Error(Log::Category::Resources, "Kunne ikke finde en mappe på filstien: {}", folderPath.string());
       return {};
     }
   
@@ -8,6 +8,7 @@
 #include <algorithm>
 
 #include "logging/Logger.hpp"
+#include "logging/Trace.hpp"
 
 namespace Utils {
   using TileLayer = std::vector<std::vector<int>>;
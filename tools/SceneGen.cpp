@@ -0,0 +1,89 @@
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+#include "logging/Logger.hpp"
+#include "scene/SceneGenerator.hpp"
+
+/*
+ * PirateSceneGen - skriver en syntetisk scene i det normale ni-CSV format.
+ *
+ *   PirateSceneGen --name Stress_10k --width 10000 [--height 11] [--seed 1] [--root scenes]
+ *                  [--density 0.35] [--platforms 6] [--columns 3] [--coins 0.1] [--enemies 0.04]
+ *                  [--crates 0.03] [--grass 0.35] [--palms 0.04] [--bg-palms 0.06]
+ */
+
+namespace {
+
+void PrintUsage() {
+  std::fputs(
+    "Brug: PirateSceneGen --name <navn> [options]\n"
+    "  --width <n>        kolonner (standard 60)\n"
+    "  --height <n>       rækker (standard 11)\n"
+    "  --seed <n>         frø - samme frø giver samme scene (standard 1)\n"
+    "  --root <mappe>     hvor scenen skrives (standard scenes)\n"
+    "  --density <x>      terræn tæthed 0-1 (standard 0.35)\n"
+    "  --noise <x>        noise skala, mindre = blødere bakker (standard 0.04)\n"
+    "  --platforms <x>    platforme per 100 kolonner (standard 6)\n"
+    "  --columns <x>      søjler per 100 kolonner (standard 3)\n"
+    "  --coins <x>  --enemies <x>  --crates <x>  --grass <x>  --palms <x>  --bg-palms <x>\n"
+    "                     sandsynlighed per overflade-celle\n", stderr);
+}
+
+}
+
+int main(int argc, char** argv) {
+  Scene::GeneratorConfig config;
+  std::string name;
+  std::string root = "scenes";
+
+  for (int i = 1; i < argc; ++i) {
+    const std::string arg = argv[i];
+    if (arg == "--help" || arg == "-h" || i + 1 >= argc) {
+      PrintUsage();
+      return arg == "--help" || arg == "-h" ? 0 : 2;
+    }
+    const char* value = argv[++i];
+    const float f = static_cast<float>(std::atof(value));
+
+    if      (arg == "--name")      name = value;
+    else if (arg == "--root")      root = value;
+    else if (arg == "--width")     config.width = std::atoi(value);
+    else if (arg == "--height")    config.height = std::atoi(value);
+    else if (arg == "--seed")      config.seed = std::strtoull(value, nullptr, 10);
+    else if (arg == "--density")   config.terrainDensity = f;
+    else if (arg == "--noise")     config.noiseScale = f;
+    else if (arg == "--platforms") config.platformsPer100 = f;
+    else if (arg == "--columns")   config.columnsPer100 = f;
+    else if (arg == "--coins")     config.coinDensity = f;
+    else if (arg == "--enemies")   config.enemyDensity = f;
+    else if (arg == "--crates")    config.crateDensity = f;
+    else if (arg == "--grass")     config.grassDensity = f;
+    else if (arg == "--palms")     config.fgPalmDensity = f;
+    else if (arg == "--bg-palms")  config.bgPalmDensity = f;
+    else {
+      std::fprintf(stderr, "Ukendt argument: %s\n", arg.c_str());
+      PrintUsage();
+      return 2;
+    }
+  }
+
+  if (name.empty()) {
+    PrintUsage();
+    return 2;
+  }
+
+  Log::Init();
+  SDL_SetLogPriorities(SDL_LOG_PRIORITY_WARN);
+
+  const Scene::Layout layout = Scene::GenerateLayout(config);
+  if (!Scene::WriteLayout(layout, name, root)) {
+    std::fprintf(stderr, "Kunne ikke skrive scenen %s\n", name.c_str());
+    return 1;
+  }
+
+  std::fprintf(stderr, "Skrev %s/%s (%d x %d, seed %llu)\n", root.c_str(), name.c_str(),
+               static_cast<int>(layout.terrainLayout.front().size()), static_cast<int>(layout.terrainLayout.size()),
+               static_cast<unsigned long long>(config.seed));
+  return 0;
+}